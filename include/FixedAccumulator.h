@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a wide accumulator for summing the full-precision
+//   products of fixed-point values.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDACCUMULATOR_H
+#define FIXEDACCUMULATOR_H
+
+#include "FixedPoint.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point Accumulator Template Class
+***************************************************************************************************
+
+Filters and controllers typically sum a number of products, and writing this as
+
+    acc16 += (a16 * b16).roundedTo< 16 >();
+
+rounds (and can overflow) on every term. The tFixedAccumulator class instead holds the sum of the
+full-precision products in a wide data-type (64-bit by default), and only rounds once when the
+result is read out,
+
+    tFixedAccumulator< 31 > acc;           // for products of Q15 and Q16 values
+    for (int i = 0; i < cTaps; ++i)
+        acc.mac( cCoeffs15[i], samples16[i] );
+    tQ16 y16 = acc.roundedTo< 16 >();
+
+For 32-bit operands each "mac" is a single 32x32->64 bit multiply-accumulate (SMLAL on ARM).
+
+The products added must have no more qbits than the accumulator (QBits >= QBits1+QBits2), products
+with fewer qbits are shifted up at compile-time. Overflow isn't checked, but the 64-bit default
+leaves plenty of headroom for the products of 32-bit values with a modest number of integer bits.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for accumulating fixed-point products, where 'QBits' is the number of qbits in
+    the accumulated sum **/
+template< int QBits, typename DataType = long long >
+class tFixedAccumulator
+{
+public:
+    /** Records the number of qbits of the accumulated sum **/
+    static const unsigned cQBits = QBits;
+
+    /** Records the underlying type used to hold the accumulated sum **/
+    typedef DataType tValue;
+
+    /** Records the fixed-point type equivalent to the accumulated sum **/
+    typedef tFixedPoint< QBits, DataType > tFixed;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    tFixedAccumulator() : value_() {}
+
+    /** Constructs an accumulator with an initial 'value', which must have no more qbits than the
+        accumulator **/
+    template< int QBits2, typename DataType2 > explicit tFixedAccumulator( tFixedPoint<QBits2,DataType2> value )
+        : value_( shiftedUp_< QBits2 >( DataType( value.qValue() ) ) ) {}
+
+    /** Clears the accumulated sum **/
+    void reset() { value_ = 0; }
+
+    //---------------------------------------------------------------------------------------------
+    // Accumulation
+
+    /** Adds (or subtracts, for "msub") the full-precision product of 'a' and 'b' **/
+    template< int QBits1, typename DataType1, int QBits2, typename DataType2 >
+    tFixedAccumulator& mac( tFixedPoint<QBits1,DataType1> a, tFixedPoint<QBits2,DataType2> b )
+        { value_ += shiftedUp_< QBits1 + QBits2 >( DataType( a.qValue() ) * b.qValue() ); return *this; }
+
+    template< int QBits1, typename DataType1, int QBits2, typename DataType2 >
+    tFixedAccumulator& msub( tFixedPoint<QBits1,DataType1> a, tFixedPoint<QBits2,DataType2> b )
+        { value_ -= shiftedUp_< QBits1 + QBits2 >( DataType( a.qValue() ) * b.qValue() ); return *this; }
+
+    /** Adds or subtracts a fixed-point 'value', which must have no more qbits than the accumulator **/
+    template< int QBits2, typename DataType2 > tFixedAccumulator& operator+=( tFixedPoint<QBits2,DataType2> value )
+        { value_ += shiftedUp_< QBits2 >( DataType( value.qValue() ) ); return *this; }
+    template< int QBits2, typename DataType2 > tFixedAccumulator& operator-=( tFixedPoint<QBits2,DataType2> value )
+        { value_ -= shiftedUp_< QBits2 >( DataType( value.qValue() ) ); return *this; }
+
+    tFixedAccumulator& operator+=( const tFixedAccumulator& value ) { value_ += value.value_; return *this; }
+    tFixedAccumulator& operator-=( const tFixedAccumulator& value ) { value_ -= value.value_; return *this; }
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Returns the accumulated sum, without any loss of precision **/
+    tFixed value() const { return tFixed::create( value_ ); }
+    tValue qValue() const { return value_; }
+
+    /** Returns the accumulated sum reduced to 'QBits2' qbits, of either the same data-type as the
+        accumulator or the one given **/
+    template< int QBits2 > tFixedPoint<QBits2,DataType> truncatedTo() const { return value().template truncatedTo< QBits2 >(); }
+    template< int QBits2 > tFixedPoint<QBits2,DataType> roundedTo()   const { return value().template roundedTo< QBits2 >(); }
+
+    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> truncatedTo() const { return value().template truncatedTo< QBits2, DataType2 >(); }
+    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> roundedTo()   const { return value().template roundedTo< QBits2, DataType2 >(); }
+
+    /** Returns the accumulated sum reduced to the fixed-point type 'FPType' **/
+    template< typename FPType > FPType truncatedTo() const { return value().template truncatedTo< FPType >(); }
+    template< typename FPType > FPType roundedTo()   const { return value().template roundedTo< FPType >(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    /** Shifts a raw 'value' with 'QBits2' qbits up to the accumulator's qbits **/
+    template< int QBits2 > static DataType shiftedUp_( DataType value ) {
+        static_assert( QBits2 <= QBits, "values added to a tFixedAccumulator must not have more qbits than it" );
+        return FIXEDPOINT_IMPL_SHIFTUP( value, QBits - QBits2 );
+    }
+
+    DataType value_;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
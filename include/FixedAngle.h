@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides an angle type where the full range of an unsigned word
+//   is one turn, so that angles wrap around without any modulo arithmetic.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDANGLE_H
+#define FIXEDANGLE_H
+
+#include "FixedPoint.h"
+#include "FixedPointMath.h"
+#include <type_traits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Angle Template Class
+***************************************************************************************************
+
+The tFixedAngle class holds an angle in an unsigned 'StorageType' (an unsigned by default) where
+the full range of the word is one turn, so 2^32 is 2*pi for an unsigned, and 2^16 for an unsigned
+short. Adding and subtracting angles wrap modulo one turn for free, which suits rotor positions
+and phase accumulators (NCOs) that would otherwise need reducing after every update,
+
+    tFixedAngle<> theta;                                    // the electrical angle
+    const tFixedAngle<> step = tFixedAngle<>::fromTurns( 0.0025_q30 );
+
+    void pwmIsr() {
+        theta += step;                                      // 50Hz at 20kHz, wraps at 2*pi
+        tSinCos< 15 > sc = sincos< 15 >( theta );           // straight to the sin table
+        ...
+    }
+
+The difference of two angles is also an angle, which can be read as a signed value in the range
+[-1/2,1/2) turn, so the error of a PLL or angle observer needs no wrapping either,
+
+    tFixedPoint< 30 > error = (measured - theta).turns< 30 >();
+    int error32 = (measured - theta).signedRaw();           // the same, as a raw value
+
+An angle can be created from (or read as) turns or radians as fixed-point values, and from
+radians or degrees as doubles when floating-point support is enabled. Angles in radians are
+converted with the same 32-bit phase as the FixedPointMath.h functions, and any angle (including
+negative ones) is reduced to one turn. Multiplying an angle by an integer, eg. by the number of
+pole pairs to get an electrical angle from a mechanical one, also wraps.
+
+"sin", "cos" and "sincos" (as in FixedPointMath.h) take a tFixedAngle directly, without any
+conversion, and "index< Bits >" returns the top bits of the angle as an index into a table of
+2^Bits entries per turn, by a single shift. "tFixedAngle<>::atan2( y, x )" returns the angle of
+a vector.
+
+Only "==" and "!=" are provided, as one angle being less than another isn't meaningful once they
+wrap - compare their difference instead.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for an angle, where the range of the unsigned 'StorageType' is one turn **/
+template< typename StorageType = unsigned >
+class tFixedAngle
+{
+public:
+    typedef StorageType tStorage;
+    typedef typename std::make_signed< StorageType >::type tSigned;
+
+    /** The number of bits in one turn **/
+    static const unsigned cBits = 8*sizeof(StorageType);
+
+    static_assert( std::is_unsigned< StorageType >::value && cBits <= 32, "tFixedAngle needs an unsigned data-type of 32 bits or less" );
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    /** Creates an angle from its raw value, where 2^cBits is one turn **/
+    static constexpr tFixedAngle create( StorageType raw ) { return tFixedAngle( raw, 0 ); }
+
+    constexpr tFixedAngle() : value_() {}
+
+    /** Creates an angle from a number of 'turns', ignoring any whole turns **/
+    template< int QBits, typename DataType > static constexpr tFixedAngle fromTurns( tFixedPoint<QBits,DataType> turns ) {
+        return tFixedAngle( StorageType( (QBits <= int( cBits ))?
+                                         ((unsigned long long)( (long long)( turns.qValue() ) ) << ((QBits <= int( cBits ))? (cBits - QBits) : 0)) :
+                                         (unsigned long long)( tFixedMath_::rescaled( turns.qValue(), QBits, cBits ) ) ), 0 );
+    }
+
+    /** Creates an angle from one in 'radians' **/
+    template< int QBits, typename DataType > static tFixedAngle fromRadians( tFixedPoint<QBits,DataType> radians ) {
+        static_assert( sizeof(DataType) <= sizeof(int), "tFixedAngle only supports radians with data-types of 32 bits or less" );
+        return fromPhase( tFixedMath_::phase( radians.qValue(), QBits ) );
+    }
+
+    /** Creates an angle from a 32-bit phase, as used by FixedPointMath.h **/
+    static constexpr tFixedAngle fromPhase( unsigned phase )
+        { return tFixedAngle( StorageType( (cBits < 32)? ((phase + (1u << ((31 - cBits) & 31))) >> ((32 - cBits) & 31)) : phase ), 0 ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    static tFixedAngle fromRadians( double radians ) { return fromTurnsDouble( radians * (1/(2*tFixedConstMath_::cPi)) ); }
+    static tFixedAngle fromDegrees( double degrees ) { return fromTurnsDouble( degrees * (1/360.0) ); }
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Returns the raw value, where 2^cBits is one turn, or the same as a signed value in the
+        range [-2^(cBits-1),2^(cBits-1)) **/
+    constexpr StorageType raw() const { return value_; }
+    constexpr tSigned signedRaw() const { return tSigned( signedValue() ); }
+
+    /** Returns the angle as a 32-bit phase, as used by FixedPointMath.h **/
+    constexpr unsigned phase() const { return unsigned( value_ ) << ((32 - cBits) & 31); }
+
+    /** Returns the index, of a table with 2^Bits entries per turn, that the angle falls in **/
+    template< unsigned Bits > constexpr unsigned index() const {
+        static_assert( Bits > 0 && Bits <= cBits, "the index can't have more bits than the angle" );
+        return unsigned( value_ ) >> (cBits - Bits);
+    }
+
+    /** Returns the angle in turns in the range [-1/2,1/2), or in radians in the range [-pi,pi),
+        with 'QBits' qbits. Results which don't fit the data-type saturate **/
+    template< int QBits, typename DataType = int > tFixedPoint<QBits,DataType> turns() const
+        { return tFixedPoint<QBits,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( signedValue(), cBits, QBits ) ) ); }
+    template< int QBits, typename DataType = int > tFixedPoint<QBits,DataType> radians() const
+        { return tFixedPoint<QBits,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::radians( int( signedValue() * (1ll << (32 - cBits)) ), QBits ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Angle of a Vector
+
+    /** Returns the angle of the vector ('x','y') **/
+    template< int QBits, typename DataType > static tFixedAngle atan2( tFixedPoint<QBits,DataType> y, tFixedPoint<QBits,DataType> x ) {
+        static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+        FIXEDPOINT_PROFILE( "atan2" );
+        long long magnitude;
+        int scale;
+        return fromPhase( tFixedMath_::atan2( x.qValue(), y.qValue(), magnitude, scale ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    /** All of these wrap modulo one turn **/
+    constexpr tFixedAngle operator+( tFixedAngle rhs ) const { return tFixedAngle( StorageType( value_ + rhs.value_ ), 0 ); }
+    constexpr tFixedAngle operator-( tFixedAngle rhs ) const { return tFixedAngle( StorageType( value_ - rhs.value_ ), 0 ); }
+    constexpr tFixedAngle operator-() const { return tFixedAngle( StorageType( 0u - value_ ), 0 ); }
+    constexpr tFixedAngle operator*( int times ) const { return tFixedAngle( StorageType( unsigned( value_ ) * unsigned( times ) ), 0 ); }
+
+    tFixedAngle& operator+=( tFixedAngle rhs ) { return *this = *this + rhs; }
+    tFixedAngle& operator-=( tFixedAngle rhs ) { return *this = *this - rhs; }
+    tFixedAngle& operator*=( int times ) { return *this = *this * times; }
+
+    constexpr bool operator==( tFixedAngle rhs ) const { return value_ == rhs.value_; }
+    constexpr bool operator!=( tFixedAngle rhs ) const { return value_ != rhs.value_; }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    constexpr tFixedAngle( StorageType raw, int ) : value_( raw ) {}
+
+    /** Returns the raw value as a signed value, without relying on an out of range conversion **/
+    constexpr long long signedValue() const { return (long long)( value_ ) - ((value_ >> (cBits - 1))? (1ll << cBits) : 0); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    static tFixedAngle fromTurnsDouble( double turns ) {
+        long long whole = (long long)( turns );
+        if (whole > turns) --whole;
+        return tFixedAngle( StorageType( (unsigned long long)( (turns - whole) * (1ull << cBits) + 0.5 ) ), 0 );
+    }
+#   endif
+
+    StorageType  value_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+template< typename StorageType > constexpr tFixedAngle<StorageType> operator*( int times, tFixedAngle<StorageType> angle ) { return angle * times; }
+
+/** Return the sin, cos, or both, of an 'angle' with 'QOut' qbits, as for the versions taking an
+    angle in radians in FixedPointMath.h **/
+template< int QOut, typename DataType = int, typename StorageType > tFixedPoint<QOut,DataType> sin( tFixedAngle<StorageType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "sin" );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( angle.phase() ), 30, QOut ) ) );
+}
+
+template< int QOut, typename DataType = int, typename StorageType > tFixedPoint<QOut,DataType> cos( tFixedAngle<StorageType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "cos" );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( angle.phase() + (1u << 30) ), 30, QOut ) ) );
+}
+
+template< int QOut, typename DataType = int, typename StorageType > tSinCos<QOut,DataType> sincos( tFixedAngle<StorageType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "sincos" );
+    const unsigned phase = angle.phase();
+    tSinCos<QOut,DataType> result;
+    result.sin = tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( phase ), 30, QOut ) ) );
+    result.cos = tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( phase + (1u << 30) ), 30, QOut ) ) );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
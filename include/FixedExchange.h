@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides lock-free exchange of fixed-point state between an
+//   interrupt (or thread) and a single reader, as snapshots or a stream.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDEXCHANGE_H
+#define FIXEDEXCHANGE_H
+
+#include "FixedPoint.h"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+
+/**************************************************************************************************
+                          Lock-Free Fixed-Point Exchange Template Classes
+***************************************************************************************************
+
+Copying a struct of values from a PWM interrupt to a background task normally needs interrupts
+disabled around the copy, so the reader never sees half of one update and half of the next. The
+classes here do the same without ever blocking the writer, for one writer and one reader,
+
+    tFixedSnapshot< T >         the latest value of a struct - the writer overwrites it, and the
+                                reader gets a consistent copy of the most recent one.
+    tFixedRing< T, N >          a queue of up to N values (a power of 2) - the writer adds to it
+                                and the reader removes them in order, eg. for streaming samples.
+
+For example,
+
+    struct tMeasured { tQ16 id, iq, speed, vbus; };
+    tFixedSnapshot< tMeasured > gMeasured;
+    tFixedRing< tQ12s, 256 > gScope;
+
+    void pwmIsr() {                             // the writer
+        ...
+        gMeasured.write( measured );            // never waits
+        gScope.push( ia12 );                    // returns false (and drops the sample) if full
+    }
+
+    void supervisor() {                         // the reader, at 1kHz
+        tMeasured m = gMeasured.read();
+        tQ12s samples[32];
+        unsigned n = gScope.pop( samples, 32 );
+    }
+
+tFixedSnapshot is a sequence lock. The writer makes a sequence number odd, stores the value and
+makes it even again, and the reader copies the value between two reads of the sequence number,
+trying again if it was odd or changed. The value is kept as an array of atomic words so that the
+copies are well defined even while they race. A read only has to retry if the writer interrupted
+it, so with a 20kHz writer and a value a few words long retries are rare and never repeated.
+
+tFixedRing keeps separate read and write positions, each only changed by one side, so neither side
+waits for the other.
+
+Both only need the type to be trivially copyable, which all of the fixed-point types (and structs
+of them) are, and atomic loads and stores of an unsigned, which are plain loads and stores (and
+memory barriers where the core needs them) on any 32-bit target. Each class must have only one
+writer and one reader at a time.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Snapshot
+
+/** Template class holding the latest value of 'T', written by one side and read by the other
+    without locks **/
+template< typename T >
+class tFixedSnapshot
+{
+public:
+    static_assert( std::is_trivially_copyable<T>::value, "tFixedSnapshot needs a trivially copyable type" );
+
+    tFixedSnapshot() : sequence_( 0 ) { write( T() ); }
+    explicit tFixedSnapshot( const T& value ) : sequence_( 0 ) { write( value ); }
+
+    /** Replaces the value, which never waits for the reader **/
+    void write( const T& value ) {
+        unsigned words[cWords] = {};
+        std::memcpy( words, &value, sizeof(T) );
+        unsigned sequence = sequence_.load( std::memory_order_relaxed );
+        sequence_.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        for (unsigned i = 0; i < cWords; ++i) words_[i].store( words[i], std::memory_order_relaxed );
+        sequence_.store( sequence + 2, std::memory_order_release );
+    }
+
+    /** Returns a copy of the latest complete value written **/
+    T read() const {
+        T value;
+        while (!tryRead( value )) {}
+        return value;
+    }
+
+    /** Copies the latest value to 'value' and returns true, or returns false without changing it
+        if a write was in progress, for readers that would rather do something else than retry **/
+    bool tryRead( T& value ) const {
+        unsigned words[cWords];
+        unsigned before = sequence_.load( std::memory_order_acquire );
+        if (before & 1) return false;
+        for (unsigned i = 0; i < cWords; ++i) words[i] = words_[i].load( std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if (sequence_.load( std::memory_order_relaxed ) != before) return false;
+        std::memcpy( &value, words, sizeof(T) );
+        return true;
+    }
+
+    /** Returns the number of writes so far, which lets a reader tell whether the value has been
+        updated since it last looked **/
+    unsigned count() const { return (sequence_.load( std::memory_order_acquire ) >> 1) - 1; }
+
+private:
+    static const unsigned cWords = (sizeof(T) + sizeof(unsigned) - 1) / sizeof(unsigned);
+
+    std::atomic<unsigned>  sequence_;           // odd while a write is in progress
+    std::atomic<unsigned>  words_[cWords];
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Ring Buffer
+
+/** Template class for a queue of up to 'N' values of 'T' (a power of 2), with one side adding to
+    it and the other removing from it without locks **/
+template< typename T, unsigned N >
+class tFixedRing
+{
+public:
+    static_assert( std::is_trivially_copyable<T>::value, "tFixedRing needs a trivially copyable type" );
+    static_assert( N > 0 && (N & (N - 1)) == 0, "the size of a tFixedRing must be a power of 2" );
+
+    static const unsigned cSize = N;
+
+    tFixedRing() : read_( 0 ), write_( 0 ) {}
+
+    //---------------------------------------------------------------------------------------------
+    // Writer
+
+    /** Adds 'value', or returns false if the queue is full **/
+    bool push( const T& value ) {
+        unsigned write = write_.load( std::memory_order_relaxed );
+        if (write - read_.load( std::memory_order_acquire ) >= N) return false;
+        values_[write & (N - 1)] = value;
+        write_.store( write + 1, std::memory_order_release );
+        return true;
+    }
+
+    /** Adds up to 'count' values from 'in', returning the number added **/
+    unsigned push( const T* in, unsigned count ) {
+        unsigned write = write_.load( std::memory_order_relaxed );
+        unsigned space = N - (write - read_.load( std::memory_order_acquire ));
+        if (count > space) count = space;
+        for (unsigned i = 0; i < count; ++i) values_[(write + i) & (N - 1)] = in[i];
+        write_.store( write + count, std::memory_order_release );
+        return count;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Reader
+
+    /** Removes the oldest value into 'value', or returns false if the queue is empty **/
+    bool pop( T& value ) {
+        unsigned read = read_.load( std::memory_order_relaxed );
+        if (write_.load( std::memory_order_acquire ) == read) return false;
+        value = values_[read & (N - 1)];
+        read_.store( read + 1, std::memory_order_release );
+        return true;
+    }
+
+    /** Removes up to 'count' of the oldest values into 'out', returning the number removed **/
+    unsigned pop( T* out, unsigned count ) {
+        unsigned read = read_.load( std::memory_order_relaxed );
+        unsigned available = write_.load( std::memory_order_acquire ) - read;
+        if (count > available) count = available;
+        for (unsigned i = 0; i < count; ++i) out[i] = values_[(read + i) & (N - 1)];
+        read_.store( read + count, std::memory_order_release );
+        return count;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Status
+
+    /** These can be called from either side, but are only a lower bound of the values available
+        to the reader, and of the space available to the writer **/
+    unsigned size() const { return write_.load( std::memory_order_acquire ) - read_.load( std::memory_order_acquire ); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() >= N; }
+
+private:
+    // the positions count up and wrap, and are masked to index the buffer
+    std::atomic<unsigned>  read_;               // only changed by the reader
+    std::atomic<unsigned>  write_;              // only changed by the writer
+    T                      values_[N];
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
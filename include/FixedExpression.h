@@ -0,0 +1,294 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides expression templates that evaluate whole fixed-point
+//   expressions at full precision, with a single rounding to the result.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDEXPRESSION_H
+#define FIXEDEXPRESSION_H
+
+#include "FixedPoint.h"
+#include <type_traits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Expression Templates
+***************************************************************************************************
+
+With the tFixedPoint operators each step of an expression has its own result type, so a chain like
+"(a8 * b4 + c12) / d6" needs "roundedTo" or "increasedBy" calls to keep the intermediate results in
+range, and each of them shifts and rounds. Wrapping the first operand in "expr" instead builds the
+whole expression at compile-time, and it is only evaluated when it is assigned,
+
+    tQ16 y16 = (expr( a8 ) * b4 + c12) / d6;        // rounded once, to Q16
+    x12 = expr( k16 ) * (u12 - v12);                 // rounded once, to Q12
+    tQ12 z12 = ((expr( a8 ) * b4 + c12) / d6).roundedTo< tQ12, tRoundHalfEven >();
+
+Any operand of an expression can be another expression, a fixed-point value or an integer, and
+the operators are +, -, * and / and unary -. The result can be converted to any fixed-point type
+(which rounds using FIXEDPOINT_ROUNDING and wraps in the same way as the operators), or read with
+"roundedTo", "truncatedTo" or "evaluated" (which returns the exact intermediate value).
+
+Each node of the expression works out its qbits and the number of bits its value can need at
+compile-time, from those of its operands,
+
+    a + b, a - b        the larger of their qbits, and one more bit than the larger operand
+                        once it is aligned to them.
+    a * b               the sum of their qbits, and the sum of their bits (less one).
+    a / b               the larger of their qbits plus FIXEDPOINT_EXPRESSION_GUARD (default 8).
+    -a                  a's qbits, and one more bit.
+
+and is calculated in an int if its value fits in 32 bits, or a long long otherwise. So sums and
+products are exact, a quotient is rounded once with guard qbits below the result, and the only
+other rounding is the final one.
+
+A sum or product whose value could need more than 64 bits is the only other loss of precision. It
+rounds its operands down (the wider first) by the fewest qbits that make it fit, so it can never
+overflow. A value's bits are those of its data-type, unless a smaller number is given when it is
+wrapped, which keeps more qbits in wide expressions,
+
+    tQ16 v16 = expr< 24 >( a16 ) * b16 * c16;       // a16 is known to be within +-128
+
+Divisions are done in an int when the shifted dividend fits in one, otherwise as a 64-bit division
+(which needs a second division of the remainder if the shifted dividend doesn't fit in 64 bits).
+Like the "/" operator, a quotient wraps if its value is too large for its type.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The number of qbits a quotient keeps below those of its dividend **/
+#ifndef FIXEDPOINT_EXPRESSION_GUARD
+#define FIXEDPOINT_EXPRESSION_GUARD  8
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedExpression_
+{
+    static constexpr int max( int a, int b ) { return (a > b)? a : b; }
+    static constexpr int min( int a, int b ) { return (a < b)? a : b; }
+
+    /** The type a node with a value of 'Bits' bits is calculated in **/
+    template< int Bits > struct tValue { typedef typename std::conditional< (Bits <= 32), int, long long >::type type; };
+
+    /** Returns 'value' converted to T and shifted up by 'ByQBits', or rounded down if it is negative **/
+    template< int ByQBits, typename T, typename Rounding = FIXEDPOINT_ROUNDING, typename T2 > static constexpr T aligned( T2 value )
+        { return (ByQBits >= 0)? FIXEDPOINT_IMPL_SHIFTUP( T( value ), (ByQBits >= 0)? ByQBits : 0 )
+                               : T( tFixedPointCheck_::round< (ByQBits < 0)? -ByQBits : 0, Rounding >( value ) ); }
+};
+
+/** Template class for an expression of type 'Expr', which provides its conversions **/
+template< typename Expr >
+class tFixedExpression
+{
+public:
+    constexpr const Expr& self() const { return static_cast< const Expr& >( *this ); }
+
+    /** Returns the value rounded to a fixed-point value with 'QOut' qbits, using the 'Rounding'
+        policy **/
+    template< int QOut, typename DataType = int, typename Rounding = FIXEDPOINT_ROUNDING > constexpr tFixedPoint<QOut,DataType> roundedTo() const {
+        return tFixedPoint<QOut,DataType>::create( tFixedPointCheck_::wrapped< QOut, DataType >(
+                   (QOut >= Expr::cQBits)? FIXEDPOINT_IMPL_SHIFTUP( (long long)( self().value() ), (QOut >= Expr::cQBits)? QOut - Expr::cQBits : 0 )
+                                         : (long long)( tFixedPointCheck_::rounded< QOut, DataType, (QOut < Expr::cQBits)? Expr::cQBits - QOut : 0, Rounding >( self().value() ) ) ) );
+    }
+    template< typename FPType, typename Rounding = FIXEDPOINT_ROUNDING > constexpr FPType roundedTo() const
+        { return roundedTo< FPType::cQBits, typename FPType::tValue, Rounding >(); }
+
+    template< int QOut, typename DataType = int > constexpr tFixedPoint<QOut,DataType> truncatedTo() const { return roundedTo< QOut, DataType, tRoundTruncate >(); }
+    template< typename FPType > constexpr FPType truncatedTo() const { return roundedTo< FPType::cQBits, typename FPType::tValue, tRoundTruncate >(); }
+
+    /** Converts to the fixed-point type assigned to, see "roundedTo" **/
+    template< int QOut, typename DataType > constexpr operator tFixedPoint<QOut,DataType>() const { return roundedTo< QOut, DataType >(); }
+
+    /** Returns the exact value of the expression, with the qbits and type it was calculated in **/
+    template< typename E = Expr > constexpr tFixedPoint< E::cQBits, typename E::tValue > evaluated() const
+        { return tFixedPoint< E::cQBits, typename E::tValue >::create( self().value() ); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Expression Nodes
+
+/** A fixed-point value (or an integer, with no qbits) used in an expression, whose qValue needs
+    at most 'Bits' bits including a sign bit **/
+template< int QBits, typename DataType, int Bits = int( sizeof(DataType) )*8 + (std::numeric_limits<DataType>::is_signed? 0 : 1) >
+class tFixedExprValue : public tFixedExpression< tFixedExprValue<QBits,DataType,Bits> >
+{
+public:
+    static const int cQBits = QBits;
+    static const int cBits = Bits;
+    typedef typename tFixedExpression_::tValue< cBits >::type tValue;
+
+    constexpr explicit tFixedExprValue( tFixedPoint<QBits,DataType> value ) : value_( value.qValue() ) {}
+
+    constexpr tValue value() const { return value_; }
+
+private:
+    DataType  value_;
+};
+
+/** The sum of two expressions, or their difference if 'Sign' is -1 **/
+template< typename Lhs, typename Rhs, int Sign = 1 >
+class tFixedExprSum : public tFixedExpression< tFixedExprSum<Lhs,Rhs,Sign> >
+{
+    static const int cAligned = tFixedExpression_::max( Lhs::cQBits, Rhs::cQBits );
+    static const int cNeeded = tFixedExpression_::max( Lhs::cBits + cAligned - Lhs::cQBits, Rhs::cBits + cAligned - Rhs::cQBits ) + 1;
+    static const int cDrop = tFixedExpression_::max( cNeeded - 64, 0 );
+
+public:
+    static const int cQBits = cAligned - cDrop;
+    static const int cBits = cNeeded - cDrop;
+    typedef typename tFixedExpression_::tValue< cBits >::type tValue;
+
+    constexpr tFixedExprSum( const Lhs& lhs, const Rhs& rhs ) : lhs_( lhs ), rhs_( rhs ) {}
+
+    constexpr tValue value() const {
+        return (Sign > 0)? tValue( tFixedExpression_::aligned< cQBits - Lhs::cQBits, tValue >( lhs_.value() ) + tFixedExpression_::aligned< cQBits - Rhs::cQBits, tValue >( rhs_.value() ) )
+                         : tValue( tFixedExpression_::aligned< cQBits - Lhs::cQBits, tValue >( lhs_.value() ) - tFixedExpression_::aligned< cQBits - Rhs::cQBits, tValue >( rhs_.value() ) );
+    }
+
+private:
+    Lhs  lhs_;
+    Rhs  rhs_;
+};
+
+template< typename Lhs, typename Rhs > using tFixedExprDifference = tFixedExprSum< Lhs, Rhs, -1 >;
+
+/** The product of two expressions **/
+template< typename Lhs, typename Rhs >
+class tFixedExprProduct : public tFixedExpression< tFixedExprProduct<Lhs,Rhs> >
+{
+    static const int cNeeded = Lhs::cBits + Rhs::cBits - 1;
+    static const int cDrop = tFixedExpression_::max( cNeeded - 64, 0 );
+    static const int cDropLhs = tFixedExpression_::min( tFixedExpression_::max( (cDrop + Lhs::cBits - Rhs::cBits + 1)/2, 0 ), cDrop );      // from the wider first
+    static const int cDropRhs = cDrop - cDropLhs;
+
+public:
+    static const int cQBits = Lhs::cQBits + Rhs::cQBits - cDrop;
+    static const int cBits = cNeeded - cDrop;
+    typedef typename tFixedExpression_::tValue< cBits >::type tValue;
+
+    constexpr tFixedExprProduct( const Lhs& lhs, const Rhs& rhs ) : lhs_( lhs ), rhs_( rhs ) {}
+
+    constexpr tValue value() const {
+        return tValue( tFixedExpression_::aligned< -cDropLhs, typename Lhs::tValue >( lhs_.value() ) )
+             * tFixedExpression_::aligned< -cDropRhs, typename Rhs::tValue >( rhs_.value() );
+    }
+
+private:
+    Lhs  lhs_;
+    Rhs  rhs_;
+};
+
+/** The quotient of two expressions, see the guard qbits above **/
+template< typename Lhs, typename Rhs >
+class tFixedExprQuotient : public tFixedExpression< tFixedExprQuotient<Lhs,Rhs> >
+{
+    static const int cWanted = tFixedExpression_::max( tFixedExpression_::max( Lhs::cQBits, Rhs::cQBits ) + FIXEDPOINT_EXPRESSION_GUARD - Lhs::cQBits + Rhs::cQBits, 0 );
+    static const bool cSingle = Lhs::cBits + cWanted <= 64;     // the shifted dividend fits
+    static const int cShift = cSingle? cWanted : tFixedExpression_::min( cWanted, 64 - Rhs::cBits );
+    typedef typename tFixedExpression_::tValue< tFixedExpression_::max( cSingle? Lhs::cBits + cShift : 64, Rhs::cBits ) >::type tDivide;
+
+public:
+    static const int cQBits = Lhs::cQBits + cShift - Rhs::cQBits;
+    static const int cBits = cSingle? Lhs::cBits + cShift : 64;     // for a divisor of 1 lsb
+    typedef typename tFixedExpression_::tValue< cBits >::type tValue;
+
+    constexpr tFixedExprQuotient( const Lhs& lhs, const Rhs& rhs ) : lhs_( lhs ), rhs_( rhs ) {}
+
+    constexpr tValue value() const { return divided_( tDivide( lhs_.value() ), tDivide( rhs_.value() ) ); }
+
+private:
+    /** Returns the quotient of the dividend shifted up by cShift. When that doesn't fit the
+        truncated quotient is shifted up instead, and the remainder (which is smaller than the
+        divisor) is shifted up and divided to give the bottom bits **/
+    static constexpr tValue divided_( tDivide dividend, tDivide divisor )
+        { return cSingle? tValue( tFixedPointCheck_::divide( FIXEDPOINT_IMPL_SHIFTUP( dividend, cShift ), divisor ) )
+                        : tValue( FIXEDPOINT_IMPL_SHIFTUP( dividend / divisor, cShift )
+                                  + tFixedPointCheck_::divide( FIXEDPOINT_IMPL_SHIFTUP( dividend % divisor, cShift ), divisor ) ); }
+
+    Lhs  lhs_;
+    Rhs  rhs_;
+};
+
+/** The negation of an expression **/
+template< typename Expr >
+class tFixedExprNegate : public tFixedExpression< tFixedExprNegate<Expr> >
+{
+public:
+    static const int cQBits = Expr::cQBits;
+    static const int cBits = tFixedExpression_::min( Expr::cBits + 1, 64 );
+    typedef typename tFixedExpression_::tValue< cBits >::type tValue;
+
+    constexpr explicit tFixedExprNegate( const Expr& expr ) : expr_( expr ) {}
+
+    constexpr tValue value() const { return -tValue( expr_.value() ); }
+
+private:
+    Expr  expr_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+/** Starts an expression with the fixed-point 'value' **/
+template< int QBits, typename DataType > constexpr tFixedExprValue<QBits,DataType> expr( tFixedPoint<QBits,DataType> value )
+    { return tFixedExprValue<QBits,DataType>( value ); }
+
+/** As above, for a 'value' known to need no more than 'Bits' bits (including the sign) **/
+template< int Bits, int QBits, typename DataType > constexpr tFixedExprValue<QBits,DataType,Bits> expr( tFixedPoint<QBits,DataType> value )
+    { return tFixedExprValue<QBits,DataType,Bits>( value ); }
+
+/** This macro defines a binary operator 'op' creating the node 'Node' for every combination of an
+    expression with another expression, a fixed-point value or an integer **/
+#define FIXEDPOINT_IMPL_EXPRESSION_OPERATOR( op, Node ) \
+    template< typename L, typename R > constexpr Node< L, R > operator op( const tFixedExpression<L>& lhs, const tFixedExpression<R>& rhs ) \
+        { return Node< L, R >( lhs.self(), rhs.self() ); } \
+    template< typename L, int QBits, typename DataType > constexpr Node< L, tFixedExprValue<QBits,DataType> > operator op( const tFixedExpression<L>& lhs, tFixedPoint<QBits,DataType> rhs ) \
+        { return Node< L, tFixedExprValue<QBits,DataType> >( lhs.self(), tFixedExprValue<QBits,DataType>( rhs ) ); } \
+    template< int QBits, typename DataType, typename R > constexpr Node< tFixedExprValue<QBits,DataType>, R > operator op( tFixedPoint<QBits,DataType> lhs, const tFixedExpression<R>& rhs ) \
+        { return Node< tFixedExprValue<QBits,DataType>, R >( tFixedExprValue<QBits,DataType>( lhs ), rhs.self() ); } \
+    template< typename L > constexpr Node< L, tFixedExprValue<0,int> > operator op( const tFixedExpression<L>& lhs, int rhs ) \
+        { return Node< L, tFixedExprValue<0,int> >( lhs.self(), tFixedExprValue<0,int>( tFixedPoint<0,int>::create( rhs ) ) ); } \
+    template< typename R > constexpr Node< tFixedExprValue<0,int>, R > operator op( int lhs, const tFixedExpression<R>& rhs ) \
+        { return Node< tFixedExprValue<0,int>, R >( tFixedExprValue<0,int>( tFixedPoint<0,int>::create( lhs ) ), rhs.self() ); }
+
+FIXEDPOINT_IMPL_EXPRESSION_OPERATOR( +, tFixedExprSum )
+FIXEDPOINT_IMPL_EXPRESSION_OPERATOR( -, tFixedExprDifference )
+FIXEDPOINT_IMPL_EXPRESSION_OPERATOR( *, tFixedExprProduct )
+FIXEDPOINT_IMPL_EXPRESSION_OPERATOR( /, tFixedExprQuotient )
+
+#undef FIXEDPOINT_IMPL_EXPRESSION_OPERATOR
+
+template< typename E > constexpr tFixedExprNegate<E> operator-( const tFixedExpression<E>& value ) { return tFixedExprNegate<E>( value.self() ); }
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides fixed-point FIR, biquad and first-order low-pass
+//   filters that process single samples or blocks of samples.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDFILTER_H
+#define FIXEDFILTER_H
+
+#include "FixedPoint.h"
+#include "FixedPointBatch.h"
+#include "SatFixedPoint.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point Filter Template Classes
+***************************************************************************************************
+
+This file provides three filters, each of which filters either a single sample or a block of
+samples (eg. an oversampled ADC buffer filled by DMA),
+
+    tFir< N, QCoeff, QBits >            N tap FIR filter.
+    tBiquad< QCoeff, QBits >            second-order IIR section.
+    tLowPass< Shift, QBits >            first-order IIR low-pass with a coefficient of 2^-Shift.
+
+'QCoeff' is the number of qbits of the coefficients and 'QBits' those of the samples, both with the
+same data-type (int by default). For example,
+
+    constexpr tQ14 cTaps[4] = { 0.1_q14, 0.4_q14, 0.4_q14, 0.1_q14 };
+    tFir< 4, 14, 12 > fir( cTaps );
+    tQ12 y = fir.process( x );                  // one sample
+    fir.process( adc, filtered, 32 );           // or a block of them
+
+    tBiquad< 14, 12 > notch( b0, b1, b2, a1, a2 );
+    tLowPass< 4, 12 > busFilter;                // y += (x - y)/16
+
+The products are summed at full precision in 64-bit accumulators and each output is rounded (and
+saturated to the data-type) once. The FIR's delay line is stored twice over so that the most
+recent N samples are always contiguous, which lets it use the "dot" batch kernel (SIMD for 16-bit
+data on Cortex-M4/M7) for each output.
+
+tBiquad computes y = b0*x + b1*x[-1] + b2*x[-2] - a1*y[-1] - a2*y[-2] (a0 is 1), using the structure
+given by its 'Form' template argument,
+
+    tDirectForm1                keeps the previous inputs and outputs, so the state is at the sample
+                                qbits and can't overflow internally (the default).
+    tDirectForm2Transposed      keeps two partial sums at full precision, which needs less state
+                                and keeps the rounding noise down for narrow-band filters.
+
+tLowPass keeps its state with an extra 'Shift' qbits, so small changes in the input aren't lost
+to the dead-band a plain "y += (x - y) >> Shift" has, and rounds the feedback so that the output
+isn't biased. It needs no multiplies at all.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedFilter_
+{
+    /** Returns a sum of products with 'ByQBits' more qbits than a sample, rounded and saturated
+        to a sample **/
+    template< int QBits, typename DataType, int ByQBits > static tFixedPoint<QBits,DataType> output( long long sum )
+        { return tFixedPoint<QBits,DataType>::create( tSaturate<DataType>::clamp( tFixedPointCheck_::round< ByQBits >( sum ) ) ); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// FIR Filter
+
+/** Template class for an 'N' tap FIR filter, with coefficients of 'QCoeff' qbits and samples of
+    'QBits' qbits **/
+template< unsigned N, int QCoeff, int QBits, typename DataType = int >
+class tFir
+{
+public:
+    typedef tFixedPoint< QCoeff, DataType >  tCoeff;
+    typedef tFixedPoint< QBits, DataType >   tSample;
+
+    static_assert( N > 0, "a tFir filter needs at least one tap" );
+
+    /** Constructs a filter with the 'N' 'coeffs' (coeffs[0] multiplies the newest sample), and
+        the delay line cleared  **/
+    explicit tFir( const tCoeff* coeffs ) : position_( 0 ) {
+        for (unsigned i = 0; i < N; ++i) coeffs_[i] = coeffs[i];
+        reset();
+    }
+
+    /** Sets every sample in the delay line to 'value' **/
+    void reset( const tSample& value = tSample() ) { for (unsigned i = 0; i < 2*N; ++i) delay_[i] = value; }
+
+    /** Returns the output after adding the sample 'x' **/
+    tSample process( const tSample& x ) {
+        FIXEDPOINT_PROFILE( "fir" );
+        position_ = (position_ == 0)? N - 1 : position_ - 1;
+        delay_[position_] = x;
+        delay_[position_ + N] = x;
+        return tFixedFilter_::output< QBits, DataType, QCoeff >( dot( coeffs_, delay_ + position_, N ).qValue() );
+    }
+
+    /** Filters 'count' samples from 'in' to 'out', which may be the same array **/
+    void process( const tSample* in, tSample* out, unsigned count ) {
+        FIXEDPOINT_PROFILE( "fir block" );
+        for (unsigned i = 0; i < count; ++i) out[i] = process( in[i] );
+    }
+
+private:
+    tCoeff    coeffs_[N];
+    tSample   delay_[2*N];        // the newest sample is at position_ and position_ + N
+    unsigned  position_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Biquad Filter
+
+/** Biquad structure that keeps the previous inputs and outputs **/
+struct tDirectForm1
+{
+    template< int QCoeff, int QBits, typename DataType > class tState
+    {
+    public:
+        void reset( DataType value ) { x1_ = x2_ = y1_ = y2_ = value; }
+
+        /** Returns the next output for the raw sample 'x' and coefficients b0, b1, b2, a1, a2 **/
+        DataType step( const DataType* c, DataType x ) {
+            long long sum = (long long)( c[0] ) * x + (long long)( c[1] ) * x1_ + (long long)( c[2] ) * x2_
+                          - (long long)( c[3] ) * y1_ - (long long)( c[4] ) * y2_;
+            DataType y = tFixedFilter_::output< QBits, DataType, QCoeff >( sum ).qValue();
+            x2_ = x1_; x1_ = x;
+            y2_ = y1_; y1_ = y;
+            return y;
+        }
+
+    private:
+        DataType x1_, x2_, y1_, y2_;
+    };
+};
+
+/** Biquad structure that keeps two partial sums at full precision **/
+struct tDirectForm2Transposed
+{
+    template< int QCoeff, int QBits, typename DataType > class tState
+    {
+    public:
+        /** Sets the partial sums for an input and output that have both been 'value' forever **/
+        void reset( DataType value, const DataType* c ) {
+            s1_ = ((long long)( c[1] ) + c[2] - c[3] - c[4]) * value;
+            s2_ = ((long long)( c[2] ) - c[4]) * value;
+        }
+
+        DataType step( const DataType* c, DataType x ) {
+            DataType y = tFixedFilter_::output< QBits, DataType, QCoeff >( (long long)( c[0] ) * x + s1_ ).qValue();
+            s1_ = (long long)( c[1] ) * x - (long long)( c[3] ) * y + s2_;
+            s2_ = (long long)( c[2] ) * x - (long long)( c[4] ) * y;
+            return y;
+        }
+
+    private:
+        long long s1_, s2_;         // with QCoeff + QBits qbits
+    };
+};
+
+/** Template class for a second-order IIR filter section, with coefficients of 'QCoeff' qbits and
+    samples of 'QBits' qbits, using the structure 'Form' **/
+template< int QCoeff, int QBits, typename DataType = int, typename Form = tDirectForm1 >
+class tBiquad
+{
+public:
+    typedef tFixedPoint< QCoeff, DataType >  tCoeff;
+    typedef tFixedPoint< QBits, DataType >   tSample;
+
+    static_assert( sizeof(DataType) <= 4, "tBiquad needs the products of the coefficients and samples to fit in 64 bits" );
+
+    /** Constructs a filter with the coefficients given (a0 is 1), and its state cleared **/
+    tBiquad( const tCoeff& b0, const tCoeff& b1, const tCoeff& b2, const tCoeff& a1, const tCoeff& a2 ) {
+        setCoefficients( b0, b1, b2, a1, a2 );
+        reset();
+    }
+
+    /** Changes the coefficients without changing the state **/
+    void setCoefficients( const tCoeff& b0, const tCoeff& b1, const tCoeff& b2, const tCoeff& a1, const tCoeff& a2 ) {
+        coeffs_[0] = b0.qValue(); coeffs_[1] = b1.qValue(); coeffs_[2] = b2.qValue();
+        coeffs_[3] = a1.qValue(); coeffs_[4] = a2.qValue();
+    }
+
+    /** Sets the state as if the input and output had both been 'value' forever **/
+    void reset( const tSample& value = tSample() ) { reset_( state_, value.qValue() ); }
+
+    /** Returns the output for the sample 'x' **/
+    tSample process( const tSample& x ) {
+        FIXEDPOINT_PROFILE( "biquad" );
+        return tSample::create( state_.step( coeffs_, x.qValue() ) );
+    }
+
+    /** Filters 'count' samples from 'in' to 'out', which may be the same array **/
+    void process( const tSample* in, tSample* out, unsigned count ) {
+        FIXEDPOINT_PROFILE( "biquad block" );
+        typename Form::template tState< QCoeff, QBits, DataType > state = state_;
+        for (unsigned i = 0; i < count; ++i) out[i] = tSample::create( state.step( coeffs_, in[i].qValue() ) );
+        state_ = state;
+    }
+
+private:
+    void reset_( tDirectForm1::tState< QCoeff, QBits, DataType >& state, DataType value ) { state.reset( value ); }
+    void reset_( tDirectForm2Transposed::tState< QCoeff, QBits, DataType >& state, DataType value ) { state.reset( value, coeffs_ ); }
+
+    DataType  coeffs_[5];         // b0, b1, b2, a1, a2
+    typename Form::template tState< QCoeff, QBits, DataType > state_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Low-Pass Filter
+
+/** Template class for a first-order low-pass filter "y += (x - y) * 2^-Shift", with samples of
+    'QBits' qbits **/
+template< int Shift, int QBits, typename DataType = int >
+class tLowPass
+{
+public:
+    typedef tFixedPoint< QBits, DataType >  tSample;
+    typedef typename tSample::tWide  tWide;
+
+    static_assert( Shift > 0, "a tLowPass filter needs a shift of at least 1" );
+
+    explicit tLowPass( const tSample& value = tSample() ) { reset( value ); }
+
+    /** Sets the output to 'value' **/
+    void reset( const tSample& value = tSample() ) { state_ = FIXEDPOINT_IMPL_SHIFTUP( tWide( value.qValue() ), Shift ); }
+
+    /** Returns the output after the sample 'x' **/
+    tSample process( const tSample& x ) {
+        FIXEDPOINT_PROFILE( "low-pass" );
+        state_ += tWide( x.qValue() ) - tFixedPointCheck_::round< Shift >( state_ );
+        return output();
+    }
+
+    /** Filters 'count' samples from 'in' to 'out', which may be the same array **/
+    void process( const tSample* in, tSample* out, unsigned count ) {
+        FIXEDPOINT_PROFILE( "low-pass block" );
+        tWide state = state_;
+        for (unsigned i = 0; i < count; ++i) {
+            state += tWide( in[i].qValue() ) - tFixedPointCheck_::round< Shift >( state );
+            out[i] = tSample::create( DataType( tFixedPointCheck_::round< Shift >( state ) ) );
+        }
+        state_ = state;
+    }
+
+    /** Returns the last output **/
+    tSample output() const { return tSample::create( DataType( tFixedPointCheck_::round< Shift >( state_ ) ) ); }
+
+private:
+    tWide  state_;                // the output with 'Shift' extra qbits
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides interpolating lookup tables of fixed-point values
+//   that are generated at compile-time.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDLUT_H
+#define FIXEDLUT_H
+
+#include "FixedPoint.h"
+#include "FixedPointMath.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point Lookup Table Template Classes
+***************************************************************************************************
+
+The tFixedLut class is a table of 'N' values of a function, with linear interpolation between them,
+for curves such as temperature derating or throttle maps. The tFixedLut2 class is a grid of values
+with bilinear interpolation, for maps such as flux or torque against speed and current.
+
+The tables are generated by the compiler from a 'Generator' class, and are constexpr so they are
+placed in flash rather than being built in RAM at start-up. The generator gives the input of the
+first entry, the log2 of the spacing of the entries, and a constexpr function for the values,
+
+    struct tDerating
+    {
+        static constexpr double cFirst = 20.0;          // the first entry is for 20 degrees
+        static const int cLog2Step = 2;                 // and the rest are 4 degrees apart
+        static constexpr double value( double celsius ) { return (celsius < 80)? 1.0 : 1.0 - (celsius - 80)/40; }
+    };
+
+    typedef tFixedLut< 8, 15, 25, tDerating > tDeratingLut;           // Q8 in, Q15 out, 20 to 116 degrees
+    tQ15 limit = tDeratingLut::lookup( temperature8 );
+
+The spacing is a power of two, so the index and interpolation fraction are just a shift and a mask
+of the input's qValue, and a lookup is a subtraction, a clamp, two loads and a multiply. The spacing
+must be at least two LSBs of the input. Inputs outside the table give the first or last value.
+
+The values are only ever evaluated by the compiler, so the generator can use doubles (and the
+functions in tFixedConstMath_) without needing floating-point support on the target. Values are
+rounded to the nearest qValue, and saturate if they don't fit the data-type.
+
+For tFixedLut2 the generator gives cFirstX, cLog2StepX, cFirstY, cLog2StepY and value( x, y ), and
+the table is 'NX' by 'NY' entries.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedLut_
+{
+    /** Returns 'value' (with the qbits of the output) as the nearest qValue, saturated **/
+    template< typename DataType > static constexpr DataType entry( double value ) {
+        return (value >= double( std::numeric_limits<DataType>::max() ))? std::numeric_limits<DataType>::max()
+             : (value <= double( std::numeric_limits<DataType>::min() ))? std::numeric_limits<DataType>::min()
+             : DataType( tFixedConstMath_::rounded( value ) );
+    }
+
+    /** Returns the qValue of the first input **/
+    static constexpr long long first( double value, int qBits ) { return tFixedConstMath_::rounded( value * double( 1ll << qBits ) ); }
+
+    /** Returns the offset of 'value' from the first entry, clamped to the table **/
+    static long long offset( long long value, long long first, long long last ) {
+        long long offset = value - first;
+        return (offset < 0)? 0 : (offset > last)? last : offset;
+    }
+};
+
+/** Generates the table of a tFixedLut. It has an extra copy of the last entry so that the last
+    input doesn't need to be special-cased **/
+template< int InQ, int OutQ, unsigned N, int Shift, typename Generator, typename DataType >
+struct tFixedLutTable_
+{
+    static constexpr DataType entry( unsigned i ) {
+        return tFixedLut_::entry< DataType >( Generator::value( double( tFixedLut_::first( Generator::cFirst, InQ ) + ((long long)( (i < N)? i : N - 1 ) << Shift) )
+                                                               / double( 1ll << InQ ) ) * double( 1ll << OutQ ) );
+    }
+    template< unsigned... I > static constexpr tFixedTable_< DataType, sizeof...(I) > table( tFixedIndices_<I...> ) { return {{ entry( I )... }}; }
+};
+
+/** Generates the table of a tFixedLut2, by rows of increasing y with an extra copy of the last
+    row and column **/
+template< int InQX, int InQY, int OutQ, unsigned NX, unsigned NY, int ShiftX, int ShiftY, typename Generator, typename DataType >
+struct tFixedLut2Table_
+{
+    static constexpr double x( unsigned i ) { return double( tFixedLut_::first( Generator::cFirstX, InQX ) + ((long long)( (i < NX)? i : NX - 1 ) << ShiftX) ) / double( 1ll << InQX ); }
+    static constexpr double y( unsigned j ) { return double( tFixedLut_::first( Generator::cFirstY, InQY ) + ((long long)( (j < NY)? j : NY - 1 ) << ShiftY) ) / double( 1ll << InQY ); }
+    static constexpr DataType entry( unsigned k )
+        { return tFixedLut_::entry< DataType >( Generator::value( x( k % (NX + 1) ), y( k / (NX + 1) ) ) * double( 1ll << OutQ ) ); }
+    template< unsigned... I > static constexpr tFixedTable_< DataType, sizeof...(I) > table( tFixedIndices_<I...> ) { return {{ entry( I )... }}; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definitions
+
+/** Template class for a table of 'N' values with 'OutQ' qbits, of the function given by
+    'Generator' of an input with 'InQ' qbits **/
+template< int InQ, int OutQ, unsigned N, typename Generator, typename DataType = int >
+class tFixedLut
+{
+public:
+    typedef tFixedPoint< InQ, DataType >   tInput;
+    typedef tFixedPoint< OutQ, DataType >  tOutput;
+
+    /** The spacing of the entries in LSBs of the input is 2^cShift **/
+    static const int cShift = InQ + Generator::cLog2Step;
+
+    static_assert( N >= 2, "a tFixedLut needs at least two entries" );
+    static_assert( cShift >= 1 && cShift <= 30, "the entries of a tFixedLut must be between 2 and 2^30 LSBs of the input apart" );
+    static_assert( sizeof(DataType) <= sizeof(int), "tFixedLut only supports data-types of 32 bits or less" );
+
+    typedef tFixedTable_< DataType, N + 1 > tTable;
+    static constexpr tTable cTable = tFixedLutTable_< InQ, OutQ, N, cShift, Generator, DataType >::table( typename tFixedMakeIndices_< N + 1 >::type() );
+
+    /** Returns the value for the input 'x', interpolated between the entries either side **/
+    static tOutput lookup( const tInput& x ) {
+        const long long offset = tFixedLut_::offset( x.qValue(), cFirst_, cLast_ );
+        const unsigned index = unsigned( offset >> cShift );
+        const long long y0 = cTable[index];
+        const long long y1 = cTable[index + 1];
+        return tOutput::create( DataType( y0 + tFixedPointCheck_::round< cShift >( (y1 - y0) * (offset & cMask_) ) ) );
+    }
+
+    tOutput operator()( const tInput& x ) const { return lookup( x ); }
+
+    /** Returns the entry 'index' of the table **/
+    static tOutput entry( unsigned index ) { return tOutput::create( cTable[index] ); }
+
+private:
+    static constexpr long long cFirst_ = tFixedLut_::first( Generator::cFirst, InQ );
+    static constexpr long long cLast_ = (long long)( N - 1 ) << cShift;
+    static constexpr long long cMask_ = (1ll << cShift) - 1;
+};
+
+template< int InQ, int OutQ, unsigned N, typename Generator, typename DataType >
+constexpr typename tFixedLut< InQ, OutQ, N, Generator, DataType >::tTable tFixedLut< InQ, OutQ, N, Generator, DataType >::cTable;
+
+
+/** Template class for a grid of 'NX' by 'NY' values with 'OutQ' qbits, of the function given by
+    'Generator' of inputs with 'InQX' and 'InQY' qbits **/
+template< int InQX, int InQY, int OutQ, unsigned NX, unsigned NY, typename Generator, typename DataType = int >
+class tFixedLut2
+{
+public:
+    typedef tFixedPoint< InQX, DataType >  tInputX;
+    typedef tFixedPoint< InQY, DataType >  tInputY;
+    typedef tFixedPoint< OutQ, DataType >  tOutput;
+
+    static const int cShiftX = InQX + Generator::cLog2StepX;
+    static const int cShiftY = InQY + Generator::cLog2StepY;
+
+    static_assert( NX >= 2 && NY >= 2, "a tFixedLut2 needs at least two entries each way" );
+    static_assert( cShiftX >= 1 && cShiftY >= 1, "the entries of a tFixedLut2 must be at least 2 LSBs of the inputs apart" );
+    static_assert( cShiftX + cShiftY <= 30, "the interpolation of a tFixedLut2 must fit in 64 bits" );
+    static_assert( sizeof(DataType) <= sizeof(int), "tFixedLut2 only supports data-types of 32 bits or less" );
+
+    typedef tFixedTable_< DataType, (NX + 1)*(NY + 1) > tTable;
+    static constexpr tTable cTable =
+        tFixedLut2Table_< InQX, InQY, OutQ, NX, NY, cShiftX, cShiftY, Generator, DataType >::table( typename tFixedMakeIndices_< (NX + 1)*(NY + 1) >::type() );
+
+    /** Returns the value for the inputs 'x' and 'y', interpolated between the four entries
+        around them **/
+    static tOutput lookup( const tInputX& x, const tInputY& y ) {
+        const long long offsetX = tFixedLut_::offset( x.qValue(), cFirstX_, cLastX_ );
+        const long long offsetY = tFixedLut_::offset( y.qValue(), cFirstY_, cLastY_ );
+        const long long fx = offsetX & cMaskX_;
+        const unsigned k = unsigned( offsetY >> cShiftY )*(NX + 1) + unsigned( offsetX >> cShiftX );
+
+        // interpolate along each row at full precision, then between the rows, and round once
+        const long long r0 = FIXEDPOINT_IMPL_SHIFTUP( (long long)( cTable[k] ), cShiftX ) + ((long long)( cTable[k + 1] ) - cTable[k]) * fx;
+        const long long r1 = FIXEDPOINT_IMPL_SHIFTUP( (long long)( cTable[k + NX + 1] ), cShiftX ) + ((long long)( cTable[k + NX + 2] ) - cTable[k + NX + 1]) * fx;
+        const long long v = FIXEDPOINT_IMPL_SHIFTUP( r0, cShiftY ) + (r1 - r0) * (offsetY & cMaskY_);
+        return tOutput::create( DataType( tFixedPointCheck_::round< cShiftX + cShiftY >( v ) ) );
+    }
+
+    tOutput operator()( const tInputX& x, const tInputY& y ) const { return lookup( x, y ); }
+
+    /** Returns the entry for the 'i'th x and 'j'th y **/
+    static tOutput entry( unsigned i, unsigned j ) { return tOutput::create( cTable[j*(NX + 1) + i] ); }
+
+private:
+    static constexpr long long cFirstX_ = tFixedLut_::first( Generator::cFirstX, InQX );
+    static constexpr long long cFirstY_ = tFixedLut_::first( Generator::cFirstY, InQY );
+    static constexpr long long cLastX_ = (long long)( NX - 1 ) << cShiftX;
+    static constexpr long long cLastY_ = (long long)( NY - 1 ) << cShiftY;
+    static constexpr long long cMaskX_ = (1ll << cShiftX) - 1;
+    static constexpr long long cMaskY_ = (1ll << cShiftY) - 1;
+};
+
+template< int InQX, int InQY, int OutQ, unsigned NX, unsigned NY, typename Generator, typename DataType >
+constexpr typename tFixedLut2< InQX, InQY, OutQ, NX, NY, Generator, DataType >::tTable tFixedLut2< InQX, InQY, OutQ, NX, NY, Generator, DataType >::cTable;
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
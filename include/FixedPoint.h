@@ -28,6 +28,15 @@
 #ifndef FIXEDPOINT_H
 #define FIXEDPOINT_H
 
+#if __cplusplus < 201103L
+#   error "FixedPoint.h requires C++11 support"
+#endif
+
+#include "FixedPointTarget.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 
 /**************************************************************************************************
                           Fixed-Point Arithmetic Template Class
@@ -53,6 +62,26 @@ problems with managing fixed-point number, namely ensuring values don't overflow
 careful consideration should be given to maximum range values can take, and how various operations
 will effect this.
 
+The one exception is multiplication, where the intermediate product of the "*=" operators is held
+in a double-width type (see tFixedPointTraits) before being rounded back down, so a Q16 value
+multiplied by another Q16 value only overflows if the final result doesn't fit. The "multipliedBy"
+methods can be used to get at the full double-width product directly.
+
+Rounding is done by a policy class, see "Rounding Policies" below. The operators ("*=", "/" and
+the double conversions) and the "roundedTo" methods use the FIXEDPOINT_ROUNDING policy, which by
+default rounds to the nearest value. "roundedTo" (and the "rounded" conversion from a double) also
+take the policy as an optional template argument, and tRoundedFixedPoint (see RoundedFixedPoint.h)
+gives a type whose operators all use a particular policy, for instance to truncate in a fast
+control loop while an estimator in the same file rounds halves to even,
+
+    a8 = c12.roundedTo< 8, int, tRoundHalfEven >();
+    typedef tRoundedFixedPoint< 16, tRoundTruncate > tFastQ16;
+
+To help find where values overflow in practice, defining FIXEDPOINT_ENABLE_INSTRUMENTATION makes the
+operations count wraps, saturations and rounding losses at run-time, see FixedPointInstrument.h.
+The accuracy of code can also be checked against floating-point by using tShadowFixedPoint (see
+ShadowFixedPoint.h) in place of tFixedPoint.
+
 
 As a general philosophy this implementation requires the user to explicitly handle any operations
 that would require a reduction in the precision of an argument. This means that given,
@@ -98,18 +127,28 @@ if its a constant as in this case by making sure it has the correct type.
 
     tUQ8 u8 = 3u;
     
+
+All constructors, conversions and non-assigning operators are constexpr, so constants can be
+declared as constexpr values (or tables) that are guaranteed to be evaluated at compile-time, for
+instance using the predefined user-defined literals,
+
+    constexpr tQ8 cGains[] = { 1.25_q8, -0.5_q8, FIXEDPOINT_CONSTANT( tQ8, 2,75 ) };
+
+Note this requires C++11.
+
+A tFixedPoint is trivially copyable and has exactly the size, alignment and layout of its tValue,
+so arrays of them can be copied with memcpy or DMA, and they are passed to (and returned from)
+functions in registers on ABIs such as the ARM AAPCS. For the same reason the operators and
+helpers take their fixed-point arguments by value rather than by reference.
+
 ***************************************************************************************************
 
 TODO:
-  - full run-time test-bench to make sure the implementation actually works as required.
   - ensure compiled code is as good as an explicit manual implementation, especially WRT parameter
-    passing.
+    passing (src/FixedPoint_codegen.sh checks this, and src/FixedPoint_bench.cpp times it).
   - better documentation.
   - improved compile-time checking (possibly including the automatic handling of some loss of 
-    precision cases).
-  - a debug version that provides runtime checks for over/underflows.
-  - possibly a floating-point based version for validating and checking the accuracy of their usage
-    in an application.
+    precision cases, which FixedExpression.h does for whole expressions).
     
 ***************************************************************************************************/
 
@@ -117,9 +156,12 @@ TODO:
 //-------------------------------------------------------------------------------------------------
 // Support Macros
 
-/** This macro is used to enable all methods and functions that provide support for the standard
-    floating-point double type **/
-#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT        
+/** Defining this macro (before including FixedPoint.h, normally on the compiler command line)
+    enables all methods and functions that provide support for the standard floating-point double
+    type. It isn't defined by default, as on targets without a double-precision FPU the conversions
+    pull in the soft-float library. The single-precision "toFloat" and "fromFloat" conversions are
+    always available, as they don't need it (see "Floating Point" below) **/
+// #define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
 
 
 /** These macros are designed to allow you to specify constants in a similar way to how you would
@@ -138,17 +180,421 @@ TODO:
 #define FIXEDPOINT_CONSTANTQ( qbits, dec,frac )  FIXEDPOINT_CONSTANT( tFixedPoint<qbits>, dec,frac )
 
 
-/** This macro lets you control the implementation used for division. Currently it rounds towards
-    +ve infinity, but you may prefer to just truncate or improve it to round away from 0 instead **/
-#define FIXEDPOINT_IMPL_DIVIDE( dividend, divisor )  (((dividend) + ((divisor) >> 1)) / (divisor))
+/** This macro lets you control the implementation of division used by the default tRoundNearest
+    policy. Currently it rounds to the nearest value with halves rounded away from 0 (whatever the
+    signs of the 'dividend' and 'divisor'). To truncate instead use the tRoundTruncate policy **/
+#define FIXEDPOINT_IMPL_DIVIDE( dividend, divisor )  \
+    ((((dividend) < 0) == ((divisor) < 0))? (((dividend) + (divisor)/2) / (divisor)) : (((dividend) - (divisor)/2) / (divisor)))
 
-/** This macro lets you control the implementation used for rounding. Currently it rounds towards
-    +ve infinity, but you may prefer something else such as to round away from 0 instead. It should
-    not be changed to just truncate because separate methods are provided for this.
+/** This macro lets you control the implementation of rounding used by the default tRoundNearest
+    policy. Currently it rounds halves towards +ve infinity. It should not be changed to just
+    truncate because separate methods (and the tRoundTruncate policy) are provided for this.
         A macro was used to implement this to make it more likely the compiler would produce an
-    error or warning when 'byQBits' is incorrectly negative. Also note that this macro does not
-    cover the rounding used for floating-point types **/
-#define FIXEDPOINT_IMPL_ROUND( value, byQBits )  (((value) + (1 << ((byQBits)-1))) >> (byQBits))
+    error or warning when 'byQBits' is incorrectly negative. A 'byQBits' of 0 leaves the value
+    unchanged. Also note that this macro does not cover the rounding used for floating-point types **/
+#define FIXEDPOINT_IMPL_ROUND( value, byQBits )  (((value) + (((0*(value) + 1) << (byQBits)) >> 1)) >> (byQBits))
+
+/** This macro selects the rounding policy used by the operators and the "roundedTo" methods when
+    no other policy is given, see "Rounding Policies" below **/
+#ifndef FIXEDPOINT_ROUNDING
+#define FIXEDPOINT_ROUNDING  tRoundNearest
+#endif
+
+/** This macro is used to increase the precision of a value by 'byQBits'. It multiplies rather than
+    shifts because left shifting a negative value isn't allowed in a constant expression (before
+    C++20), compilers will still produce a shift. As above a macro is used so that the compiler
+    can warn about 'byQBits' being negative **/
+#define FIXEDPOINT_IMPL_SHIFTUP( value, byQBits )  ((value) * ((0*(value) + 1) << (byQBits)))
+
+/** Defining this macro enables run-time counters for wraps, saturations and rounding losses in
+    fixed-point operations, see FixedPointInstrument.h. When it isn't defined the macros below
+    expand to nothing, or just their result, so there is no cost at all **/
+#ifdef FIXEDPOINT_ENABLE_INSTRUMENTATION
+#   include "FixedPointInstrument.h"
+#else
+#   define FIXEDPOINT_SITE()
+#   define FIXEDPOINT_IMPL_RECORD( qbits, type, event, condition, ... )  (__VA_ARGS__)
+#endif
+
+/** Defining this macro enables the scoped stage timers, which also time the library's own
+    kernels, see FixedPointProfile.h. When it isn't defined the macros below expand to nothing **/
+#ifdef FIXEDPOINT_ENABLE_PROFILING
+#   include "FixedPointProfile.h"
+#else
+#   define FIXEDPOINT_PROFILE( name )
+#   define FIXEDPOINT_PROFILE_BUDGET( name, budget )
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Data-Type Traits
+
+/** This template records the properties of the underlying data-types a fixed-point value can be
+    stored in,
+
+        tWide       the double-width type used to hold intermediate products so that multiplying
+                    two values (which needs the sum of their bits) can't silently wrap before the
+                    result is rounded back down. eg. for an int this is a long long, which the
+                    compiler can produce using a single 32x32->64 instruction such as SMULL on ARM.
+        tCompute    the type the summed-Q products of "operator*" are returned in, which is the
+                    native register width for types narrower than an int. So values stored in 16
+                    bits (to halve the RAM used by buffers and tables, see PackedFixedPoint.h)
+                    give 32-bit products rather than 16-bit ones that overflow immediately.
+
+        For targets where a double-width multiply is expensive (eg. a library call on Cortex-M0)
+    this template can be specialised to make 'tWide' the same type as 'DataType', which gives back
+    the old non-widening behaviour **/
+template< typename DataType > struct tFixedPointTraits                     { typedef DataType tWide;            typedef DataType tCompute; };
+template<> struct tFixedPointTraits< signed char >                         { typedef short tWide;               typedef int tCompute; };
+template<> struct tFixedPointTraits< unsigned char >                       { typedef unsigned short tWide;      typedef unsigned tCompute; };
+template<> struct tFixedPointTraits< short >                               { typedef int tWide;                 typedef int tCompute; };
+template<> struct tFixedPointTraits< unsigned short >                      { typedef unsigned tWide;            typedef unsigned tCompute; };
+template<> struct tFixedPointTraits< int >                                 { typedef long long tWide;           typedef int tCompute; };
+template<> struct tFixedPointTraits< unsigned >                            { typedef unsigned long long tWide;  typedef unsigned tCompute; };
+template<> struct tFixedPointTraits< long >                                { typedef long long tWide;           typedef long tCompute; };
+template<> struct tFixedPointTraits< unsigned long >                       { typedef unsigned long long tWide;  typedef unsigned long tCompute; };
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** The rounding policies, which are defined below **/
+struct tRoundNearest;
+struct tRoundTruncate;
+struct tRoundHalfUp;
+struct tRoundHalfEven;
+struct tRoundHalfAway;
+struct tRoundStochastic;
+
+/** Conversions between raw fixed-point values with 'QBits' qbits and single-precision floats.
+    The float is rounded to the nearest value (halves to even) when it can't hold the value
+    exactly, and a float is converted to a value by truncating towards 0, saturating if it is out
+    of range, and giving 0 for a NaN - which is exactly what the VCVT fixed-point conversion
+    instructions do. Those can be used on 32-bit Arm targets with a single-precision FPU (one
+    instruction for any number of qbits from 1 to 32) if FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS is
+    defined (see FixedPointTarget.h), the compiler's own conversions are used for hosts, and
+    elsewhere the conversions only use integer operations on the bits of the float, so they need
+    no floating-point support at all **/
+struct tFixedPointFloat_
+{
+    static unsigned bits( float value ) { unsigned b; std::memcpy( &b, &value, sizeof(b) ); return b; }
+    static float fromBits( unsigned b ) { float f; std::memcpy( &f, &b, sizeof(f) ); return f; }
+
+    /** Returns the number of leading zeros in a non-zero 'value' **/
+    static int leadingZeros( unsigned value ) {
+#       if defined(__GNUC__)
+        return __builtin_clz( value );
+#       else
+        int n = 0;
+        while (!(value & 0x80000000u)) { value <<= 1; ++n; }
+        return n;
+#       endif
+    }
+    static int leadingZeros( unsigned long long value )
+        { return (value >> 32)? leadingZeros( unsigned( value >> 32 ) ) : 32 + leadingZeros( unsigned( value ) ); }
+
+    /** Returns the float nearest to 'magnitude' * 2^-qBits, with the sign given. Results below
+        2^-126 (only possible with over 100 qbits) are flushed to 0 **/
+    template< typename Unsigned > static float toFloat( Unsigned magnitude, bool negative, int qBits ) {
+        const unsigned sign = negative? 0x80000000u : 0;
+        if (magnitude == 0) return fromBits( sign );
+        int top = int( sizeof(Unsigned)*8 ) - 1 - leadingZeros( magnitude );
+        if (top > 23) {
+            const int shift = top - 23;
+            const Unsigned rest = magnitude & ((Unsigned( 1 ) << shift) - 1);
+            const Unsigned half = Unsigned( 1 ) << (shift - 1);
+            magnitude >>= shift;
+            if (rest > half || (rest == half && (magnitude & 1))) ++magnitude;
+            if (magnitude >> 24) { magnitude >>= 1; ++top; }
+        } else {
+            magnitude <<= 23 - top;
+        }
+        const int exponent = top - qBits + 127;
+        if (exponent >= 255) return fromBits( sign | 0x7F800000u );
+        if (exponent <= 0) return fromBits( sign );
+        return fromBits( sign | (unsigned( exponent ) << 23) | (unsigned( magnitude ) & 0x7FFFFFu) );
+    }
+
+    /** Returns the float 'value' * 2^qBits converted to DataType as described above **/
+    template< typename DataType > static DataType fromFloat( float value, int qBits ) {
+        typedef std::numeric_limits<DataType> tLimits;
+        const unsigned b = bits( value );
+        const bool negative = (b >> 31) != 0;
+        const int exponent = int( (b >> 23) & 0xFF );
+        const unsigned long long mantissa = (exponent == 0)? (b & 0x7FFFFFu) : (b & 0x7FFFFFu) | 0x800000u;
+        if (exponent == 0xFF && (b & 0x7FFFFFu) != 0) return 0;
+        if (negative && !tLimits::is_signed) return 0;
+
+        // the magnitude is mantissa * 2^shift, which is saturated to the limit of the sign given
+        const int shift = ((exponent == 0)? 1 : exponent) - 150 + qBits;
+        const unsigned long long limit = (unsigned long long)( tLimits::max() ) + (negative? 1 : 0);
+        unsigned long long magnitude = (exponent == 0xFF || shift > 40)? limit : (shift >= 0)? (mantissa << shift) : (shift > -64)? (mantissa >> -shift) : 0;
+        if (magnitude > limit) magnitude = limit;
+        return negative? DataType( 0ull - magnitude ) : DataType( magnitude );
+    }
+
+    /** Returns 2^n, which is exact **/
+    static constexpr float power( int n ) { return (n == 0)? 1.0f : (n > 0)? 2.0f*power( n - 1 ) : 0.5f*power( n + 1 ); }
+
+    /** Return the conversions for a value with 'QBits' qbits and DataType **/
+    template< int QBits, typename DataType > static float toFloat( DataType value ) {
+        typedef typename std::conditional< (sizeof(DataType) <= sizeof(unsigned)), unsigned, unsigned long long >::type tUnsigned;
+#       if defined(FIXEDPOINT_TARGET_VFP)
+        if (sizeof(DataType) <= sizeof(int) && QBits >= 0 && QBits <= 32) return vfpToFloat< QBits, std::numeric_limits<DataType>::is_signed >( (unsigned)( value ) );
+#       elif defined(FIXEDPOINT_TARGET_HOSTFPU)
+        return float( value ) * power( -QBits );
+#       endif
+        const bool negative = value < 0;
+        return toFloat( negative? tUnsigned( 0 ) - tUnsigned( value ) : tUnsigned( value ), negative, QBits );
+    }
+
+    template< int QBits, typename DataType > static DataType fromFloat( float value ) {
+#       if defined(FIXEDPOINT_TARGET_VFP)
+        if (sizeof(DataType) <= sizeof(int) && QBits >= 0 && QBits <= 32) return vfpFromFloat< QBits, DataType >( value );
+#       elif defined(FIXEDPOINT_TARGET_HOSTFPU)
+        typedef std::numeric_limits<DataType> tLimits;
+        const float scaled = value * power( QBits );
+        const float max = power( tLimits::digits );         // one more than the largest value
+        if (!(scaled == scaled)) return 0;
+        if (scaled >= max) return tLimits::max();
+        if (tLimits::is_signed? (scaled <= -max) : (scaled <= -1.0f)) return tLimits::min();
+        return DataType( scaled );
+#       endif
+        return fromFloat< DataType >( value, QBits );
+    }
+
+#   if defined(FIXEDPOINT_TARGET_VFP)
+    /** The VCVT instructions, the fixed-point forms of which take 1 to 32 qbits **/
+    template< int QBits, bool Signed > static float vfpToFloat( unsigned value ) {
+        if (QBits == 0) return Signed? float( int( value ) ) : float( value );
+        float f = fromBits( value );
+        if (Signed) __asm__( "vcvt.f32.s32 %0, %0, %1" : "+t"( f ) : "i"( (QBits > 0)? QBits : 1 ) );
+        else        __asm__( "vcvt.f32.u32 %0, %0, %1" : "+t"( f ) : "i"( (QBits > 0)? QBits : 1 ) );
+        return f;
+    }
+    template< int QBits, typename DataType > static DataType vfpFromFloat( float f ) {
+        typedef std::numeric_limits<DataType> tLimits;
+        if (tLimits::is_signed) {
+            if (QBits == 0) __asm__( "vcvt.s32.f32 %0, %0" : "+t"( f ) );
+            else            __asm__( "vcvt.s32.f32 %0, %0, %1" : "+t"( f ) : "i"( (QBits > 0)? QBits : 1 ) );
+            const int v = int( bits( f ) );
+            return (v > int( tLimits::max() ))? tLimits::max() : (v < int( tLimits::min() ))? tLimits::min() : DataType( v );
+        } else {
+            if (QBits == 0) __asm__( "vcvt.u32.f32 %0, %0" : "+t"( f ) );
+            else            __asm__( "vcvt.u32.f32 %0, %0, %1" : "+t"( f ) : "i"( (QBits > 0)? QBits : 1 ) );
+            const unsigned v = bits( f );
+            return (v > unsigned( tLimits::max() ))? tLimits::max() : DataType( v );
+        }
+    }
+#   endif
+};
+
+/** Helpers used to convert the results of fixed-point operations, which also record any wraps and
+    rounding losses when instrumentation is enabled (see FIXEDPOINT_IMPL_RECORD). Results are
+    calculated in a type wide enough to detect a wrap where that costs nothing, and the compiler
+    throws the unused upper bits away when instrumentation is disabled **/
+struct tFixedPointCheck_
+{
+    /** Used to keep the integer overloads of the operators from taking floating-point values **/
+    template< typename T > struct tNotFloat : std::enable_if< !std::is_floating_point<T>::value > {};
+
+    /** Returns true if 'value' doesn't fit in DataType **/
+    template< typename DataType, typename T > static constexpr bool wraps( T value ) { return T( DataType( value ) ) != value; }
+
+    /** Returns 'value' converted to DataType, the type of a fixed-point value with 'QBits' qbits **/
+    template< int QBits, typename DataType, typename T > static constexpr DataType wrapped( T value )
+        { return FIXEDPOINT_IMPL_RECORD( QBits, DataType, cFixedPointWrap, wraps<DataType>( value ), DataType( value ) ); }
+
+    /** Returns 'value' shifted up by 'ByQBits' and converted to DataType as above **/
+    template< int QBits, typename DataType, int ByQBits, typename T > static constexpr DataType shifted( T value )
+        { return wrapped< QBits, DataType >( FIXEDPOINT_IMPL_SHIFTUP( typename tFixedPointTraits<DataType>::tWide( value ), ByQBits ) ); }
+
+    /** Returns 'value' unchanged, but first records a rounding loss if any of the bottom 'ByQBits'
+        bits that are about to be discarded are set **/
+    template< int QBits, typename DataType, int ByQBits, typename T > static constexpr T lost( T value )
+        { return FIXEDPOINT_IMPL_RECORD( QBits, DataType, cFixedPointRoundingLoss, (ByQBits > 0) && ((value & ((T(1) << (ByQBits > 0? ByQBits : 0)) - 1)) != 0), value ); }
+
+    /** Returns 'value' reduced by 'ByQBits' using the 'Rounding' policy **/
+    template< int ByQBits, typename Rounding = FIXEDPOINT_ROUNDING, typename T > static constexpr T round( T value )
+        { return Rounding::template shift< ByQBits >( value ); }
+
+    /** As above, but first records a rounding loss in the same way as "lost" **/
+    template< int QBits, typename DataType, int ByQBits, typename Rounding = FIXEDPOINT_ROUNDING, typename T > static constexpr T rounded( T value )
+        { return round< ByQBits, Rounding >( lost< QBits, DataType, ByQBits >( value ) ); }
+
+    /** Returns 'dividend' divided by 'divisor' using the 'Rounding' policy **/
+    template< typename Rounding = FIXEDPOINT_ROUNDING, typename T > static constexpr T divide( T dividend, T divisor )
+        { return Rounding::divide( dividend, divisor ); }
+
+    /** Returns how the remainder 'r' of a truncating division by 'divisor' compares with half of
+        the divisor, as -1 below it, 0 at it or 1 above it **/
+    template< typename T > static constexpr int half( T r, T divisor )
+        { return half_( (r < 0)? T( -r ) : r, (divisor < 0)? T( -divisor ) : divisor ); }
+    template< typename T > static constexpr int half_( T r, T divisor ) { return (r < divisor - r)? -1 : (r == divisor - r)? 0 : 1; }
+
+    /** Returns the direction a truncated quotient moves in to round it away from 0 **/
+    template< typename T > static constexpr T away( T dividend, T divisor ) { return ((dividend < 0) == (divisor < 0))? T( 1 ) : T( -1 ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    /** Returns 'value' converted to DataType, recording a wrap if it is out of range **/
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return FIXEDPOINT_IMPL_RECORD( QBits, DataType, cFixedPointWrap,
+                  (value >= 2.0*(double( std::numeric_limits<DataType>::max()/2 + 1 ))) || (value < double( std::numeric_limits<DataType>::min() )), DataType( value ) ); }
+
+    /** Returns the largest DataType not above 'value', as above **/
+    template< int QBits, typename DataType > static constexpr DataType floored( double value )
+        { return floored_( value, converted< QBits, DataType >( value ) ); }
+    template< typename DataType > static constexpr DataType floored_( double value, DataType truncated )
+        { return (double( truncated ) > value)? DataType( truncated - 1 ) : truncated; }
+#   endif
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Rounding Policies
+
+/** A rounding policy provides the three ways precision is lost,
+
+        shift< ByQBits >( value )       reduces the qbits of 'value' by 'ByQBits' (which may be 0).
+        divide( dividend, divisor )     divides two values of the same type.
+        converted< QBits, DataType >( value )
+                                        converts a double, already scaled by 2^QBits, to DataType.
+
+    'tRoundNearest' is the default (see FIXEDPOINT_ROUNDING), it is the original behaviour of the
+    library and uses the FIXEDPOINT_IMPL_ROUND and FIXEDPOINT_IMPL_DIVIDE macros. The others are,
+
+        tRoundTruncate      shifts round towards -ve infinity, divisions and conversions towards 0 - so
+                            each is the single instruction the hardware provides, and the cheapest.
+        tRoundHalfUp        rounds to the nearest, with halves towards +ve infinity.
+        tRoundHalfEven      rounds to the nearest, with halves to the even value, so that there is
+                            no bias on average (eg. in long running estimators and filters).
+        tRoundHalfAway      rounds to the nearest, with halves away from 0.
+        tRoundStochastic    rounds up with a probability equal to the fraction lost, so the errors
+                            average out to 0 like a dither. It uses a shared pseudo-random sequence,
+                            so concurrent use from interrupts just gives different dither.
+
+    Divisions other than by tRoundTruncate need the remainder, which compilers get from the same
+    divide (or a multiply and subtract) **/
+struct tRoundNearest
+{
+    template< int ByQBits, typename T > static constexpr T shift( T value ) { return FIXEDPOINT_IMPL_ROUND( value, ByQBits ); }
+    template< typename T > static constexpr T divide( T dividend, T divisor ) { return FIXEDPOINT_IMPL_DIVIDE( dividend, divisor ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return tFixedPointCheck_::floored< QBits, DataType >( value + 0.5 ); }
+#   endif
+};
+
+struct tRoundTruncate
+{
+    template< int ByQBits, typename T > static constexpr T shift( T value ) { return value >> ByQBits; }
+    template< typename T > static constexpr T divide( T dividend, T divisor ) { return dividend / divisor; }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return tFixedPointCheck_::converted< QBits, DataType >( value ); }
+#   endif
+};
+
+struct tRoundHalfUp
+{
+    template< int ByQBits, typename T > static constexpr T shift( T value ) { return FIXEDPOINT_IMPL_ROUND( value, ByQBits ); }
+    template< typename T > static constexpr T divide( T dividend, T divisor )
+        { return divided_( dividend / divisor, dividend, divisor, tFixedPointCheck_::half( T( dividend % divisor ), divisor ) ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return tFixedPointCheck_::floored< QBits, DataType >( value + 0.5 ); }
+#   endif
+
+private:
+    /** Adjusts a truncated quotient 'q', given how its remainder compares with a half **/
+    template< typename T > static constexpr T divided_( T q, T dividend, T divisor, int half )
+        { return ((half > 0) || (half == 0 && tFixedPointCheck_::away( dividend, divisor ) > 0))? T( q + tFixedPointCheck_::away( dividend, divisor ) ) : q; }
+};
+
+struct tRoundHalfEven
+{
+    template< int ByQBits, typename T > static constexpr T shift( T value )
+        { return (ByQBits == 0)? value : T( (value + ((T(1) << (ByQBits > 0? ByQBits - 1 : 0)) - 1) + ((value >> ByQBits) & 1)) >> ByQBits ); }
+    template< typename T > static constexpr T divide( T dividend, T divisor )
+        { return divided_( dividend / divisor, dividend, divisor, tFixedPointCheck_::half( T( dividend % divisor ), divisor ) ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return even_( value, tFixedPointCheck_::floored< QBits, DataType >( value + 0.5 ) ); }
+#   endif
+
+private:
+    template< typename T > static constexpr T divided_( T q, T dividend, T divisor, int half )
+        { return ((half > 0) || (half == 0 && (q & 1) != 0))? T( q + tFixedPointCheck_::away( dividend, divisor ) ) : q; }
+
+    /** Moves a value 'nearest' that was rounded up from exactly a half back down if it is odd **/
+    template< typename DataType > static constexpr DataType even_( double value, DataType nearest )
+        { return (double( nearest ) - value == 0.5 && (nearest & 1) != 0)? DataType( nearest - 1 ) : nearest; }
+};
+
+struct tRoundHalfAway
+{
+    template< int ByQBits, typename T > static constexpr T shift( T value )
+        { return (ByQBits == 0)? value : T( (value + (T(1) << (ByQBits > 0? ByQBits - 1 : 0)) - T( value < 0 )) >> ByQBits ); }
+    template< typename T > static constexpr T divide( T dividend, T divisor )
+        { return (tFixedPointCheck_::half( T( dividend % divisor ), divisor ) >= 0)? T( dividend / divisor + tFixedPointCheck_::away( dividend, divisor ) ) : T( dividend / divisor ); }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static constexpr DataType converted( double value )
+        { return tFixedPointCheck_::converted< QBits, DataType >( (value < 0)? value - 0.5 : value + 0.5 ); }
+#   endif
+};
+
+template< int Unused = 0 > struct tRoundStochasticState_
+{
+    static unsigned long long seed;
+
+    /** Returns the next value of a xorshift pseudo-random sequence **/
+    static unsigned long long next() { seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; return seed; }
+};
+
+template< int Unused > unsigned long long tRoundStochasticState_< Unused >::seed = 0x2545F4914F6CDD1Dull;
+
+struct tRoundStochastic
+{
+    /** Sets the start of the pseudo-random sequence, eg. for repeatable simulations **/
+    static void seed( unsigned long long value ) { tRoundStochasticState_<>::seed = (value != 0)? value : 1; }
+
+    template< int ByQBits, typename T > static T shift( T value )
+        { return (ByQBits == 0)? value : T( (value + T( tRoundStochasticState_<>::next() >> (64 - (ByQBits > 0? ByQBits : 64)) )) >> ByQBits ); }
+    template< typename T > static T divide( T dividend, T divisor ) {
+        const T r = dividend % divisor;
+        const unsigned long long fraction = (unsigned long long)( (r < 0)? T( -r ) : r );
+        const unsigned long long range = (unsigned long long)( (divisor < 0)? T( -divisor ) : divisor );
+        return (fraction > tRoundStochasticState_<>::next() % range)? T( dividend / divisor + tFixedPointCheck_::away( dividend, divisor ) ) : T( dividend / divisor );
+    }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    template< int QBits, typename DataType > static DataType converted( double value )
+        { return tFixedPointCheck_::floored< QBits, DataType >( value + double( tRoundStochasticState_<>::next() >> 11 ) / 9007199254740992.0 ); }
+#   endif
+};
+
+
+/** Powers of 10 for decimal conversions, the unused template parameter allows the table to be
+    defined in this header **/
+template< int Unused = 0 > struct tFixedPointDecimal_
+{
+    static const unsigned cMaxDecimals = 19;
+    static const unsigned long long cPowers[cMaxDecimals + 1];
+
+    /** Returns 10 to the power of 'decimals', which must be no more than cMaxDecimals **/
+    static unsigned long long power( unsigned decimals ) { return cPowers[decimals]; }
+};
+
+template< int Unused > const unsigned long long tFixedPointDecimal_< Unused >::cPowers[cMaxDecimals + 1] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull };
 
 
 //-------------------------------------------------------------------------------------------------
@@ -167,6 +613,13 @@ public:
         fractional parts) **/
     typedef DataType tValue;
 
+    /** Records the double-width type used to hold intermediate products before they are rounded
+        back down to a tValue (see tFixedPointTraits) **/
+    typedef typename tFixedPointTraits<DataType>::tWide tWide;
+
+    /** Records the type the summed-Q products are returned in (see tFixedPointTraits) **/
+    typedef typename tFixedPointTraits<DataType>::tCompute tCompute;
+
     //---------------------------------------------------------------------------------------------
     // Construction
 
@@ -175,29 +628,37 @@ public:
         you would provide a 'qValue' of 20. 
             This is mainly provided for internal use by this class, but may be useful for 
         implementing extended fixed-point functionality externally **/
-    static tFixedPoint create( tValue qValue ) { return tFixedPoint( qValue, QBits ); }
+    static constexpr tFixedPoint create( tValue qValue ) {
+        static_assert( sizeof(tFixedPoint) == sizeof(tValue) && alignof(tFixedPoint) == alignof(tValue), "a tFixedPoint must have the layout of its tValue" );
+        static_assert( std::is_trivially_copyable<tFixedPoint>::value && std::is_standard_layout<tFixedPoint>::value, "a tFixedPoint must be trivially copyable" );
+        return tFixedPoint( qValue, QBits );
+    }
     
-    tFixedPoint() : value_() {}
-    tFixedPoint( const tFixedPoint& value ) : value_( value.value_ ) {}
+    constexpr tFixedPoint() : value_() {}
+
+    /** The copy operations are the compiler's own, so a tFixedPoint is trivially copyable and is
+        passed and returned in a register, the same as its tValue **/
+    constexpr tFixedPoint( const tFixedPoint& ) = default;
     
     /** Constructs a fixed-point value from a variable or constant of the same underlying tValue
         type. The 'value' provided is assumed to have no/0 qbits and will be adjusted appropriately **/
-    tFixedPoint( tValue value ) : value_( value << QBits ) {}
+    constexpr tFixedPoint( tValue value ) : value_( tFixedPointCheck_::shifted< QBits, DataType, QBits >( value ) ) {}
 
     /** Constructs a fixed-point value from a variable or constant that already has some 'qBits'
         incorporated in it. The 'qValue' must be of equal or lower precision than this class (ie.
         'qBits' <= cQBits) or an invalid value may be constructed - normally resulting in a
         compiler warning or error, probably about a negative shift count **/
-    tFixedPoint( tValue qValue, unsigned qBits ) : value_( qValue << (QBits - int(qBits)) ) {}
+    constexpr tFixedPoint( tValue qValue, unsigned qBits )
+        : value_( tFixedPointCheck_::wrapped< QBits, DataType >( FIXEDPOINT_IMPL_SHIFTUP( tWide(qValue), QBits - int(qBits) ) ) ) {}
     
     /** Constructs a fixed-point value from separate integer 'intPart' and fractional 'absFracPart'
         values. This is mainly intended for use by the FIXEDPOINT_CONSTANT macros, so the
         'absFracPart' must be unsigned and the sign of the 'intPart' will used to determine what
         its sign should be. eg. "tFixedPoint<4>( -1, 4, 4 ) would produce a value equivalent to
         -1.25 **/
-    tFixedPoint( tValue intPart, tValue absFracPart, unsigned qFracBits )
-        : value_( (intPart >= 0)? ((intPart << QBits)+(absFracPart << (QBits - int(qFracBits)))) 
-                                : ((intPart << QBits)-(absFracPart << (QBits - int(qFracBits)))) ) {}
+    constexpr tFixedPoint( tValue intPart, tValue absFracPart, unsigned qFracBits )
+        : value_( (intPart >= 0)? (FIXEDPOINT_IMPL_SHIFTUP( intPart, QBits ) + FIXEDPOINT_IMPL_SHIFTUP( absFracPart, QBits - int(qFracBits) )) 
+                                : (FIXEDPOINT_IMPL_SHIFTUP( intPart, QBits ) - FIXEDPOINT_IMPL_SHIFTUP( absFracPart, QBits - int(qFracBits) )) ) {}
     
     /** Constructs a fixed-point value from another fixed-point value of a different type. The
         source type must be of lower precision (value.cQBits <= cQBits) than this type or the
@@ -205,15 +666,15 @@ public:
             This situation should result in a compiler warning or error, probably about a negative
         shift count. Use one of the "roundedTo" or "truncatedTo" methods on the source fixed-point
         value to make sure it has lower precision. eg. "tFixedPoint<4> x4( x8.roundedTo<4>() )" **/
-    template< int QBits2, typename DataType2 > tFixedPoint( const tFixedPoint<QBits2,DataType2>& value )
-        : value_( value.qValue() << (QBits - QBits2) ) {}
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint( tFixedPoint<QBits2,DataType2> value )
+        : value_( tFixedPointCheck_::shifted< QBits, DataType, QBits - QBits2 >( value.qValue() ) ) {}
 
     //---------------------------------------------------------------------------------------------
     // Conversions
 
     /** Returns the underlying value, which includes the extra qbits. eg. if the current value of a
         tFixedPoint<4> variable is equivalent to 1.25 it will return the value 20 **/
-    tValue qValue() const { return value_; }
+    constexpr tValue qValue() const { return value_; }
     
     /** These methods convert a fixed-point value to the same type as another fixed-point variable.
         Especially useful when you need to reduce the precision of a value to match another lower
@@ -225,20 +686,20 @@ public:
         value respectively. While "increasedTo" convert from a lower precision value to a higher
         one - this method should not be required as often as the first two as most operations will
         automatically increase the precision to match the left hand argument if necessary **/
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> truncatedTo( const tFixedPoint<QBits2,DataType2>& ) const
-        { return tFixedPoint<QBits2,DataType2>::create( value_ >> (QBits - QBits2) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> roundedTo(   const tFixedPoint<QBits2,DataType2>& ) const
-        { return tFixedPoint<QBits2,DataType2>::create( FIXEDPOINT_IMPL_ROUND( value_, (QBits - QBits2) ) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> increasedTo( const tFixedPoint<QBits2,DataType2>& ) const
-        { return tFixedPoint<QBits2,DataType2>::create( DataType2(value_) << (QBits2 - QBits) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits2,DataType2> truncatedTo( tFixedPoint<QBits2,DataType2> ) const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::wrapped< QBits2, DataType2 >( tFixedPointCheck_::lost< QBits2, DataType2, QBits - QBits2 >( value_ ) >> (QBits - QBits2) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits2,DataType2> roundedTo(   tFixedPoint<QBits2,DataType2> ) const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::wrapped< QBits2, DataType2 >( tFixedPointCheck_::rounded< QBits2, DataType2, QBits - QBits2 >( value_ ) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits2,DataType2> increasedTo( tFixedPoint<QBits2,DataType2> ) const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::shifted< QBits2, DataType2, QBits2 - QBits >( value_ ) ); }
     
     /** A variation of the above "increasedTo" method, this conversion allows you to increase the
         precision of a variable by the precision (number of qbits) of another type. Its main use
         is for division where the precision of the result is that of the dividend minus the divisor.
         eg. "x8 / y6" will result in only a tFixedPoint<2> which looses precision, where as 
         "x8.increasedBy( y6 ) / y6" ensures that the final result will be a tFixedPoint<8> **/
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits+QBits2,DataType2> increasedBy( const tFixedPoint<QBits2,DataType2>& ) const
-        { return tFixedPoint<QBits+QBits2,DataType2>::create( DataType2(value_) << QBits2 ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits+QBits2,DataType2> increasedBy( tFixedPoint<QBits2,DataType2> ) const
+        { return tFixedPoint<QBits+QBits2,DataType2>::create( tFixedPointCheck_::shifted< QBits+QBits2, DataType2, QBits2 >( value_ ) ); }
     
     /** These methods convert a fixed-point value to the number of qbits specified, for example
         "tQ8 x8 = y12.roundedTo<8>()". 
@@ -247,239 +708,342 @@ public:
         last converts from a lower precision value to a higher one - this method shouldn't be
         required as often as most operations automatically increase the precision to match the
         left hand argument if necessary **/
-    template< int QBits2 > tFixedPoint<QBits2,DataType> truncatedTo() const
-        { return tFixedPoint<QBits2,DataType>::create( value_ >> (QBits - QBits2) ); }
-    template< int QBits2 > tFixedPoint<QBits2,DataType> roundedTo()   const
-        { return tFixedPoint<QBits2,DataType>::create( FIXEDPOINT_IMPL_ROUND( value_, (QBits - QBits2) ) ); }
-    template< int QBits2 > tFixedPoint<QBits2,DataType> increasedTo() const
-        { return tFixedPoint<QBits2,DataType>::create( value_ << (QBits2 - QBits) ); }
+    template< int QBits2 > constexpr tFixedPoint<QBits2,DataType> truncatedTo() const
+        { return tFixedPoint<QBits2,DataType>::create( tFixedPointCheck_::lost< QBits2, DataType, QBits - QBits2 >( value_ ) >> (QBits - QBits2) ); }
+    template< int QBits2 > constexpr tFixedPoint<QBits2,DataType> roundedTo()   const
+        { return tFixedPoint<QBits2,DataType>::create( tFixedPointCheck_::wrapped< QBits2, DataType >( tFixedPointCheck_::rounded< QBits2, DataType, QBits - QBits2 >( value_ ) ) ); }
+    template< int QBits2 > constexpr tFixedPoint<QBits2,DataType> increasedTo() const
+        { return tFixedPoint<QBits2,DataType>::create( tFixedPointCheck_::shifted< QBits2, DataType, QBits2 - QBits >( value_ ) ); }
     
     /** These methods convert a fixed-point value to another fixed-point value with the number of
         qbits, and underlying data-type specified, for example "tQ8 x8 = y12.roundedTo<8,int>()" **/
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> truncatedTo() const
-        { return tFixedPoint<QBits2,DataType2>::create( value_ >> (QBits - QBits2) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> roundedTo()   const
-        { return tFixedPoint<QBits2,DataType2>::create( FIXEDPOINT_IMPL_ROUND( value_, (QBits - QBits2) ) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits2,DataType2> increasedTo() const
-        { return tFixedPoint<QBits2,DataType2>::create( DataType2(value_) << (QBits2 - QBits) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits2,DataType2> truncatedTo() const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::wrapped< QBits2, DataType2 >( tFixedPointCheck_::lost< QBits2, DataType2, QBits - QBits2 >( value_ ) >> (QBits - QBits2) ) ); }
+    template< int QBits2, typename DataType2, typename Rounding = FIXEDPOINT_ROUNDING > constexpr tFixedPoint<QBits2,DataType2> roundedTo()   const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::wrapped< QBits2, DataType2 >( tFixedPointCheck_::rounded< QBits2, DataType2, QBits - QBits2, Rounding >( value_ ) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits2,DataType2> increasedTo() const
+        { return tFixedPoint<QBits2,DataType2>::create( tFixedPointCheck_::shifted< QBits2, DataType2, QBits2 - QBits >( value_ ) ); }
 
     /** These methods convert from one fixed-point value type to another, in a single direction
         (ie. to a lower precision using "truncateTo" or "roundTo", or a higher precision using
         "increasedTo"). eg. "tQ8 x8 = y12.roundedTo<tQ8>()" **/
-    template< typename FPType > FPType truncatedTo() const { return FPType::create( value_ >> (QBits - FPType::cQBits) ); }
-    template< typename FPType > FPType roundedTo()   const { return FPType::create( FIXEDPOINT_IMPL_ROUND( value_, (QBits - FPType::cQBits) ) ); }
-    template< typename FPType > FPType increasedTo() const { return FPType::create( FPType::tValue(value_) << (FPType::cQBits - QBits) ); }
+    template< typename FPType > constexpr FPType truncatedTo() const { return truncatedTo< FPType::cQBits, typename FPType::tValue >(); }
+    template< typename FPType, typename Rounding = FIXEDPOINT_ROUNDING > constexpr FPType roundedTo()   const
+        { return roundedTo< FPType::cQBits, typename FPType::tValue, Rounding >(); }
+    template< typename FPType > constexpr FPType increasedTo() const { return increasedTo< FPType::cQBits, typename FPType::tValue >(); }
 
     //---------------------------------------------------------------------------------------------
     // Assignment
     
     /** Assignment between fixed-point types with the same precision and underlying data-type **/
-    tFixedPoint& operator=( const tFixedPoint& value ) { value_ = value.value_; return *this; }
+    tFixedPoint& operator=( const tFixedPoint& ) = default;
     
     /** This method allows a variable with a different fixed-point type to be assigned. The type
         being assigned must be of lower or equal precision. Use the "setTruncated" or "setRounded"
         methods to assign a higher precision type (you can also use the source fixed-point values
         "truncatedTo" or "roundedTo" methods) **/
-    template< int QBits2, typename DataType2 > tFixedPoint& operator=( const tFixedPoint<QBits2,DataType2>& value )
-        { return *this = value.increasedTo<QBits,DataType>(); }
+    template< int QBits2, typename DataType2 > tFixedPoint& operator=( tFixedPoint<QBits2,DataType2> value )
+        { return *this = value.template increasedTo<QBits,DataType>(); }
     
     /** These methods provide an alternative way to assign a new fixed-point value. The "set"
         methods will automatically increase the precision of their argument if necessary. While
         the "setTruncated" and "setRounded" can be used to reduce the precision of their argument
         down to the correct value **/
-    void set( const tFixedPoint& value ) { value_ = value.value_; }
-    template< int QBits2, typename DataType2 > void set( const tFixedPoint< QBits2, DataType2 >& value )
-        { *this = value.increasedTo< QBits >(); }
-    template< int QBits2, typename DataType2 > void setTruncated( const tFixedPoint< QBits2, DataType2 >& value )
-        { *this = value.truncatedTo< QBits >(); }
-    template< int QBits2, typename DataType2 > void setRounded( const tFixedPoint< QBits2, DataType2 >& value )
-        { *this = value.roundedTo< QBits >(); }
+    void set( tFixedPoint value ) { value_ = value.value_; }
+    template< int QBits2, typename DataType2 > void set( tFixedPoint< QBits2, DataType2 > value )
+        { *this = value.template increasedTo< QBits >(); }
+    template< int QBits2, typename DataType2 > void setTruncated( tFixedPoint< QBits2, DataType2 > value )
+        { *this = value.template truncatedTo< QBits >(); }
+    template< int QBits2, typename DataType2 > void setRounded( tFixedPoint< QBits2, DataType2 > value )
+        { *this = value.template roundedTo< QBits >(); }
 
     //---------------------------------------------------------------------------------------------
     // Comparisons
     
     /** Returns true if the fixed-point value is zero **/
-    bool operator!() const { return (value_ == 0); }
-    
-    bool operator==( const tFixedPoint& value ) const { return (value_ == value.value_); }
-    bool operator!=( const tFixedPoint& value ) const { return (value_ != value.value_); }
-    bool operator< ( const tFixedPoint& value ) const { return (value_ <  value.value_); }
-    bool operator<=( const tFixedPoint& value ) const { return (value_ <= value.value_); }
-    bool operator>=( const tFixedPoint& value ) const { return (value_ >= value.value_); }
-    bool operator> ( const tFixedPoint& value ) const { return (value_ >  value.value_); }
-
-    template< int QBits2, typename DataType2 > bool operator==( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ == value.increasedTo<QBits,DataType>()); }
-    template< int QBits2, typename DataType2 > bool operator!=( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ != value.increasedTo<QBits,DataType>()); }
-    template< int QBits2, typename DataType2 > bool operator< ( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ <  value.increasedTo<QBits,DataType>()); }
-    template< int QBits2, typename DataType2 > bool operator<=( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ <= value.increasedTo<QBits,DataType>()); }
-    template< int QBits2, typename DataType2 > bool operator>=( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ >= value.increasedTo<QBits,DataType>()); }
-    template< int QBits2, typename DataType2 > bool operator> ( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return (value_ >  value.increasedTo<QBits,DataType>()); }
+    constexpr bool operator!() const { return (value_ == 0); }
+    
+    constexpr bool operator==( tFixedPoint value ) const { return (value_ == value.value_); }
+    constexpr bool operator!=( tFixedPoint value ) const { return (value_ != value.value_); }
+    constexpr bool operator< ( tFixedPoint value ) const { return (value_ <  value.value_); }
+    constexpr bool operator<=( tFixedPoint value ) const { return (value_ <= value.value_); }
+    constexpr bool operator>=( tFixedPoint value ) const { return (value_ >= value.value_); }
+    constexpr bool operator> ( tFixedPoint value ) const { return (value_ >  value.value_); }
+
+    template< int QBits2, typename DataType2 > constexpr bool operator==( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ == value.template increasedTo<QBits,DataType>().qValue()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator!=( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ != value.template increasedTo<QBits,DataType>().qValue()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator< ( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ <  value.template increasedTo<QBits,DataType>().qValue()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator<=( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ <= value.template increasedTo<QBits,DataType>().qValue()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator>=( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ >= value.template increasedTo<QBits,DataType>().qValue()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator> ( tFixedPoint<QBits2,DataType2> value ) const
+        { return (value_ >  value.template increasedTo<QBits,DataType>().qValue()); }
     
     //---------------------------------------------------------------------------------------------
     // Arithmetic
     
-    tFixedPoint& operator+=( const tFixedPoint& value ) { value_ += value.value_; return *this; }
-    tFixedPoint& operator-=( const tFixedPoint& value ) { value_ -= value.value_; return *this; }
-    tFixedPoint& operator*=( const tFixedPoint& value ) { value_ = roundedBy_( value_ * value.value_, QBits ); return *this; }
-    tFixedPoint& operator/=( const tFixedPoint& value ) { value_ = FIXEDPOINT_IMPL_DIVIDE( value_, value.value_ ); return *this; }
+    tFixedPoint& operator+=( tFixedPoint value ) { value_ = wrapped_( tWide(value_) + value.value_ ); return *this; }
+    tFixedPoint& operator-=( tFixedPoint value ) { value_ = wrapped_( tWide(value_) - value.value_ ); return *this; }
+    /** The "*=" and "/=" operators calculate their intermediate results in the double-width tWide
+        type, so that only the final result (which keeps the precision of this value) can overflow.
+        See FixedPointDivide.h for faster alternatives to the division operators **/
+    tFixedPoint& operator*=( tFixedPoint value ) { value_ = wrapped_( tFixedPointCheck_::round< QBits >( tWide(value_)*value.value_ ) ); return *this; }
+    tFixedPoint& operator/=( tFixedPoint value ) { value_ = wrapped_( tFixedPointCheck_::divide( FIXEDPOINT_IMPL_SHIFTUP( tWide(value_), QBits ), tWide(value.value_) ) ); return *this; }
     
     /** These methods provide direct support for multiplying or dividing by a constant. This is
         important for these operations as they affect the number of qbits in the result. Without
         direct support the constant would be converted into a fixed-point number unnecessarily
         increasing the possibility of an overflow occurring during the operation **/
-    template< typename DataType2 > tFixedPoint& operator*=( const DataType2& value )
-        { tValue v = value; value_ *= v; return *this; }
-    template< typename DataType2 > tFixedPoint& operator/=( const DataType2& value )
-        { tValue v = value; value_ = FIXEDPOINT_IMPL_DIVIDE( value_, v ); return *this; }
-    
-    template< int QBits2, typename DataType2 > tFixedPoint& operator+=( const tFixedPoint<QBits2,DataType2>& value )
-        { value_ += value.qValue() << (QBits-QBits2); return *this; }
-    template< int QBits2, typename DataType2 > tFixedPoint& operator-=( const tFixedPoint<QBits2,DataType2>& value )
-        { value_ -= value.qValue() << (QBits-QBits2); return *this; }
-    template< int QBits2, typename DataType2 > tFixedPoint& operator*=( const tFixedPoint<QBits2,DataType2>& value )
-        { value_ = FIXEDPOINT_IMPL_ROUND( value_*value.qValue(), QBits2 ); return *this; }
-    template< int QBits2, typename DataType2 > tFixedPoint& operator/=( const tFixedPoint<QBits2,DataType2>& value )
-        { value_ = FIXEDPOINT_IMPL_DIVIDE( (value_ << (QBits-QBits2)), value.qValue() ); return *this; }
-
-    
-    tFixedPoint operator-() const { return create( -value_ ); }
-    tFixedPoint operator+( const tFixedPoint& value ) const { return create( value_ + value.value_ ); }
-    tFixedPoint operator-( const tFixedPoint& value ) const { return create( value_ - value.value_ ); }
-    tFixedPoint<QBits+QBits,DataType> operator*( const tFixedPoint& value ) const
-        { return tFixedPoint<QBits+QBits,DataType>::create( value_*value.value_ ); }
-    tValue operator/( const tFixedPoint& value ) const
-        { return FIXEDPOINT_IMPL_DIVIDE( value_, value.value_ ); }
+    template< typename DataType2, typename = typename tFixedPointCheck_::tNotFloat< DataType2 >::type > tFixedPoint& operator*=( DataType2 value )
+        { tValue v = value; value_ = wrapped_( tWide(value_) * v ); return *this; }
+    template< typename DataType2, typename = typename tFixedPointCheck_::tNotFloat< DataType2 >::type > tFixedPoint& operator/=( DataType2 value )
+        { tValue v = value; value_ = tFixedPointCheck_::divide( value_, v ); return *this; }
+    
+    template< int QBits2, typename DataType2 > tFixedPoint& operator+=( tFixedPoint<QBits2,DataType2> value )
+        { value_ = wrapped_( tWide(value_) + FIXEDPOINT_IMPL_SHIFTUP( tWide(value.qValue()), QBits-QBits2 ) ); return *this; }
+    template< int QBits2, typename DataType2 > tFixedPoint& operator-=( tFixedPoint<QBits2,DataType2> value )
+        { value_ = wrapped_( tWide(value_) - FIXEDPOINT_IMPL_SHIFTUP( tWide(value.qValue()), QBits-QBits2 ) ); return *this; }
+    template< int QBits2, typename DataType2 > tFixedPoint& operator*=( tFixedPoint<QBits2,DataType2> value )
+        { value_ = wrapped_( tFixedPointCheck_::round< QBits2 >( tWide(value_)*value.qValue() ) ); return *this; }
+    template< int QBits2, typename DataType2 > tFixedPoint& operator/=( tFixedPoint<QBits2,DataType2> value )
+        { value_ = wrapped_( tFixedPointCheck_::divide( FIXEDPOINT_IMPL_SHIFTUP( tWide(value_), QBits2 ), tWide(value.qValue()) ) ); return *this; }
+
+    
+    constexpr tFixedPoint operator-() const { return create( wrapped_( -tWide(value_) ) ); }
+    constexpr tFixedPoint operator+( tFixedPoint value ) const { return create( wrapped_( tWide(value_) + value.value_ ) ); }
+    constexpr tFixedPoint operator-( tFixedPoint value ) const { return create( wrapped_( tWide(value_) - value.value_ ) ); }
+    constexpr tFixedPoint<QBits+QBits,tCompute> operator*( tFixedPoint value ) const
+        { return tFixedPoint<QBits+QBits,tCompute>::create( tFixedPointCheck_::wrapped< QBits+QBits, tCompute >( tWide(value_)*value.value_ ) ); }
+    constexpr tValue operator/( tFixedPoint value ) const
+        { return tFixedPointCheck_::divide( value_, value.value_ ); }
 
     /** These methods provide direct support for multiplying or dividing by a constant. This is
         important for these operations as they affect the number of qbits in the result. Without
         direct support the constant would be converted into a fixed-point number unnecessarily
         increasing the possibility of an overflow occurring during the operation **/
-    template< typename DataType2 > tFixedPoint operator*( const DataType2& value ) const
-        { return create( value_ * value ); }
-    template< typename DataType2 > tFixedPoint operator/( const DataType2& value ) const
-        { return create( FIXEDPOINT_IMPL_DIVIDE( value_, value ) ); }
-
-    template< int QBits2, typename DataType2 > tFixedPoint operator+( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return create( value_ + (value.qValue() << (QBits-QBits2)) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint operator-( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return create( value_ - (value.qValue() << (QBits-QBits2)) ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits+QBits2,DataType> operator*( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return tFixedPoint<QBits+QBits2,DataType>::create( value_ * value.qValue() ); }
-    template< int QBits2, typename DataType2 > tFixedPoint<QBits-QBits2,DataType> operator/( const tFixedPoint<QBits2,DataType2>& value ) const
-        { return tFixedPoint<QBits-QBits2,DataType>::create( FIXEDPOINT_IMPL_DIVIDE( value_, value.qValue() ) ); }
-    
+    template< typename DataType2, typename = typename tFixedPointCheck_::tNotFloat< DataType2 >::type > constexpr tFixedPoint operator*( DataType2 value ) const
+        { return create( wrapped_( tWide(value_) * value ) ); }
+    template< typename DataType2, typename = typename tFixedPointCheck_::tNotFloat< DataType2 >::type > constexpr tFixedPoint operator/( DataType2 value ) const
+        { return create( tFixedPointCheck_::divide( value_, tValue(value) ) ); }
+
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint operator+( tFixedPoint<QBits2,DataType2> value ) const
+        { return create( wrapped_( tWide(value_) + FIXEDPOINT_IMPL_SHIFTUP( tWide(value.qValue()), QBits-QBits2 ) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint operator-( tFixedPoint<QBits2,DataType2> value ) const
+        { return create( wrapped_( tWide(value_) - FIXEDPOINT_IMPL_SHIFTUP( tWide(value.qValue()), QBits-QBits2 ) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits+QBits2,tCompute> operator*( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedPoint<QBits+QBits2,tCompute>::create( tFixedPointCheck_::wrapped< QBits+QBits2, tCompute >( tWide(value_) * value.qValue() ) ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits-QBits2,DataType> operator/( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedPoint<QBits-QBits2,DataType>::create( tFixedPointCheck_::divide< FIXEDPOINT_ROUNDING, decltype( value_ + value.qValue() ) >( value_, value.qValue() ) ); }
+
+    /** A variation of the above "operator*" that returns the full-precision product in the double
+        width tWide type, so it can't overflow even when the sum of the qbits doesn't fit in a
+        tValue. The result can then be narrowed back down with a single rounding or truncation.
+        eg. "a8 = b8.multipliedBy( c12 ).roundedTo<8,int>()" **/
+    template< int QBits2, typename DataType2 > constexpr tFixedPoint<QBits+QBits2,tWide> multipliedBy( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedPoint<QBits+QBits2,tWide>::create( tWide(value_) * value.qValue() ); }
+
     //---------------------------------------------------------------------------------------------
     // Miscellaneous
     
-    tValue absolute() const { return (value_ >= 0)? value_ : -value_; }
-    tValue intPart() const { return value_ >> QBits; }
-    tValue fracPart() const { return (value_ >= 0)? (value_ & ((1 << QBits) - 1)) : -((-value_) & ((1 << QBits) - 1)); }
-    tValue absFracPart() const { return ((value_ >= 0)? value_ : -value_) & ((1 << QBits) - 1); }
+    constexpr tValue absolute() const { return (value_ >= 0)? value_ : -value_; }
+    /** NB. "intPart" rounds towards -ve infinity (like a shift), while "fracPart" has the sign of the
+        value, so for negative values with a fractional part "intPart() + fracPart()" isn't the
+        value. eg. for -1.25 they return -2 and -0.25 (in qbits) respectively **/
+    constexpr tValue intPart() const { return value_ >> QBits; }
+    constexpr tValue fracPart() const { return (value_ >= 0)? (value_ & ((tValue(1) << QBits) - 1)) : -((-value_) & ((tValue(1) << QBits) - 1)); }
+    constexpr tValue absFracPart() const { return ((value_ >= 0)? value_ : -value_) & ((tValue(1) << QBits) - 1); }
     
     /** This method is provided as a starter for making the output/printing of fixed-point values
         easier when support for conversion to floating-point hasn't been enabled. It returns the 
-        fractional part of the fixed-point value in base-10 to the number of decimal places you
-        specify. eg. "printf( "%d.%03d", a8.intPart(), a8.fracPlaces(3) );".
-            NB. this method should probably be shifted out into a common/shared implementation **/
-    tValue fracPlaces( unsigned decimals ) { 
-        tValue frac = absFracPart();
-        const unsigned cXBits = 4;
-        unsigned dec_qx = (1 << (cXBits-1));
-        while (decimals-- > 0) dec_qx *= 10; 
-        
-        tValue result = 0;
-        tValue mask = 1 << (QBits - 1);
-        
-        while (frac != 0) {
-            if (frac & mask) {
-                frac -= mask;
-                result += dec_qx;
-            }
-            dec_qx >>= 1;
-            mask >>= 1;
-        }
-        return ((result + (1 << (cXBits-1))) >> cXBits);
-    }
+        fractional part of the absolute value in base-10 to the number of decimal places you
+        specify (up to 19), rounded to the nearest. eg. "printf( "%d.%03d", a8.intPart(), a8.fracPlaces(3) );"
+        for a positive value. It is a single multiply and shift, so the qbits plus 3.33 bits for
+        each decimal place must fit in 64 bits.
+            See "toChars" in FixedPointFormat.h for a formatter which also handles negative values
+        (and a fraction that rounds up to 1), without needing printf **/
+    tValue fracPlaces( unsigned decimals ) const
+        { return tValue( ((unsigned long long)( absFracPart() ) * tFixedPointDecimal_<>::power( decimals ) + ((1ull << QBits) >> 1)) >> QBits ); }
     
     //---------------------------------------------------------------------------------------------
     // Floating Point
+
+    /** Convert to and from a single-precision float, which don't need FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+        or any floating-point library. The float is rounded to the nearest (halves to even), while
+        "fromFloat" truncates towards 0 and saturates, as the VCVT instructions they are done with
+        on Arm targets with an FPU do (see tFixedPointFloat_) **/
+    float toFloat() const { return tFixedPointFloat_::toFloat< QBits, DataType >( value_ ); }
+    static tFixedPoint fromFloat( float value ) { return create( tFixedPointFloat_::fromFloat< QBits, DataType >( value ) ); }
     
 #   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
 public:    
-    explicit tFixedPoint( double value ) : value_( rounded_( value ) ) {}
+    explicit constexpr tFixedPoint( double value ) : value_( rounded_( value ) ) {}
    
-    double toDouble() const { return double( value_ ) / (tValue(1) << QBits); }
+    constexpr double toDouble() const { return double( value_ ) / (tValue(1) << QBits); }
 
     tFixedPoint& operator=( double value ) { value_ = rounded_( value ); return *this; }
 
     void setTruncated( double value ) { value_ = truncated_( value ); }
     void setRounded( double value ) { value_ = rounded_( value ); }
     
-    bool operator==( double value ) const { return (value_ == rounded_( value )); }
-    bool operator!=( double value ) const { return (value_ != rounded_( value )); }
-    bool operator< ( double value ) const { return (value_ <  rounded_( value )); }
-    bool operator<=( double value ) const { return (value_ <= rounded_( value )); }
-    bool operator>=( double value ) const { return (value_ >= rounded_( value )); }
-    bool operator> ( double value ) const { return (value_ >  rounded_( value )); }
+    constexpr bool operator==( double value ) const { return (value_ == rounded_( value )); }
+    constexpr bool operator!=( double value ) const { return (value_ != rounded_( value )); }
+    constexpr bool operator< ( double value ) const { return (value_ <  rounded_( value )); }
+    constexpr bool operator<=( double value ) const { return (value_ <= rounded_( value )); }
+    constexpr bool operator>=( double value ) const { return (value_ >= rounded_( value )); }
+    constexpr bool operator> ( double value ) const { return (value_ >  rounded_( value )); }
 
     tFixedPoint& operator+=( double value ) { value_ += rounded_( value ); return *this; }
     tFixedPoint& operator-=( double value ) { value_ -= rounded_( value ); return *this; }
-    tFixedPoint& operator*=( double value ) { value_ = tValue( value_*value + 0.5 ); return *this; }
-    tFixedPoint& operator/=( double value ) { value_ = tValue( value_/value + 0.5 ); return *this; }
+    tFixedPoint& operator*=( double value ) { value_ = nearest_( value_*value ); return *this; }
+    tFixedPoint& operator/=( double value ) { value_ = nearest_( value_/value ); return *this; }
+
+    constexpr tFixedPoint operator+( double value ) const { return create( value_ + rounded_( value ) ); }
+    constexpr tFixedPoint operator-( double value ) const { return create( value_ - rounded_( value ) ); }
+    constexpr tFixedPoint operator*( double value ) const { return create( nearest_( value_*value ) ); }
+    constexpr tFixedPoint operator/( double value ) const { return create( nearest_( value_/value ) ); }
 
-    tFixedPoint operator+( double value ) const { return create( value_ + rounded_( value ) ); }
-    tFixedPoint operator-( double value ) const { return create( value_ - rounded_( value ) ); }
-    tFixedPoint operator*( double value ) const { return create( tValue( value_*value + 0.5 ) ); }
-    tFixedPoint operator/( double value ) const { return create( tValue( value_/value + 0.5 ) ); }
+    static constexpr tFixedPoint truncated( double value ) { return create( truncated_( value ) ); }
+    static constexpr tFixedPoint rounded( double value ) { return create( rounded_( value ) ); }
 
-    static tFixedPoint truncated( double value ) { return create( truncated_( value ) ); }
-    static tFixedPoint rounded( double value ) { return create( rounded_( value ) ); }
+    /** As above, but rounded using the 'Rounding' policy given **/
+    template< typename Rounding > static constexpr tFixedPoint rounded( double value )
+        { return create( Rounding::template converted< QBits, DataType >( value * (tValue(1) << QBits) ) ); }
     
 private:    
-    static tValue truncated_( double value ) { return tValue( value * (tValue(1) << QBits) ); }
-    static tValue rounded_( double value ) { return tValue( value * (tValue(1) << QBits) + 0.5 ); }
+    static constexpr tValue truncated_( double value ) { return tFixedPointCheck_::converted< QBits, DataType >( value * (tValue(1) << QBits) ); }
+    static constexpr tValue rounded_( double value ) { return nearest_( value * (tValue(1) << QBits) ); }
+
+    /** Returns the scaled 'value' rounded using the FIXEDPOINT_ROUNDING policy (the conversion
+        alone truncates towards 0) **/
+    static constexpr tValue nearest_( double value ) { return FIXEDPOINT_ROUNDING::template converted< QBits, DataType >( value ); }
+#   else
+public:
+    /** Without floating-point support a double (or float) would otherwise be converted to a tValue,
+        silently dropping its fractional part, so that is an error instead. Use "fromFloat", the
+        FIXEDPOINT_CONSTANT macros or the fixed-point literals **/
+    template< typename FloatType, typename = typename std::enable_if< std::is_floating_point< FloatType >::value >::type >
+    tFixedPoint( FloatType value ) = delete;
 #   endif
     
     //---------------------------------------------------------------------------------------------
     // Implementation Details
     
 private:
+    /** Converts the result of an operation to a tValue, see tFixedPointCheck_ **/
+    template< typename T > static constexpr tValue wrapped_( T value ) { return tFixedPointCheck_::wrapped< QBits, DataType >( value ); }
+
     tValue  value_;
 };
 
 //-------------------------------------------------------------------------------------------------
 // External Helpers
 
-template< int QBits, typename DataType > tFixedPoint<QBits,DataType> operator+( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return rhs + lhs; }
-template< int QBits, typename DataType > tFixedPoint<QBits,DataType> operator-( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return tFixedPoint<QBits,DataType>(lhs) - rhs; }
-template< int QBits, typename DataType > tFixedPoint<QBits,DataType> operator*( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return rhs * lhs; }
+template< int QBits, typename DataType > constexpr tFixedPoint<QBits,DataType> operator+( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return rhs + lhs; }
+template< int QBits, typename DataType > constexpr tFixedPoint<QBits,DataType> operator-( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return tFixedPoint<QBits,DataType>(lhs) - rhs; }
+template< int QBits, typename DataType > constexpr tFixedPoint<QBits,DataType> operator*( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return rhs * lhs; }
 
-template< int QBits, typename DataType > bool operator==( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs == lhs); }
-template< int QBits, typename DataType > bool operator!=( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs != lhs); }
-template< int QBits, typename DataType > bool operator< ( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs >= lhs); }
-template< int QBits, typename DataType > bool operator<=( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs >  lhs); }
-template< int QBits, typename DataType > bool operator>=( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs <  lhs); }
-template< int QBits, typename DataType > bool operator> ( DataType lhs, const tFixedPoint<QBits,DataType>& rhs ) { return (rhs <= lhs); }
+template< int QBits, typename DataType > constexpr bool operator==( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() == rhs.qValue()); }
+template< int QBits, typename DataType > constexpr bool operator!=( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() != rhs.qValue()); }
+template< int QBits, typename DataType > constexpr bool operator< ( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() <  rhs.qValue()); }
+template< int QBits, typename DataType > constexpr bool operator<=( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() <= rhs.qValue()); }
+template< int QBits, typename DataType > constexpr bool operator>=( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() >= rhs.qValue()); }
+template< int QBits, typename DataType > constexpr bool operator> ( DataType lhs, tFixedPoint<QBits,DataType> rhs ) { return (tFixedPoint<QBits,DataType>( lhs ).qValue() >  rhs.qValue()); }
 
 #ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
-template< int QBits > tFixedPoint<QBits> truncatedTo( double value ) { return tFixedPoint<QBits>::truncated( value ); }
-template< int QBits > tFixedPoint<QBits> roundedTo(   double value ) { return tFixedPoint<QBits>::rounded( value ); }
+template< int QBits > constexpr tFixedPoint<QBits> truncatedTo( double value ) { return tFixedPoint<QBits>::truncated( value ); }
+template< int QBits > constexpr tFixedPoint<QBits> roundedTo(   double value ) { return tFixedPoint<QBits>::rounded( value ); }
 
-template< typename FPType > FPType truncatedTo( double value ) { return FPType::truncated( value ); }
-template< typename FPType > FPType roundedTo(   double value ) { return FPType::rounded( value ); }
+template< typename FPType > constexpr FPType truncatedTo( double value ) { return FPType::truncated( value ); }
+template< typename FPType > constexpr FPType roundedTo(   double value ) { return FPType::rounded( value ); }
 
-template< int QBits, typename DataType > tFixedPoint<QBits,DataType> truncatedTo( const tFixedPoint<QBits,DataType>&, double value )
+template< int QBits, typename DataType > constexpr tFixedPoint<QBits,DataType> truncatedTo( tFixedPoint<QBits,DataType>, double value )
     { return tFixedPoint<QBits,DataType>::truncated( value ); }
-template< int QBits, typename DataType > tFixedPoint<QBits,DataType> roundedTo(   const tFixedPoint<QBits,DataType>&, double value )
+template< int QBits, typename DataType > constexpr tFixedPoint<QBits,DataType> roundedTo(   tFixedPoint<QBits,DataType>, double value )
     { return tFixedPoint<QBits,DataType>::rounded( value ); }
 #endif
-    
+
+//-------------------------------------------------------------------------------------------------
+// Literals
+
+/** Compile-time parser used by the FIXEDPOINT_DEFINE_LITERAL macro. It accepts decimal literals of
+    the form "123" or "123.456" (no exponents), and rounds the fractional part to the nearest qValue
+    using at most 9 decimal places (fewer for very large numbers of qbits) **/
+struct tFixedPointLiteral_
+{
+    typedef unsigned long long tULL;
+
+    static constexpr bool isDigit( char c ) { return (c >= '0') && (c <= '9'); }
+    static constexpr unsigned maxDigits( unsigned qBits ) { return ((63 - qBits)*3/10 < 9)? (63 - qBits)*3/10 : 9; }
+
+    static constexpr bool valid( bool ) { return true; }
+    template< typename... Chars > static constexpr bool valid( bool seenPoint, char c, Chars... rest )
+        { return (isDigit( c ) || (c == '.' && !seenPoint)) && valid( seenPoint || (c == '.'), rest... ); }
+
+    static constexpr tULL intPart( tULL acc ) { return acc; }
+    template< typename... Chars > static constexpr tULL intPart( tULL acc, char c, Chars... rest )
+        { return (c == '.')? acc : intPart( acc*10 + tULL(c - '0'), rest... ); }
+
+    /** Return the first 'digits' fractional digits as an integer, and the power of ten the
+        integer needs to be divided by respectively **/
+    static constexpr tULL fracPart( bool, unsigned, tULL acc ) { return acc; }
+    template< typename... Chars > static constexpr tULL fracPart( bool seenPoint, unsigned digits, tULL acc, char c, Chars... rest )
+        { return !seenPoint? fracPart( (c == '.'), digits, acc, rest... )
+                           : (digits == 0)? acc : fracPart( true, digits-1, acc*10 + tULL(c - '0'), rest... ); }
+
+    static constexpr tULL fracScale( bool, unsigned ) { return 1; }
+    template< typename... Chars > static constexpr tULL fracScale( bool seenPoint, unsigned digits, char c, Chars... rest )
+        { return !seenPoint? fracScale( (c == '.'), digits, rest... )
+                           : (digits == 0)? 1 : 10*fracScale( true, digits-1, rest... ); }
+
+    /** Returns the qValue for the literal made up from 'Chars' with the 'QBits' specified **/
+    template< unsigned QBits, char... Chars > static constexpr tULL qValue()
+        { return (intPart( 0, Chars... ) << QBits)
+               + ((fracPart( false, maxDigits( QBits ), 0, Chars... ) << QBits) + fracScale( false, maxDigits( QBits ), Chars... )/2)
+                 / fracScale( false, maxDigits( QBits ), Chars... ); }
+
+    /** Returns whether the literal made up from 'Chars' (after rounding) fits a 'DataType' with the
+        'QBits' specified. A literal is always parsed without its sign, so the most negative value
+        has to be written as an expression instead **/
+    template< unsigned QBits, typename DataType, char... Chars > static constexpr bool fits()
+        { return (intPart( 0, Chars... ) <= (tULL( std::numeric_limits< DataType >::max() ) >> QBits))
+              && (qValue< QBits, Chars... >() <= tULL( std::numeric_limits< DataType >::max() )); }
+};
+
+/** This macro defines a user-defined literal 'suffix' for the fixed-point type 'FPType', so that
+    constants can be written directly as fixed-point values which are always evaluated at compile
+    time, eg. after "FIXEDPOINT_DEFINE_LITERAL( _q4, tQ4 )" the value 1.25 can be written as
+    "1.25_q4" (and -1.25 as "-1.25_q4"). No floating-point support is required, and a literal
+    which doesn't fit the type (eg. "200.0_q24") is a compile-time error.
+        Literals "_q1" to "_q30" are predefined for the default tFixedPoint data-type **/
+#define FIXEDPOINT_DEFINE_LITERAL( suffix, FPType )                                                   \
+    template< char... Chars > constexpr FPType operator"" suffix()                                      \
+    {                                                                                                   \
+        static_assert( tFixedPointLiteral_::valid( false, Chars... ), "invalid fixed-point literal" );  \
+        static_assert( tFixedPointLiteral_::fits< FPType::cQBits, FPType::tValue, Chars... >(),         \
+                       "fixed-point literal out of range" );                                            \
+        return FPType::create( FPType::tValue( tFixedPointLiteral_::qValue< FPType::cQBits, Chars... >() ) ); \
+    }
+
+FIXEDPOINT_DEFINE_LITERAL( _q1,  tFixedPoint< 1 > )   FIXEDPOINT_DEFINE_LITERAL( _q2,  tFixedPoint< 2 > )
+FIXEDPOINT_DEFINE_LITERAL( _q3,  tFixedPoint< 3 > )   FIXEDPOINT_DEFINE_LITERAL( _q4,  tFixedPoint< 4 > )
+FIXEDPOINT_DEFINE_LITERAL( _q5,  tFixedPoint< 5 > )   FIXEDPOINT_DEFINE_LITERAL( _q6,  tFixedPoint< 6 > )
+FIXEDPOINT_DEFINE_LITERAL( _q7,  tFixedPoint< 7 > )   FIXEDPOINT_DEFINE_LITERAL( _q8,  tFixedPoint< 8 > )
+FIXEDPOINT_DEFINE_LITERAL( _q9,  tFixedPoint< 9 > )   FIXEDPOINT_DEFINE_LITERAL( _q10, tFixedPoint< 10 > )
+FIXEDPOINT_DEFINE_LITERAL( _q11, tFixedPoint< 11 > )  FIXEDPOINT_DEFINE_LITERAL( _q12, tFixedPoint< 12 > )
+FIXEDPOINT_DEFINE_LITERAL( _q13, tFixedPoint< 13 > )  FIXEDPOINT_DEFINE_LITERAL( _q14, tFixedPoint< 14 > )
+FIXEDPOINT_DEFINE_LITERAL( _q15, tFixedPoint< 15 > )  FIXEDPOINT_DEFINE_LITERAL( _q16, tFixedPoint< 16 > )
+FIXEDPOINT_DEFINE_LITERAL( _q17, tFixedPoint< 17 > )  FIXEDPOINT_DEFINE_LITERAL( _q18, tFixedPoint< 18 > )
+FIXEDPOINT_DEFINE_LITERAL( _q19, tFixedPoint< 19 > )  FIXEDPOINT_DEFINE_LITERAL( _q20, tFixedPoint< 20 > )
+FIXEDPOINT_DEFINE_LITERAL( _q21, tFixedPoint< 21 > )  FIXEDPOINT_DEFINE_LITERAL( _q22, tFixedPoint< 22 > )
+FIXEDPOINT_DEFINE_LITERAL( _q23, tFixedPoint< 23 > )  FIXEDPOINT_DEFINE_LITERAL( _q24, tFixedPoint< 24 > )
+FIXEDPOINT_DEFINE_LITERAL( _q25, tFixedPoint< 25 > )  FIXEDPOINT_DEFINE_LITERAL( _q26, tFixedPoint< 26 > )
+FIXEDPOINT_DEFINE_LITERAL( _q27, tFixedPoint< 27 > )  FIXEDPOINT_DEFINE_LITERAL( _q28, tFixedPoint< 28 > )
+FIXEDPOINT_DEFINE_LITERAL( _q29, tFixedPoint< 29 > )  FIXEDPOINT_DEFINE_LITERAL( _q30, tFixedPoint< 30 > )
+
 //-------------------------------------------------------------------------------------------------
 
 #endif  // inclusion guard
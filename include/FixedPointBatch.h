@@ -0,0 +1,367 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides functions operating on arrays of fixed-point values,
+//   using SIMD instructions where the target has them.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTBATCH_H
+#define FIXEDPOINTBATCH_H
+
+#include "FixedPoint.h"
+#include "FixedPointTarget.h"
+#include "SatFixedPoint.h"
+#include <cstring>
+#include <type_traits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Batch Operations
+***************************************************************************************************
+
+This file provides functions that apply an operation to each element of arrays of fixed-point
+values, with arguments in the same order as the CMSIS-DSP functions (sources, destination, count),
+
+    add( a, b, out, count );          // out[i] = a[i] + b[i]
+    mul( a, b, out, count );          // out[i] = a[i] * b[i], as for "*="
+    mac( a, b, acc, count );          // acc[i] += a[i] * b[i], as for "*=" and then "+="
+    scale( a, k, out, count );        // out[i] = a[i] * k, as for "*="
+    roundedTo( a, out, count );       // out[i] = a[i].roundedTo( out[i] )
+    p = dot( a, b, count );           // sum of a[i].multipliedBy( b[i] ), in a 64-bit type
+
+Every function gives exactly the same result as the scalar tFixedPoint operators, and "add" also has
+a saturating version for arrays of tSatFixedPoint values. The output may be the same array as one
+of the inputs.
+
+For arrays of 16-bit values the following SIMD instructions are used where they are available
+(see FixedPointTarget.h, and define FIXEDPOINT_BATCH_DISABLE_SIMD to always use the plain C++ loops),
+
+    Cortex-M55/M85 (Helium MVE)       add, mul, mac, scale and dot, 8 values at a time (*).
+    Cortex-M4/M7/M33 (DSP extension)  SADD16/QADD16 for add, SMLALD for dot (*).
+    RISC-V P extension (RV32)         ADD16/KADD16 for add (*).
+    SSE2 (host simulation)            add, mul, mac, scale and dot, 8 values at a time.
+    NEON (host simulation)            add, mul, mac, scale and dot, 8 values at a time (*).
+
+(*) only with FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS defined, see FixedPointTarget.h.
+
+There are no DSP extension kernels for mul, mac and scale, as SMLAD and SMUAD sum the two
+products they form, and SMULBB/SMULTT do no more than the plain loop compiles to.
+
+The SIMD versions of mul, mac and scale round halves up, so they are only used when the
+FIXEDPOINT_ROUNDING policy does the same (tRoundNearest or tRoundHalfUp).
+
+Other cases use plain loops, which compilers are generally able to unroll and vectorise for 32-bit
+values themselves.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The set of kernels used, only one of which is chosen **/
+#if !defined(FIXEDPOINT_BATCH_DISABLE_SIMD)
+#   if defined(FIXEDPOINT_TARGET_MVE)
+#       define FIXEDPOINT_BATCH_MVE
+#   elif defined(FIXEDPOINT_TARGET_SIMD32)
+#       define FIXEDPOINT_BATCH_SIMD32
+#   elif defined(FIXEDPOINT_TARGET_NEON)
+#       define FIXEDPOINT_BATCH_NEON
+#   elif defined(FIXEDPOINT_TARGET_SSE2)
+#       define FIXEDPOINT_BATCH_SSE2
+#   elif defined(FIXEDPOINT_TARGET_RVP)
+#       define FIXEDPOINT_BATCH_RVP
+#   endif
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Kernels operating on arrays of raw values. Each returns the number of elements it processed
+    from the start of the arrays, with the remaining elements left to the caller's scalar loop.
+    The templates, used for data-types without a specialised kernel, process nothing **/
+struct tFixedBatch_
+{
+    template< typename DataType >
+    static unsigned add( const DataType*, const DataType*, DataType*, unsigned ) { return 0; }
+    template< typename DataType >
+    static unsigned addSaturating( const DataType*, const DataType*, DataType*, unsigned ) { return 0; }
+    template< bool Broadcast, bool Accumulate, typename DataType >
+    static unsigned mul( const DataType*, const DataType*, DataType*, unsigned, int ) { return 0; }
+    template< typename DataType >
+    static unsigned dot( const DataType*, const DataType*, unsigned, long long& ) { return 0; }
+
+    /** True if the rounding policy rounds halves up, as the SIMD multiplies do **/
+    static const bool cRoundsHalfUp = std::is_same< FIXEDPOINT_ROUNDING, tRoundNearest >::value || std::is_same< FIXEDPOINT_ROUNDING, tRoundHalfUp >::value;
+
+#   if defined(FIXEDPOINT_BATCH_MVE)
+    /** Returns the rounded 32-bit products of a and b, shifted right by 'shift', wrapped back
+        down to 16 bits as for a plain conversion. The even and odd lanes are multiplied
+        separately, and put back in place by the narrowing moves **/
+    static int16x8_t mul( int16x8_t a, int16x8_t b, int shift ) {
+        const int32x4_t even = vrshlq_n_s32( vmullbq_int_s16( a, b ), -shift );
+        const int32x4_t odd = vrshlq_n_s32( vmulltq_int_s16( a, b ), -shift );
+        return vmovntq_s32( vmovnbq_s32( vdupq_n_s16( 0 ), even ), odd );
+    }
+
+    static unsigned add( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) vst1q_s16( out + i, vaddq_s16( vld1q_s16( a + i ), vld1q_s16( b + i ) ) );
+        return i;
+    }
+    static unsigned addSaturating( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) vst1q_s16( out + i, vqaddq_s16( vld1q_s16( a + i ), vld1q_s16( b + i ) ) );
+        return i;
+    }
+    template< bool Broadcast, bool Accumulate >
+    static unsigned mul( const short* a, const short* b, short* out, unsigned count, int shift ) {
+        if (shift <= 0 || !cRoundsHalfUp) return 0;
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const int16x8_t p = mul( vld1q_s16( a + i ), Broadcast? vdupq_n_s16( *b ) : vld1q_s16( b + i ), shift );
+            vst1q_s16( out + i, Accumulate? vaddq_s16( vld1q_s16( out + i ), p ) : p );
+        }
+        return i;
+    }
+    static unsigned dot( const short* a, const short* b, unsigned count, long long& sum ) {
+        long long s = sum;
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) s = vmlaldavaq_s16( s, vld1q_s16( a + i ), vld1q_s16( b + i ) );
+        sum = s;
+        return i;
+    }
+#   endif
+
+#   if defined(FIXEDPOINT_BATCH_SIMD32)
+    static int16x2_t load( const short* p ) { int16x2_t v; std::memcpy( &v, p, sizeof(v) ); return v; }
+    static void store( short* p, int16x2_t v ) { std::memcpy( p, &v, sizeof(v) ); }
+
+    static unsigned add( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 2 <= count; i += 2) store( out + i, __sadd16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+    static unsigned addSaturating( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 2 <= count; i += 2) store( out + i, __qadd16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+    static unsigned dot( const short* a, const short* b, unsigned count, long long& sum ) {
+        unsigned i = 0;
+        for (; i + 2 <= count; i += 2) sum = __smlald( load( a + i ), load( b + i ), sum );
+        return i;
+    }
+#   endif
+
+#   if defined(FIXEDPOINT_BATCH_SSE2)
+    static __m128i load( const short* p ) { return _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ); }
+    static void store( short* p, __m128i v ) { _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), v ); }
+
+    /** Returns the rounded 32-bit products of a and b, shifted right by 'shift', wrapped back
+        down to 16 bits as for a plain conversion **/
+    static __m128i mul( __m128i a, __m128i b, int shift ) {
+        const __m128i lo = _mm_mullo_epi16( a, b );
+        const __m128i hi = _mm_mulhi_epi16( a, b );
+        const __m128i half = _mm_set1_epi32( 1 << (shift - 1) );
+        const __m128i count = _mm_cvtsi32_si128( shift );
+        const __m128i p0 = _mm_sra_epi32( _mm_add_epi32( _mm_unpacklo_epi16( lo, hi ), half ), count );
+        const __m128i p1 = _mm_sra_epi32( _mm_add_epi32( _mm_unpackhi_epi16( lo, hi ), half ), count );
+        return _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( p0, 16 ), 16 ), _mm_srai_epi32( _mm_slli_epi32( p1, 16 ), 16 ) );
+    }
+    /** Adds the 32-bit values in 'p' to the two 64-bit sums in 'sum' **/
+    static __m128i sum64( __m128i sum, __m128i p ) {
+        const __m128i sign = _mm_srai_epi32( p, 31 );
+        return _mm_add_epi64( _mm_add_epi64( sum, _mm_unpacklo_epi32( p, sign ) ), _mm_unpackhi_epi32( p, sign ) );
+    }
+
+    static unsigned add( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) store( out + i, _mm_add_epi16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+    static unsigned addSaturating( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) store( out + i, _mm_adds_epi16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+    template< bool Broadcast, bool Accumulate >
+    static unsigned mul( const short* a, const short* b, short* out, unsigned count, int shift ) {
+        if (shift <= 0 || !cRoundsHalfUp) return 0;
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i p = mul( load( a + i ), Broadcast? _mm_set1_epi16( *b ) : load( b + i ), shift );
+            store( out + i, Accumulate? _mm_add_epi16( load( out + i ), p ) : p );
+        }
+        return i;
+    }
+    static unsigned dot( const short* a, const short* b, unsigned count, long long& sum ) {
+        __m128i s = _mm_setzero_si128();
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i va = load( a + i );
+            const __m128i vb = load( b + i );
+            const __m128i lo = _mm_mullo_epi16( va, vb );
+            const __m128i hi = _mm_mulhi_epi16( va, vb );
+            s = sum64( sum64( s, _mm_unpacklo_epi16( lo, hi ) ), _mm_unpackhi_epi16( lo, hi ) );
+        }
+        long long sums[2];
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( sums ), s );
+        sum += sums[0] + sums[1];
+        return i;
+    }
+#   endif
+
+#   if defined(FIXEDPOINT_BATCH_NEON)
+    /** Returns the rounded 32-bit products of a and b, shifted right by 'shift', wrapped back
+        down to 16 bits as for a plain conversion **/
+    static int16x8_t mul( int16x8_t a, int16x8_t b, int shift ) {
+        const int32x4_t count = vdupq_n_s32( -shift );
+        return vcombine_s16( vmovn_s32( vrshlq_s32( vmull_s16( vget_low_s16( a ), vget_low_s16( b ) ), count ) ),
+                             vmovn_s32( vrshlq_s32( vmull_s16( vget_high_s16( a ), vget_high_s16( b ) ), count ) ) );
+    }
+
+    static unsigned add( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) vst1q_s16( out + i, vaddq_s16( vld1q_s16( a + i ), vld1q_s16( b + i ) ) );
+        return i;
+    }
+    static unsigned addSaturating( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) vst1q_s16( out + i, vqaddq_s16( vld1q_s16( a + i ), vld1q_s16( b + i ) ) );
+        return i;
+    }
+    template< bool Broadcast, bool Accumulate >
+    static unsigned mul( const short* a, const short* b, short* out, unsigned count, int shift ) {
+        if (shift <= 0 || !cRoundsHalfUp) return 0;
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const int16x8_t p = mul( vld1q_s16( a + i ), Broadcast? vdupq_n_s16( *b ) : vld1q_s16( b + i ), shift );
+            vst1q_s16( out + i, Accumulate? vaddq_s16( vld1q_s16( out + i ), p ) : p );
+        }
+        return i;
+    }
+    static unsigned dot( const short* a, const short* b, unsigned count, long long& sum ) {
+        int64x2_t s = vdupq_n_s64( 0 );
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const int16x8_t va = vld1q_s16( a + i );
+            const int16x8_t vb = vld1q_s16( b + i );
+            s = vpadalq_s32( s, vmull_s16( vget_low_s16( va ), vget_low_s16( vb ) ) );
+            s = vpadalq_s32( s, vmull_s16( vget_high_s16( va ), vget_high_s16( vb ) ) );
+        }
+        sum += vgetq_lane_s64( s, 0 ) + vgetq_lane_s64( s, 1 );
+        return i;
+    }
+#   endif
+
+#   if defined(FIXEDPOINT_BATCH_RVP)
+    static unsigned load( const short* p ) { unsigned v; std::memcpy( &v, p, sizeof(v) ); return v; }
+    static void store( short* p, unsigned v ) { std::memcpy( p, &v, sizeof(v) ); }
+
+    static unsigned add( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 2 <= count; i += 2) store( out + i, tFixedTargetRvp_::add16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+    static unsigned addSaturating( const short* a, const short* b, short* out, unsigned count ) {
+        unsigned i = 0;
+        for (; i + 2 <= count; i += 2) store( out + i, tFixedTargetRvp_::kadd16( load( a + i ), load( b + i ) ) );
+        return i;
+    }
+#   endif
+
+    /** Returns the raw values of an array of fixed-point values, which is valid as tFixedPoint
+        (and tSatFixedPoint) are standard-layout classes with the value as their only member **/
+    template< typename FPType > static const typename FPType::tValue* raw( const FPType* values ) {
+        static_assert( sizeof(FPType) == sizeof(typename FPType::tValue), "fixed-point values must have the same size as their data-type" );
+        return reinterpret_cast<const typename FPType::tValue*>( values );
+    }
+    template< typename FPType > static typename FPType::tValue* raw( FPType* values ) {
+        static_assert( sizeof(FPType) == sizeof(typename FPType::tValue), "fixed-point values must have the same size as their data-type" );
+        return reinterpret_cast<typename FPType::tValue*>( values );
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Batch Operations
+
+/** out[i] = a[i] + b[i], for i = [0,count) **/
+template< int QBits, typename DataType >
+void add( const tFixedPoint<QBits,DataType>* a, const tFixedPoint<QBits,DataType>* b, tFixedPoint<QBits,DataType>* out, unsigned count ) {
+    unsigned i = tFixedBatch_::add( tFixedBatch_::raw( a ), tFixedBatch_::raw( b ), tFixedBatch_::raw( out ), count );
+    for (; i < count; ++i) out[i] = a[i] + b[i];
+}
+
+/** As above, but saturating **/
+template< int QBits, typename DataType >
+void add( const tSatFixedPoint<QBits,DataType>* a, const tSatFixedPoint<QBits,DataType>* b, tSatFixedPoint<QBits,DataType>* out, unsigned count ) {
+    unsigned i = tFixedBatch_::addSaturating( tFixedBatch_::raw( a ), tFixedBatch_::raw( b ), tFixedBatch_::raw( out ), count );
+    for (; i < count; ++i) out[i] = a[i] + b[i];
+}
+
+/** out[i] = a[i] * b[i], for i = [0,count), rounding the product as for "*=" **/
+template< int QBits, typename DataType, int QBits2 >
+void mul( const tFixedPoint<QBits,DataType>* a, const tFixedPoint<QBits2,DataType>* b, tFixedPoint<QBits,DataType>* out, unsigned count ) {
+    unsigned i = tFixedBatch_::mul< false, false >( tFixedBatch_::raw( a ), tFixedBatch_::raw( b ), tFixedBatch_::raw( out ), count, QBits2 );
+    for (; i < count; ++i) (out[i] = a[i]) *= b[i];
+}
+
+/** acc[i] += a[i] * b[i], for i = [0,count), rounding the product as for "*=" **/
+template< int QBits, typename DataType, int QBits2 >
+void mac( const tFixedPoint<QBits,DataType>* a, const tFixedPoint<QBits2,DataType>* b, tFixedPoint<QBits,DataType>* acc, unsigned count ) {
+    unsigned i = tFixedBatch_::mul< false, true >( tFixedBatch_::raw( a ), tFixedBatch_::raw( b ), tFixedBatch_::raw( acc ), count, QBits2 );
+    for (; i < count; ++i) {
+        tFixedPoint<QBits,DataType> p( a[i] );
+        acc[i] += p *= b[i];
+    }
+}
+
+/** out[i] = a[i] * k, for i = [0,count), rounding the product as for "*=" **/
+template< int QBits, typename DataType, int QBits2 >
+void scale( const tFixedPoint<QBits,DataType>* a, tFixedPoint<QBits2,DataType> k, tFixedPoint<QBits,DataType>* out, unsigned count ) {
+    unsigned i = tFixedBatch_::mul< true, false >( tFixedBatch_::raw( a ), tFixedBatch_::raw( &k ), tFixedBatch_::raw( out ), count, QBits2 );
+    for (; i < count; ++i) (out[i] = a[i]) *= k;
+}
+
+/** out[i] = a[i].roundedTo( out[i] ), for i = [0,count) **/
+template< int QBits, typename DataType, int QBits2, typename DataType2 >
+void roundedTo( const tFixedPoint<QBits,DataType>* a, tFixedPoint<QBits2,DataType2>* out, unsigned count ) {
+    for (unsigned i = 0; i < count; ++i) out[i] = a[i].template roundedTo< QBits2, DataType2 >();
+}
+
+/** Returns the sum of a[i].multipliedBy( b[i] ), for i = [0,count), accumulated without any
+    rounding in a 64-bit type **/
+template< int QBits, typename DataType, int QBits2 >
+tFixedPoint<QBits+QBits2,long long> dot( const tFixedPoint<QBits,DataType>* a, const tFixedPoint<QBits2,DataType>* b, unsigned count ) {
+    long long sum = 0;
+    unsigned i = tFixedBatch_::dot( tFixedBatch_::raw( a ), tFixedBatch_::raw( b ), count, sum );
+    for (; i < count; ++i) sum += (long long)( a[i].qValue() ) * b[i].qValue();
+    return tFixedPoint<QBits+QBits2,long long>::create( sum );
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
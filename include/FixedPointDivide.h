@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides alternative division implementations for fixed-point
+//   values, including a reciprocal for dividing many values by one divisor.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTDIVIDE_H
+#define FIXEDPOINTDIVIDE_H
+
+#include "FixedPoint.h"
+#include <limits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Division
+***************************************************************************************************
+
+The division operators provided by tFixedPoint use the division of the rounding policy (see
+FixedPoint.h), which is a normal integer division. Depending on the target this may take many
+cycles, or be a library call on parts without a hardware divide (eg. Cortex-M0/M0+). This file
+provides two alternatives, both of which let you choose the number of qbits of the result,
+
+    tQ12 i = quotient< 12 >( p16, v8 );                       // exact, rounded
+    tQ12 i = quotient< 12, tReciprocalDivide >( p16, v8 );    // reciprocal based
+
+The division policy is chosen for each call rather than for each type, so "/" and "/=" always
+divide exactly. Code that should use the reciprocal division on a target without a hardware
+divide can be written with a 'Divider' template parameter of its own that it passes on to
+"quotient".
+
+The exact version pre-shifts the dividend in the double-width tWide type so it can't overflow. The
+reciprocal version uses the tReciprocal class, which calculates 1/divisor from a small table and
+two Newton-Raphson iterations using only multiplies. It is accurate to around 28 significant bits
+(an error of no more than a few LSBs for 32-bit results).
+
+The real gain comes from dividing many values by the same divisor, such as normalising by the DC
+bus voltage, since the reciprocal only needs to be calculated once,
+
+    tReciprocal< 8 > invBus( vBus8 );             // once per cycle
+    tQ15 da = invBus.divide< 15 >( va8 );         // each divide is now a multiply and shift
+    tQ15 db = invBus.divide< 15 >( vb8 );
+
+tReciprocal only supports data-types of 32 bits or less. Results which overflow the data-type
+saturate, as does dividing by zero, and are recorded as saturations when instrumentation is enabled
+(see FixedPointInstrument.h).
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Helpers for calculating normalised reciprocals **/
+struct tReciprocal_
+{
+    /** The number of bits of the normalised divisor used to index the seed table **/
+    static const unsigned cTableBits = 6;
+
+    /** Returns the seed for table entry 'index', which is 1/f for the middle of the range of
+        normalised divisors f = [0.5,1) covered by that entry, in Q30 **/
+    static constexpr unsigned seed( unsigned index )
+        { return unsigned( (1ull << (30 + cTableBits + 2)) / ((2ull << cTableBits) + 2*index + 1) ); }
+
+    /** Returns the number of leading zeros in a non-zero 'value' **/
+    static unsigned leadingZeros( unsigned value ) {
+#       if defined(__GNUC__)
+        return unsigned( __builtin_clz( value ) );
+#       else
+        unsigned n = 0;
+        while (!(value & 0x80000000u)) { value <<= 1; ++n; }
+        return n;
+#       endif
+    }
+
+    /** Returns 1/f in Q30 for the normalised divisor 'f' (the top bit of which must be set, so
+        that f represents a value in the range [0.5,1) in Q32) **/
+    static unsigned reciprocal( unsigned f ) {
+        static const unsigned cSeeds[] = {
+            seed(  0 ), seed(  1 ), seed(  2 ), seed(  3 ), seed(  4 ), seed(  5 ), seed(  6 ), seed(  7 ),
+            seed(  8 ), seed(  9 ), seed( 10 ), seed( 11 ), seed( 12 ), seed( 13 ), seed( 14 ), seed( 15 ),
+            seed( 16 ), seed( 17 ), seed( 18 ), seed( 19 ), seed( 20 ), seed( 21 ), seed( 22 ), seed( 23 ),
+            seed( 24 ), seed( 25 ), seed( 26 ), seed( 27 ), seed( 28 ), seed( 29 ), seed( 30 ), seed( 31 ),
+            seed( 32 ), seed( 33 ), seed( 34 ), seed( 35 ), seed( 36 ), seed( 37 ), seed( 38 ), seed( 39 ),
+            seed( 40 ), seed( 41 ), seed( 42 ), seed( 43 ), seed( 44 ), seed( 45 ), seed( 46 ), seed( 47 ),
+            seed( 48 ), seed( 49 ), seed( 50 ), seed( 51 ), seed( 52 ), seed( 53 ), seed( 54 ), seed( 55 ),
+            seed( 56 ), seed( 57 ), seed( 58 ), seed( 59 ), seed( 60 ), seed( 61 ), seed( 62 ), seed( 63 ) };
+
+        unsigned x = cSeeds[ (f >> (31 - cTableBits)) & ((1u << cTableBits) - 1) ];
+
+        // x' = x*(2 - f*x), each iteration roughly doubles the number of correct bits
+        for (int i = 0; i < 2; ++i) {
+            const unsigned fx = unsigned( ((unsigned long long)( f ) * x) >> 32 );
+            x = unsigned( ((unsigned long long)( x ) * ((1u << 31) - fx)) >> 30 );
+        }
+        return x;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** This class holds the reciprocal of a fixed-point divisor, with 'QBits' qbits, so that values can
+    be divided by it using just a multiply and a shift **/
+template< int QBits, typename DataType = int >
+class tReciprocal
+{
+    static_assert( sizeof(DataType) <= sizeof(unsigned), "tReciprocal only supports data-types of 32 bits or less" );
+
+public:
+    typedef tFixedPoint< QBits, DataType > tDivisor;
+
+    tReciprocal() : x_(), shift_(), negative_() {}
+    explicit tReciprocal( const tDivisor& divisor ) { set( divisor ); }
+
+    /** Calculates the reciprocal of a new 'divisor' **/
+    void set( const tDivisor& divisor ) {
+        FIXEDPOINT_PROFILE( "reciprocal" );
+        const DataType d = divisor.qValue();
+        negative_ = (d < 0);
+        const unsigned m = negative_? (0u - unsigned( d )) : unsigned( d );
+        if (m == 0) {
+            x_ = 0;
+            shift_ = 0;         // treated as an overflow by "divide" so that the result saturates
+        } else {
+            const unsigned n = tReciprocal_::leadingZeros( m );
+            x_ = tReciprocal_::reciprocal( m << n );
+            shift_ = 62 - QBits - int( n );
+        }
+    }
+
+    /** Returns 'dividend' divided by the divisor, as a fixed-point value with 'QOut' qbits **/
+    template< int QOut, int QBits2, typename DataType2 > tFixedPoint<QOut,DataType2> divide( tFixedPoint<QBits2,DataType2> dividend ) const {
+        static_assert( sizeof(DataType2) <= sizeof(unsigned), "tReciprocal only supports data-types of 32 bits or less" );
+        typedef std::numeric_limits<DataType2> tLimits;
+
+        const DataType2 a = dividend.qValue();
+        const bool negative = (a < 0) != negative_;
+        const unsigned long long p = (unsigned long long)( (a < 0)? (0u - unsigned( a )) : unsigned( a ) ) * x_;
+        const int shift = shift_ + QBits2 - QOut;
+
+        // result is the rounded value of "p >> shift", saturating anything too large for DataType2
+        const unsigned long long q = (shift <= 0 || x_ == 0)? ~0ull : (shift >= 64)? 0 : ((p >> (shift - 1)) + 1) >> 1;
+        const unsigned long long cMax = (unsigned long long)( tLimits::max() );
+        return tFixedPoint<QOut,DataType2>::create( FIXEDPOINT_IMPL_RECORD( QOut, DataType2, cFixedPointSaturate, (q > cMax),
+                negative? ((q > cMax)? tLimits::min() : DataType2( -(long long)( q ) )) : ((q > cMax)? tLimits::max() : DataType2( q )) ) );
+    }
+
+private:
+    unsigned  x_;           // 1/f in Q30, where f is the normalised divisor
+    int       shift_;       // the shift needed to scale the product by x_ to the right precision
+    bool      negative_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Division Helpers
+
+/** Division policy that pre-shifts the dividend in the double-width tWide type (or the divisor,
+    if 'QOut' has fewer qbits than the dividend less the divisor's), and then uses the
+    FIXEDPOINT_ROUNDING policy to round the result. A result too large for DataType wraps, as for
+    the tFixedPoint operators, and is recorded when instrumentation is enabled **/
+struct tExactDivide
+{
+    template< int QOut, int QBits, typename DataType, int QBits2, typename DataType2 >
+    static tFixedPoint<QOut,DataType> divide( tFixedPoint<QBits,DataType> dividend, tFixedPoint<QBits2,DataType2> divisor ) {
+        typedef typename tFixedPoint<QBits,DataType>::tWide tWide;
+        enum { cShift = QOut - QBits + QBits2 };
+        const tWide a = FIXEDPOINT_IMPL_SHIFTUP( tWide( dividend.qValue() ), (cShift > 0)? int( cShift ) : 0 );
+        const tWide b = FIXEDPOINT_IMPL_SHIFTUP( tWide( divisor.qValue() ), (cShift < 0)? -int( cShift ) : 0 );
+        return tFixedPoint<QOut,DataType>::create( tFixedPointCheck_::wrapped< QOut, DataType >( tFixedPointCheck_::divide( a, b ) ) );
+    }
+};
+
+/** Division policy that multiplies by the reciprocal of the divisor, see tReciprocal **/
+struct tReciprocalDivide
+{
+    template< int QOut, int QBits, typename DataType, int QBits2, typename DataType2 >
+    static tFixedPoint<QOut,DataType> divide( tFixedPoint<QBits,DataType> dividend, tFixedPoint<QBits2,DataType2> divisor )
+        { return tReciprocal<QBits2,DataType2>( divisor ).template divide< QOut >( dividend ); }
+};
+
+/** Returns 'dividend' divided by 'divisor' as a fixed-point value with 'QOut' qbits, using the
+    division policy specified by 'Divider' (tExactDivide or tReciprocalDivide) **/
+template< int QOut, typename Divider = tExactDivide, int QBits, typename DataType, int QBits2, typename DataType2 >
+tFixedPoint<QOut,DataType> quotient( tFixedPoint<QBits,DataType> dividend, tFixedPoint<QBits2,DataType2> divisor ) {
+    FIXEDPOINT_PROFILE( "quotient" );
+    return Divider::template divide< QOut >( dividend, divisor );
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides conversions between fixed-point values and decimal
+//   text, without using printf or floating-point.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTFORMAT_H
+#define FIXEDPOINTFORMAT_H
+
+#include "FixedPoint.h"
+#include <limits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Decimal Text
+***************************************************************************************************
+
+The "toChars" function writes a fixed-point value as decimal text directly into a buffer, rounded
+to the number of decimal places given, and returns a pointer to the terminating null so that
+several values can be written one after another,
+
+    char line[64];
+    char* p = toChars( line, id16, 3 );          // eg. "-12.345"
+    *p++ = ',';
+    p = toChars( p, iq16, 3 );
+    uartWrite( line );
+
+The fractional digits take a single multiply by 10^decimals and a shift (rather than a loop over
+the qbits), and the remaining work is a division by 10 for each digit written, which compilers turn
+into a multiply. The buffer needs room for a sign, the integer digits, the point, the decimals and
+the null - 24 characters plus the number of decimals is always enough.
+
+The "fromChars" function parses text of the form "-12.345" (an optional sign, digits, and an
+optional point and fractional digits), rounding to the nearest qValue. It returns a pointer to the
+first character that wasn't used, or 'first' if no number was found (in which case the value isn't
+changed), in the same way as std::from_chars,
+
+    const char* end = fromChars( text, text + length, limit16 );
+    if (end == text) reportError();
+
+Both handle up to FIXEDPOINT_FORMAT_DECIMALS (default 9) decimal places, limited further so that
+the qbits plus 3.33 bits per decimal place fit in 64 bits. Any further decimals are written as 0,
+or ignored when parsing.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The maximum number of decimal places written and parsed **/
+#ifndef FIXEDPOINT_FORMAT_DECIMALS
+#define FIXEDPOINT_FORMAT_DECIMALS  9
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedPointFormat_
+{
+    typedef unsigned long long tULL;
+
+    /** Returns the number of decimal places that can be handled for a value with 'qBits' qbits,
+        which is when 2^qBits * 10^decimals still fits in 64 bits **/
+    static constexpr unsigned maxDecimals( unsigned qBits, unsigned decimals = 0 )
+        { return ((decimals < FIXEDPOINT_FORMAT_DECIMALS) && (power( decimals + 1 ) <= (~0ull >> qBits)))
+                 ? maxDecimals( qBits, decimals + 1 ) : decimals; }
+    static constexpr tULL power( unsigned decimals ) { return (decimals == 0)? 1 : 10*power( decimals - 1 ); }
+
+    /** Writes the 'digits' least significant decimal digits of 'value' to 'buffer', returning the
+        position after them. Once the value fits in 32 bits the rest of the digits are done with
+        32-bit divisions, as 64-bit divisions are library calls on 32-bit targets **/
+    static char* digits( char* buffer, tULL value, unsigned digits ) {
+        char* end = buffer + digits;
+        for (; digits > 0 && value > 0xFFFFFFFFu; --digits, value /= 10) buffer[digits - 1] = char( '0' + value % 10 );
+        for (unsigned v = unsigned( value ); digits > 0; --digits, v /= 10) buffer[digits - 1] = char( '0' + v % 10 );
+        return end;
+    }
+
+    /** Returns the number of decimal digits needed for 'value' (at least 1) **/
+    static unsigned length( tULL value ) {
+        unsigned n = 1;
+        for (; value > 0xFFFFFFFFu; value /= 10) ++n;
+        for (unsigned v = unsigned( value ); v >= 10; v /= 10) ++n;
+        return n;
+    }
+
+    static bool isDigit( char c ) { return (c >= '0') && (c <= '9'); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+/** Writes 'value' to 'buffer' as decimal text rounded to 'decimals' places, and returns a pointer
+    to the null that terminates it **/
+template< int QBits, typename DataType > char* toChars( char* buffer, tFixedPoint<QBits,DataType> value, unsigned decimals ) {
+    typedef tFixedPointFormat_::tULL tULL;
+    const unsigned cMaxDecimals = tFixedPointFormat_::maxDecimals( QBits );
+    const tULL cMask = (tULL(1) << QBits) - 1;
+
+    // the magnitude is unsigned so that the most negative value is handled
+    bool negative = value.qValue() < 0;
+    tULL magnitude = negative? 0 - tULL( value.qValue() ) : tULL( value.qValue() );
+    tULL intPart = magnitude >> QBits;
+
+    unsigned places = (decimals < cMaxDecimals)? decimals : cMaxDecimals;
+    tULL scale = tFixedPointDecimal_<>::power( places );
+    tULL frac = ((magnitude & cMask) * scale + ((tULL(1) << QBits) >> 1)) >> QBits;
+    if (frac == scale) {
+        frac = 0;
+        ++intPart;
+    }
+
+    if (negative && (intPart != 0 || frac != 0)) *buffer++ = '-';
+    buffer = tFixedPointFormat_::digits( buffer, intPart, tFixedPointFormat_::length( intPart ) );
+    if (decimals > 0) {
+        *buffer++ = '.';
+        buffer = tFixedPointFormat_::digits( buffer, frac, places );
+        for (unsigned i = places; i < decimals; ++i) *buffer++ = '0';
+    }
+    *buffer = '\0';
+    return buffer;
+}
+
+/** Parses the decimal text from 'first' up to 'last' into 'value', see above. Integer parts that
+    don't fit wrap in the same way as the arithmetic operators **/
+template< int QBits, typename DataType > const char* fromChars( const char* first, const char* last, tFixedPoint<QBits,DataType>& value ) {
+    typedef tFixedPointFormat_::tULL tULL;
+    const unsigned cMaxDecimals = tFixedPointFormat_::maxDecimals( QBits );
+
+    const char* p = first;
+    bool negative = (p != last) && (*p == '-');
+    if (p != last && (*p == '-' || *p == '+')) ++p;
+    if (negative && !std::numeric_limits<DataType>::is_signed) return first;
+
+    const char* start = p;
+    tULL intPart = 0;
+    for (; p != last && tFixedPointFormat_::isDigit( *p ); ++p) intPart = intPart*10 + tULL( *p - '0' );
+    bool any = (p != start);
+
+    // the fractional digits are accumulated as an integer, then scaled to qbits with a single
+    // rounded division by the matching power of 10
+    tULL frac = 0;
+    unsigned places = 0;
+    if (p != last && *p == '.') {
+        const char* fracStart = ++p;
+        for (; p != last && tFixedPointFormat_::isDigit( *p ); ++p) {
+            if (places < cMaxDecimals) {
+                frac = frac*10 + tULL( *p - '0' );
+                ++places;
+            }
+        }
+        any = any || (p != fracStart);
+    }
+    if (!any) return first;
+
+    tULL scale = tFixedPointDecimal_<>::power( places );
+    tULL magnitude = (intPart << QBits) + ((frac << QBits) + scale/2) / scale;
+    value = tFixedPoint<QBits,DataType>::create( tFixedPointCheck_::wrapped< QBits, DataType >( negative? -(long long)( magnitude ) : (long long)( magnitude ) ) );
+    return p;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides the run-time counters used when fixed-point
+//   instrumentation is enabled.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTINSTRUMENT_H
+#define FIXEDPOINTINSTRUMENT_H
+
+#include <limits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Instrumentation
+***************************************************************************************************
+
+Defining FIXEDPOINT_ENABLE_INSTRUMENTATION (before including FixedPoint.h, normally on the compiler
+command line) makes the fixed-point operations count the following events, separately for each
+fixed-point type (number of qbits and data-type) the event's result has,
+
+    wraps               a result didn't fit in its data-type and wrapped around.
+    saturations         a tSatFixedPoint result was clamped (or landed exactly on a limit).
+    rounding losses     a "roundedTo" or "truncatedTo" conversion discarded non-zero bits.
+
+Wraps can't be detected for 64-bit data-types, as there is no wider type to check them with.
+
+Events can also be counted against call sites, by placing FIXEDPOINT_SITE() at the start of a
+block of code. Events from that point until the end of the enclosing scope are recorded against
+its file and line, as well as the type. Up to FIXEDPOINT_INSTRUMENT_SITES sites are recorded.
+
+The counters can be written out with any function that writes a string (eg. to a UART or a CAN
+debug channel), then cleared,
+
+    fixedPointDumpStats( uartWrite );       // void uartWrite( const char* text )
+    fixedPointResetStats();
+
+which writes a line for each type and site that has had an event, such as
+
+    Q12 int16: wraps 3, saturations 0, rounding losses 1204
+    src/Foc.cpp:88: wraps 3, saturations 0, rounding losses 0
+
+When FIXEDPOINT_ENABLE_INSTRUMENTATION isn't defined none of this is compiled in, FIXEDPOINT_SITE()
+expands to nothing, and the fixed-point operations are unchanged. The counters aren't protected
+from interrupts, so counts from code running at different priorities may occasionally be lost.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The maximum number of call sites recorded **/
+#ifndef FIXEDPOINT_INSTRUMENT_SITES
+#define FIXEDPOINT_INSTRUMENT_SITES  32
+#endif
+
+#define FIXEDPOINT_IMPL_SITE_NAME2( line )  fixedPointSite_##line
+#define FIXEDPOINT_IMPL_SITE_NAME( line )   FIXEDPOINT_IMPL_SITE_NAME2( line )
+
+/** Records events until the end of the enclosing scope against the current file and line **/
+#define FIXEDPOINT_SITE()  tFixedPointSite_ FIXEDPOINT_IMPL_SITE_NAME( __LINE__ )( __FILE__, __LINE__ )
+
+/** Used by the fixed-point classes to record an 'event' for the type with 'qbits' and 'type' if
+    'condition' is true, the result of the macro is always (...) **/
+#define FIXEDPOINT_IMPL_RECORD( qbits, type, event, condition, ... )  \
+    ((void)( (condition) && tFixedPointStats< qbits, type >::record( event ) ), (__VA_ARGS__))
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** The events that are counted **/
+enum tFixedPointEvent { cFixedPointWrap, cFixedPointSaturate, cFixedPointRoundingLoss, cFixedPointEvents };
+
+/** The counters for one type or call site **/
+struct tFixedPointCounters_
+{
+    unsigned long counts[cFixedPointEvents];
+
+    bool any() const { for (int i = 0; i < cFixedPointEvents; ++i) if (counts[i] != 0) return true; return false; }
+    void reset() { for (int i = 0; i < cFixedPointEvents; ++i) counts[i] = 0; }
+};
+
+/** The counters for one fixed-point type, which add themselves to a list when they are first used **/
+struct tFixedPointTypeStats_
+{
+    tFixedPointTypeStats_( unsigned qBits, unsigned bits, bool isSigned );
+
+    unsigned                qBits;
+    unsigned                bits;
+    bool                    isSigned;
+    tFixedPointCounters_    counters;
+    tFixedPointTypeStats_*  next;
+};
+
+/** The counters for one call site **/
+struct tFixedPointSiteStats_
+{
+    const char*             file;
+    unsigned                line;
+    tFixedPointCounters_    counters;
+};
+
+/** The shared state, the unused template parameter allows it to be defined in this header **/
+template< int Unused = 0 > struct tFixedPointInstrument_
+{
+    static tFixedPointTypeStats_*  types;
+    static tFixedPointSiteStats_   sites[FIXEDPOINT_INSTRUMENT_SITES];
+    static unsigned                siteCount;
+    static tFixedPointSiteStats_*  site;
+
+    /** Returns the counters for a call site, or null if there is no room for it **/
+    static tFixedPointSiteStats_* find( const char* file, unsigned line ) {
+        for (unsigned i = 0; i < siteCount; ++i)
+            if (sites[i].line == line && sites[i].file == file) return &sites[i];
+        if (siteCount == FIXEDPOINT_INSTRUMENT_SITES) return 0;
+        tFixedPointSiteStats_& s = sites[siteCount++];
+        s.file = file;
+        s.line = line;
+        s.counters.reset();
+        return &s;
+    }
+
+    /** Writes 'counters' using 'write', with the 'name' of what they are for **/
+    template< typename Writer > static void dump( Writer write, const char* name, const tFixedPointCounters_& counters ) {
+        static const char* const cLabels[cFixedPointEvents] = { ": wraps ", ", saturations ", ", rounding losses " };
+        write( name );
+        for (int i = 0; i < cFixedPointEvents; ++i) {
+            char digits[24];
+            write( cLabels[i] );
+            write( format( digits, counters.counts[i] ) );
+        }
+        write( "\n" );
+    }
+
+    /** Formats 'value' as decimal into 'buffer', and returns 'buffer' **/
+    static char* format( char* buffer, unsigned long value ) {
+        char reversed[24];
+        int n = 0;
+        do { reversed[n++] = char( '0' + value % 10 ); value /= 10; } while (value != 0);
+        for (int i = 0; i < n; ++i) buffer[i] = reversed[n - 1 - i];
+        buffer[n] = '\0';
+        return buffer;
+    }
+};
+
+template< int Unused > tFixedPointTypeStats_* tFixedPointInstrument_< Unused >::types = 0;
+template< int Unused > tFixedPointSiteStats_ tFixedPointInstrument_< Unused >::sites[FIXEDPOINT_INSTRUMENT_SITES];
+template< int Unused > unsigned tFixedPointInstrument_< Unused >::siteCount = 0;
+template< int Unused > tFixedPointSiteStats_* tFixedPointInstrument_< Unused >::site = 0;
+
+inline tFixedPointTypeStats_::tFixedPointTypeStats_( unsigned qBits_, unsigned bits_, bool isSigned_ )
+    : qBits( qBits_ ), bits( bits_ ), isSigned( isSigned_ ), counters(), next( tFixedPointInstrument_<>::types )
+{
+    tFixedPointInstrument_<>::types = this;
+}
+
+/** Records events for the call site it is constructed with, until it is destroyed **/
+class tFixedPointSite_
+{
+public:
+    tFixedPointSite_( const char* file, unsigned line ) : previous_( tFixedPointInstrument_<>::site )
+        { tFixedPointInstrument_<>::site = tFixedPointInstrument_<>::find( file, line ); }
+    ~tFixedPointSite_() { tFixedPointInstrument_<>::site = previous_; }
+
+private:
+    tFixedPointSite_( const tFixedPointSite_& );
+    tFixedPointSite_& operator=( const tFixedPointSite_& );
+
+    tFixedPointSiteStats_*  previous_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Type Statistics
+
+/** The counters for the fixed-point type with 'QBits' and 'DataType' **/
+template< int QBits, typename DataType >
+struct tFixedPointStats
+{
+    /** Returns the counters for this type **/
+    static tFixedPointTypeStats_& stats() {
+        static tFixedPointTypeStats_ s( QBits, unsigned( sizeof(DataType)*8 ), std::numeric_limits<DataType>::is_signed );
+        return s;
+    }
+
+    /** Counts an 'event' against this type and the current call site. Always returns true so that
+        it can be used in the FIXEDPOINT_IMPL_RECORD macro **/
+    static bool record( tFixedPointEvent event ) {
+        ++stats().counters.counts[event];
+        if (tFixedPointInstrument_<>::site) ++tFixedPointInstrument_<>::site->counters.counts[event];
+        return true;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+/** Writes a line for each type and call site that has had events, using 'write' which is called
+    with a series of null-terminated strings **/
+template< typename Writer > void fixedPointDumpStats( Writer write ) {
+    typedef tFixedPointInstrument_<> tInstrument;
+    for (const tFixedPointTypeStats_* t = tInstrument::types; t; t = t->next) {
+        if (!t->counters.any()) continue;
+        char name[32], digits[24];
+        char* p = name;
+        *p++ = 'Q';
+        for (const char* d = tInstrument::format( digits, t->qBits ); *d; ) *p++ = *d++;
+        *p++ = ' ';
+        if (!t->isSigned) *p++ = 'u';
+        *p++ = 'i'; *p++ = 'n'; *p++ = 't';
+        for (const char* d = tInstrument::format( digits, t->bits ); *d; ) *p++ = *d++;
+        *p = '\0';
+        tInstrument::dump( write, name, t->counters );
+    }
+    for (unsigned i = 0; i < tInstrument::siteCount; ++i) {
+        const tFixedPointSiteStats_& s = tInstrument::sites[i];
+        if (!s.counters.any()) continue;
+        char digits[24];
+        write( s.file );
+        write( ":" );
+        tInstrument::dump( write, tInstrument::format( digits, s.line ), s.counters );
+    }
+}
+
+/** Clears all of the counters **/
+inline void fixedPointResetStats() {
+    typedef tFixedPointInstrument_<> tInstrument;
+    for (tFixedPointTypeStats_* t = tInstrument::types; t; t = t->next) t->counters.reset();
+    for (unsigned i = 0; i < tInstrument::siteCount; ++i) tInstrument::sites[i].counters.reset();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,358 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides trigonometric and other transcendental functions for
+//   fixed-point values, without the need for any floating-point support.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTMATH_H
+#define FIXEDPOINTMATH_H
+
+#include "FixedPoint.h"
+#include "FixedPointDivide.h"
+#include <limits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Maths Functions
+***************************************************************************************************
+
+This file provides the following functions for fixed-point values, all of which take the number of
+qbits of the result 'QOut' as their first template argument (the result has the same data-type as
+the argument),
+
+    sin< QOut >( angle )            cos< QOut >( angle )            sincos< QOut >( angle )
+    atan2< QOut >( y, x )           sqrt< QOut >( value )           rsqrt< QOut >( value )
+
+For example,
+
+    typedef tFixedPoint< 12 > tQ12;        // angle in radians
+    typedef tFixedPoint< 15 > tQ15;
+
+    tSinCos< 15 > sc = sincos< 15 >( theta12 );
+    tQ15 d = (ia.multipliedBy( sc.cos ) + ib.multipliedBy( sc.sin )).roundedTo< 15, int >();
+
+Angles are in radians. Internally they are converted to a 32-bit phase where the full range of the
+word represents one turn, so any angle (including negative ones) is reduced modulo 2*pi for free. For
+angles that are accumulated, such as a rotor position, tFixedAngle (see FixedAngle.h) holds the
+phase itself, and the trig functions can be given one directly.
+
+"sin", "cos" and "sincos" use a quarter-wave table of sin values with linear interpolation. The
+"sincos" function is intended for the Park/inverse-Park transforms, and shares the angle reduction
+and table lookup between the two results. The table resolution is set at compile-time by the
+FIXEDPOINT_SIN_TABLE_BITS macro (the log2 of the number of entries per turn, default 10 which gives
+an error of about 5e-6 using 1KB of table), and the table itself is generated at compile-time.
+
+"atan2" uses CORDIC vectoring with FIXEDPOINT_CORDIC_ITERATIONS iterations (default 24), and
+needs no division. "sqrt" and "rsqrt" use a table seeded Newton-Raphson iteration for 1/sqrt(x)
+and are accurate to a few LSBs of a 32-bit result.
+
+Results which don't fit the data-type saturate, so for instance "sin< 15, 12, short >" will give
+32767 for an angle of pi/2. The functions only support data-types of 32 bits or less.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The log2 of the number of entries in the sin table, per turn **/
+#ifndef FIXEDPOINT_SIN_TABLE_BITS
+#define FIXEDPOINT_SIN_TABLE_BITS  10
+#endif
+
+/** The number of iterations used by CORDIC based functions, each gives roughly one more bit of
+    accuracy **/
+#ifndef FIXEDPOINT_CORDIC_ITERATIONS
+#define FIXEDPOINT_CORDIC_ITERATIONS  24
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Compile-Time Tables
+
+/** These templates are used to generate index sequences so that tables can be filled in by a
+    constexpr generator function at compile time. The sequence is built by repeatedly halving
+    the size to keep the template recursion shallow for large tables **/
+template< unsigned... I > struct tFixedIndices_ {};
+
+template< typename A, typename B > struct tFixedIndicesJoin_;
+template< unsigned... I, unsigned... J > struct tFixedIndicesJoin_< tFixedIndices_<I...>, tFixedIndices_<J...> >
+    { typedef tFixedIndices_< I..., (sizeof...(I) + J)... > type; };
+
+template< unsigned N > struct tFixedMakeIndices_
+    { typedef typename tFixedIndicesJoin_< typename tFixedMakeIndices_<N/2>::type, typename tFixedMakeIndices_<N - N/2>::type >::type type; };
+template<> struct tFixedMakeIndices_< 0 > { typedef tFixedIndices_<> type; };
+template<> struct tFixedMakeIndices_< 1 > { typedef tFixedIndices_<0> type; };
+
+/** A fixed-size table of values, which can be returned by constexpr functions **/
+template< typename T, unsigned N > struct tFixedTable_
+{
+    T values[N];
+    constexpr const T& operator[]( unsigned index ) const { return values[index]; }
+};
+
+/** Compile-time maths, used to generate tables. These are only ever evaluated by the compiler
+    so don't require floating-point support on the target **/
+struct tFixedConstMath_
+{
+    static constexpr double cPi = 3.14159265358979323846;
+
+    static constexpr double sinSeries( double x2, double term, int n, double sum )
+        { return (n > 30)? sum : sinSeries( x2, -term*x2/((n+1)*(n+2)), n+2, sum + term ); }
+    static constexpr double sin( double x ) { return sinSeries( x*x, x, 1, 0.0 ); }
+
+    static constexpr double atanSeries( double x2, double term, int n, double sum )
+        { return (n > 81)? sum : atanSeries( x2, -term*x2, n+2, sum + term/n ); }
+    static constexpr double atan( double x )           // only valid for |x| <= 0.5
+        { return atanSeries( x*x, x, 1, 0.0 ); }
+
+    static constexpr double sqrtIterate( double x, double y, int n ) { return (n == 0)? y : sqrtIterate( x, (y + x/y)/2, n-1 ); }
+    static constexpr double sqrt( double x ) { return sqrtIterate( x, (x > 1)? x : 1.0, 40 ); }
+
+    static constexpr long long rounded( double x ) { return (long long)( (x >= 0)? (x + 0.5) : (x - 0.5) ); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Helpers implementing the maths functions on raw values. Angles are a 32-bit phase where 2^32
+    is one turn, and results are generally in Q30 **/
+struct tFixedMath_
+{
+    static const unsigned cSinTableBits = FIXEDPOINT_SIN_TABLE_BITS - 2;        // per quarter turn
+    static const unsigned cSinTableSize = (1u << cSinTableBits) + 2;
+    static const unsigned cRSqrtTableBits = 6;
+
+    /** Table generators **/
+    static constexpr int sinEntry( unsigned i )
+        { return int( tFixedConstMath_::rounded( tFixedConstMath_::sin( tFixedConstMath_::cPi/2 * i / (1u << cSinTableBits) ) * (1 << 30) ) ); }
+    static constexpr unsigned atanEntry( unsigned i )     // atan(2^-i) as a phase, using atan(x) = 2*atan(x/(1+sqrt(1+x^2)))
+        { return unsigned( tFixedConstMath_::rounded( 2*tFixedConstMath_::atan( 1.0/(1ull << i) / (1 + tFixedConstMath_::sqrt( 1 + 1.0/(1ull << (2*i)) )) )
+                                                      / (2*tFixedConstMath_::cPi) * 4294967296.0 ) ); }
+    static constexpr unsigned rsqrtEntry( unsigned i )    // 1/sqrt(f) in Q30 for the middle of each range of f = i/2^cRSqrtTableBits
+        { return unsigned( tFixedConstMath_::rounded( (1 << 30) / tFixedConstMath_::sqrt( (i + 0.5) / (1u << cRSqrtTableBits) ) ) ); }
+
+    template< unsigned... I > static constexpr tFixedTable_< int, sizeof...(I) > sinTable( tFixedIndices_<I...> ) { return {{ sinEntry( I )... }}; }
+    template< unsigned... I > static constexpr tFixedTable_< unsigned, sizeof...(I) > atanTable( tFixedIndices_<I...> ) { return {{ atanEntry( I )... }}; }
+    template< unsigned... I > static constexpr tFixedTable_< unsigned, sizeof...(I) > rsqrtTable( tFixedIndices_<I...> ) { return {{ rsqrtEntry( I )... }}; }
+
+    /** The tables themselves, the unused template parameter allows them to be defined in this
+        header **/
+    template< int Unused = 0 > struct tTables
+    {
+        static constexpr tFixedTable_< int, cSinTableSize > cSin = sinTable( tFixedMakeIndices_< cSinTableSize >::type() );
+        static constexpr tFixedTable_< unsigned, FIXEDPOINT_CORDIC_ITERATIONS > cAtan = atanTable( tFixedMakeIndices_< FIXEDPOINT_CORDIC_ITERATIONS >::type() );
+        static constexpr tFixedTable_< unsigned, (1u << cRSqrtTableBits) > cRSqrt = rsqrtTable( tFixedMakeIndices_< (1u << cRSqrtTableBits) >::type() );
+    };
+
+    /** Shifts 'value' from 'fromQ' to 'toQ' qbits, rounding if precision is lost **/
+    static long long rescaled( long long value, int fromQ, int toQ )
+        { return (toQ >= fromQ)? value * (1ll << (toQ - fromQ)) : ((value + (1ll << (fromQ - toQ - 1))) >> (fromQ - toQ)); }
+
+    /** Clamps 'value' to the range of DataType **/
+    template< typename DataType > static DataType clamped( long long value ) {
+        typedef std::numeric_limits<DataType> tLimits;
+        return (value > (long long)( tLimits::max() ))? tLimits::max() : (value < (long long)( tLimits::min() ))? tLimits::min() : DataType( value );
+    }
+
+    /** Converts an angle in radians, with 'qBits' qbits, to a phase **/
+    static unsigned phase( long long radians, unsigned qBits ) {
+        const long long cTurnsPerRadian = 2734261102ll;      // 2^34/(2*pi)
+        return unsigned( (unsigned long long)( (radians * cTurnsPerRadian) >> (qBits + 2) ) );
+    }
+
+    /** Converts a phase to an angle in radians with 'qBits' qbits **/
+    static long long radians( int phase, unsigned qBits ) {
+        const long long cRadiansPerTurn = 1686629713ll;      // 2*pi*2^28
+        return rescaled( phase * cRadiansPerTurn, 60, int( qBits ) );
+    }
+
+    /** Returns sin of the first quadrant 'angle', where 2^30 is a quarter turn, in Q30 **/
+    static int quarterSin( unsigned angle ) {
+        const unsigned cFracBits = 30 - cSinTableBits;
+        const unsigned index = angle >> cFracBits;
+        const int frac = int( angle & ((1u << cFracBits) - 1) );
+        const int a = tTables<>::cSin[index];
+        const int b = tTables<>::cSin[index + 1];
+        return a + int( ((long long)( b - a ) * frac) >> cFracBits );
+    }
+
+    /** Returns sin of a 'phase', in Q30 **/
+    static int sin( unsigned phase ) {
+        const unsigned quadrant = phase >> 30;
+        const unsigned angle = phase & ((1u << 30) - 1);
+        const int s = quarterSin( (quadrant & 1)? ((1u << 30) - angle) : angle );
+        return (quadrant & 2)? -s : s;
+    }
+
+    /** Returns the phase of the vector (x,y), and its magnitude multiplied by the CORDIC gain in
+        'magnitude' which has the same scale as x and y shifted left by 'scale' bits **/
+    static unsigned atan2( long long x, long long y, long long& magnitude, int& scale ) {
+        unsigned angle = 0;
+        if (x < 0) {
+            x = -x;
+            y = -y;
+            angle = 1u << 31;
+        }
+
+        // normalise so the largest of x and y lies in [2^28, 2^29), leaving room for the gain
+        const unsigned long long m = (unsigned long long)( x ) | (unsigned long long)( (y < 0)? -y : y );
+        scale = 0;
+        if (m == 0) {
+            magnitude = 0;
+            return 0;
+        }
+        if (m < (1ull << 28)) {
+            while ((m << scale) < (1ull << 28)) ++scale;
+        } else {
+            while ((m >> -scale) >= (1ull << 29)) --scale;
+        }
+        x = (scale >= 0)? (x << scale) : (x >> -scale);
+        y = (scale >= 0)? ((long long)( (unsigned long long)( y ) << scale )) : (y >> -scale);
+
+        for (unsigned i = 0; i < FIXEDPOINT_CORDIC_ITERATIONS; ++i) {
+            const long long dx = y >> i;
+            const long long dy = x >> i;
+            if (y > 0) {
+                x += dx;
+                y -= dy;
+                angle += tTables<>::cAtan[i];
+            } else {
+                x -= dx;
+                y += dy;
+                angle -= tTables<>::cAtan[i];
+            }
+        }
+        magnitude = x;
+        return angle;
+    }
+
+    /** Returns 1/sqrt(f) in Q30 for a normalised 'f' in the range [0.25,1) in Q32 **/
+    static unsigned rsqrt( unsigned f ) {
+        unsigned y = tTables<>::cRSqrt[ f >> (32 - cRSqrtTableBits) ];
+
+        // y' = y*(3 - f*y^2)/2
+        for (int i = 0; i < 2; ++i) {
+            const unsigned long long y2 = ((unsigned long long)( y ) * y) >> 30;
+            const unsigned long long fy2 = (f * y2) >> 32;
+            y = unsigned( ((unsigned long long)( y ) * ((3ull << 30) - fy2)) >> 31 );
+        }
+        return y;
+    }
+
+    /** Returns the normalised mantissa of 'value' (see above "rsqrt") and its exponent 'e', such
+        that value = f * 2^e / 2^qBits. The exponent is always even **/
+    static unsigned normalised( unsigned value, unsigned qBits, int& e ) {
+        int n = int( tReciprocal_::leadingZeros( value ) );
+        n -= (n - int( qBits )) & 1;
+        e = 32 - n - int( qBits );
+        return (n >= 0)? (value << n) : (value >> 1);
+    }
+};
+
+template< int Unused > constexpr tFixedTable_< int, tFixedMath_::cSinTableSize > tFixedMath_::tTables< Unused >::cSin;
+template< int Unused > constexpr tFixedTable_< unsigned, FIXEDPOINT_CORDIC_ITERATIONS > tFixedMath_::tTables< Unused >::cAtan;
+template< int Unused > constexpr tFixedTable_< unsigned, (1u << tFixedMath_::cRSqrtTableBits) > tFixedMath_::tTables< Unused >::cRSqrt;
+
+
+//-------------------------------------------------------------------------------------------------
+// Trigonometric Functions
+
+/** Holds the result of the "sincos" function **/
+template< int QBits, typename DataType = int >
+struct tSinCos
+{
+    tFixedPoint< QBits, DataType > sin;
+    tFixedPoint< QBits, DataType > cos;
+};
+
+/** Return the sin, cos, or both, of an 'angle' in radians, with 'QOut' qbits **/
+template< int QOut, int QBits, typename DataType > tFixedPoint<QOut,DataType> sin( tFixedPoint<QBits,DataType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "sin" );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>(
+            tFixedMath_::rescaled( tFixedMath_::sin( tFixedMath_::phase( angle.qValue(), QBits ) ), 30, QOut ) ) );
+}
+
+template< int QOut, int QBits, typename DataType > tFixedPoint<QOut,DataType> cos( tFixedPoint<QBits,DataType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "cos" );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>(
+            tFixedMath_::rescaled( tFixedMath_::sin( tFixedMath_::phase( angle.qValue(), QBits ) + (1u << 30) ), 30, QOut ) ) );
+}
+
+template< int QOut, int QBits, typename DataType > tSinCos<QOut,DataType> sincos( tFixedPoint<QBits,DataType> angle ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "sincos" );
+    const unsigned phase = tFixedMath_::phase( angle.qValue(), QBits );
+    tSinCos<QOut,DataType> result;
+    result.sin = tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( phase ), 30, QOut ) ) );
+    result.cos = tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::sin( phase + (1u << 30) ), 30, QOut ) ) );
+    return result;
+}
+
+/** Returns the angle in radians, in the range [-pi,pi), of the vector ('x','y') **/
+template< int QOut, int QBits, typename DataType > tFixedPoint<QOut,DataType> atan2( tFixedPoint<QBits,DataType> y, tFixedPoint<QBits,DataType> x ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "atan2" );
+    long long magnitude;
+    int scale;
+    const int phase = int( tFixedMath_::atan2( x.qValue(), y.qValue(), magnitude, scale ) );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::radians( phase, QOut ) ) );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Roots
+
+/** Returns the square-root of 'value', with 'QOut' qbits. Negative values give 0 **/
+template< int QOut, int QBits, typename DataType > tFixedPoint<QOut,DataType> sqrt( tFixedPoint<QBits,DataType> value ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "sqrt" );
+    if (value.qValue() <= 0) return tFixedPoint<QOut,DataType>::create( 0 );
+
+    // sqrt(f * 2^e) = f * 1/sqrt(f) * 2^(e/2)
+    int e;
+    const unsigned f = tFixedMath_::normalised( unsigned( value.qValue() ), QBits, e );
+    const long long s = (long long)( ((unsigned long long)( f ) * tFixedMath_::rsqrt( f )) >> 32 );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( s, 30 - e/2, QOut ) ) );
+}
+
+/** Returns the reciprocal of the square-root of 'value', with 'QOut' qbits. Values less than or
+    equal to zero saturate **/
+template< int QOut, int QBits, typename DataType > tFixedPoint<QOut,DataType> rsqrt( tFixedPoint<QBits,DataType> value ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point maths functions only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "rsqrt" );
+    if (value.qValue() <= 0) return tFixedPoint<QOut,DataType>::create( std::numeric_limits<DataType>::max() );
+
+    // 1/sqrt(f * 2^e) = 1/sqrt(f) * 2^(-e/2)
+    int e;
+    const unsigned f = tFixedMath_::normalised( unsigned( value.qValue() ), QBits, e );
+    return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( tFixedMath_::rsqrt( f ), 30 + e/2, QOut ) ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
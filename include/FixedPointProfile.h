@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides the scoped stage timers used when fixed-point
+//   profiling is enabled.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTPROFILE_H
+#define FIXEDPOINTPROFILE_H
+
+#include <cstring>
+
+
+/**************************************************************************************************
+                          Fixed-Point Profiling
+***************************************************************************************************
+
+Defining FIXEDPOINT_ENABLE_PROFILING (before including FixedPoint.h, normally on the compiler
+command line) enables scoped stage timers. Placing FIXEDPOINT_PROFILE( "name" ) at the start of a
+block of code times it from that point until the end of the enclosing scope, and records the
+number of times it ran and the minimum, maximum and mean times against the stage 'name',
+
+    void pwmIsr() {
+        FIXEDPOINT_PROFILE_BUDGET( "foc", 1200 );       // the whole loop, in at most 1200 cycles
+        {
+            FIXEDPOINT_PROFILE( "adc scaling" );
+            ...
+        }
+        ...
+    }
+
+A stage can be given a budget with FIXEDPOINT_PROFILE_BUDGET, and each run that takes longer
+counts as an overrun and calls FIXEDPOINT_PROFILE_OVERRUN( name, ticks, budget ), which does
+nothing unless it is defined (eg. to set a debug pin, or to assert in a host simulation).
+
+The library's own kernels are timed as stages too - the trig, square root and atan2 functions
+("sin", "cos", "sincos", "sqrt", "rsqrt", "atan2"), "quotient" and "reciprocal" from
+FixedPointDivide.h, the filters ("fir", "biquad", "low-pass" and their "... block" forms), the
+transforms ("clarke", "park", "clarke-park", "inverse park", "svpwm", "inverse park-svpwm") and
+"pi". Times are inclusive of any nested stages, and stages with the same name (eg. "sin" for each
+fixed-point type it is used with) share one set of statistics. Up to FIXEDPOINT_PROFILE_STAGES
+stages are recorded, any others are recorded together as "other stages".
+
+The times are in cycles from the DWT cycle counter on Cortex-M3 and later (which is enabled when
+the first stage is used), in time-stamp counter ticks on x86 hosts, and in nanoseconds from
+std::chrono::steady_clock on other hosts. Other targets, such as the Cortex-M0 which has no cycle
+counter, need FIXEDPOINT_PROFILE_CLOCK() defined to an expression returning the current time (eg.
+from a free-running timer), and FIXEDPOINT_PROFILE_UNITS to the name of its units.
+
+The statistics can be written out with any function that writes a string, then cleared,
+
+    fixedProfileDump( uartWrite );          // void uartWrite( const char* text )
+    fixedProfileReset();
+
+which writes a line for each stage that has run, such as
+
+    park: runs 20000, min 41, mean 43, max 97 cycles
+    foc: runs 20000, min 906, mean 950, max 1315 cycles, budget 1200, overruns 12
+
+and "fixedProfileStage( name )" returns the statistics of a stage for checking at run-time.
+
+When FIXEDPOINT_ENABLE_PROFILING isn't defined none of this is compiled in, and the macros expand
+to nothing. As with the instrumentation counters, the statistics aren't protected from
+interrupts, so only profile code running at a single priority.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The maximum number of stages recorded **/
+#ifndef FIXEDPOINT_PROFILE_STAGES
+#define FIXEDPOINT_PROFILE_STAGES  32
+#endif
+
+/** Called when a run of the stage 'name' takes 'ticks', more than its 'budget' **/
+#ifndef FIXEDPOINT_PROFILE_OVERRUN
+#define FIXEDPOINT_PROFILE_OVERRUN( name, ticks, budget )
+#endif
+
+#if defined(FIXEDPOINT_PROFILE_CLOCK)
+#   ifndef FIXEDPOINT_PROFILE_UNITS
+#   define FIXEDPOINT_PROFILE_UNITS  "ticks"
+#   endif
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#   define FIXEDPOINT_PROFILE_DWT
+#   define FIXEDPOINT_PROFILE_UNITS  "cycles"
+#elif defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define FIXEDPOINT_PROFILE_TSC
+#   define FIXEDPOINT_PROFILE_UNITS  "ticks"
+#elif defined(__arm__) && !defined(__linux__)
+#   error "FixedPointProfile.h: define FIXEDPOINT_PROFILE_CLOCK() as there is no cycle counter for this target"
+#else
+#   include <chrono>
+#   define FIXEDPOINT_PROFILE_UNITS  "ns"
+#endif
+
+#define FIXEDPOINT_IMPL_PROFILE_NAME2( name, line )  name##line
+#define FIXEDPOINT_IMPL_PROFILE_NAME( name, line )   FIXEDPOINT_IMPL_PROFILE_NAME2( name, line )
+
+/** Times the stage 'name' until the end of the enclosing scope, with a 'budget' in the units of the
+    clock (0 for none). The stage is looked up once, the first time the code runs **/
+#define FIXEDPOINT_PROFILE_BUDGET( name, budget )                                                             \
+    static tFixedProfileStage& FIXEDPOINT_IMPL_PROFILE_NAME( fixedProfileStage_, __LINE__ ) = tFixedProfile_<>::find( name, budget ); \
+    tFixedProfileTimer_ FIXEDPOINT_IMPL_PROFILE_NAME( fixedProfileTimer_, __LINE__ )( FIXEDPOINT_IMPL_PROFILE_NAME( fixedProfileStage_, __LINE__ ) )
+
+#define FIXEDPOINT_PROFILE( name )  FIXEDPOINT_PROFILE_BUDGET( name, 0 )
+
+
+//-------------------------------------------------------------------------------------------------
+// Stage Statistics
+
+/** The statistics for one stage, all in the units of the clock **/
+struct tFixedProfileStage
+{
+    const char*         name;
+    unsigned long       runs;
+    unsigned long long  min;
+    unsigned long long  max;
+    unsigned long long  total;
+    unsigned long long  budget;
+    unsigned long       overruns;
+
+    unsigned long long mean() const { return (runs == 0)? 0 : total / runs; }
+
+    void reset() { runs = 0; min = ~0ull; max = 0; total = 0; overruns = 0; }
+
+    /** Records a run of the stage that took 'ticks' **/
+    void record( unsigned long long ticks ) {
+        ++runs;
+        total += ticks;
+        if (ticks < min) min = ticks;
+        if (ticks > max) max = ticks;
+        if (budget != 0 && ticks > budget) {
+            ++overruns;
+            FIXEDPOINT_PROFILE_OVERRUN( name, ticks, budget );
+        }
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Reads the clock the stages are timed with **/
+struct tFixedProfileClock_
+{
+#   if defined(FIXEDPOINT_PROFILE_CLOCK)
+    typedef unsigned long long tTicks;
+    static void start() {}
+    static tTicks now() { return tTicks( FIXEDPOINT_PROFILE_CLOCK() ); }
+#   elif defined(FIXEDPOINT_PROFILE_DWT)
+    typedef unsigned tTicks;            // the differences are correct across a wrap of the counter
+    static volatile unsigned& reg( unsigned address ) { return *reinterpret_cast< volatile unsigned* >( address ); }
+    static void start() { reg( 0xE000EDFC ) |= 1u << 24; reg( 0xE0001000 ) |= 1u; }
+    static tTicks now() { return reg( 0xE0001004 ); }
+#   elif defined(FIXEDPOINT_PROFILE_TSC)
+    typedef unsigned long long tTicks;
+    static void start() {}
+    static tTicks now() { return __rdtsc(); }
+#   else
+    typedef unsigned long long tTicks;
+    static void start() {}
+    static tTicks now() { return tTicks( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count() ); }
+#   endif
+};
+
+/** The shared state, the unused template parameter allows it to be defined in this header **/
+template< int Unused = 0 > struct tFixedProfile_
+{
+    static tFixedProfileStage  stages[FIXEDPOINT_PROFILE_STAGES + 1];       // the last is "other stages"
+    static unsigned            stageCount;
+
+    /** Returns the stage called 'name', adding it with 'budget' if it is new **/
+    static tFixedProfileStage& find( const char* name, unsigned long long budget ) {
+        if (stageCount == 0) tFixedProfileClock_::start();
+        tFixedProfileStage* s = find( name );
+        if (!s) {
+            s = &stages[(stageCount < FIXEDPOINT_PROFILE_STAGES)? stageCount++ : FIXEDPOINT_PROFILE_STAGES];
+            if (!s->name) {
+                s->name = (s == &stages[FIXEDPOINT_PROFILE_STAGES])? "other stages" : name;
+                s->reset();
+            }
+        }
+        if (budget != 0 && s != &stages[FIXEDPOINT_PROFILE_STAGES]) s->budget = budget;
+        return *s;
+    }
+
+    static tFixedProfileStage* find( const char* name ) {
+        for (unsigned i = 0; i < stageCount; ++i)
+            if (stages[i].name == name || std::strcmp( stages[i].name, name ) == 0) return &stages[i];
+        return 0;
+    }
+
+    /** Formats 'value' as decimal into 'buffer', and returns 'buffer' **/
+    static char* format( char* buffer, unsigned long long value ) {
+        char reversed[24];
+        int n = 0;
+        do { reversed[n++] = char( '0' + value % 10 ); value /= 10; } while (value != 0);
+        for (int i = 0; i < n; ++i) buffer[i] = reversed[n - 1 - i];
+        buffer[n] = '\0';
+        return buffer;
+    }
+};
+
+template< int Unused > tFixedProfileStage tFixedProfile_< Unused >::stages[FIXEDPOINT_PROFILE_STAGES + 1];
+template< int Unused > unsigned tFixedProfile_< Unused >::stageCount = 0;
+
+/** Times the stage it is constructed with, until it is destroyed **/
+class tFixedProfileTimer_
+{
+public:
+    explicit tFixedProfileTimer_( tFixedProfileStage& stage ) : stage_( stage ), start_( tFixedProfileClock_::now() ) {}
+    ~tFixedProfileTimer_() { stage_.record( tFixedProfileClock_::tTicks( tFixedProfileClock_::now() - start_ ) ); }
+
+private:
+    tFixedProfileTimer_( const tFixedProfileTimer_& );
+    tFixedProfileTimer_& operator=( const tFixedProfileTimer_& );
+
+    tFixedProfileStage&           stage_;
+    tFixedProfileClock_::tTicks   start_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+/** Writes a line for each stage that has run, using 'write' which is called with a series of
+    null-terminated strings **/
+template< typename Writer > void fixedProfileDump( Writer write ) {
+    typedef tFixedProfile_<> tProfile;
+    for (unsigned i = 0; i <= FIXEDPOINT_PROFILE_STAGES; ++i) {
+        const tFixedProfileStage& s = tProfile::stages[i];
+        if (!s.name || s.runs == 0) continue;
+        char digits[24];
+        write( s.name );
+        write( ": runs " ); write( tProfile::format( digits, s.runs ) );
+        write( ", min " );  write( tProfile::format( digits, s.min ) );
+        write( ", mean " ); write( tProfile::format( digits, s.mean() ) );
+        write( ", max " );  write( tProfile::format( digits, s.max ) );
+        write( " " FIXEDPOINT_PROFILE_UNITS );
+        if (s.budget != 0) {
+            write( ", budget " );   write( tProfile::format( digits, s.budget ) );
+            write( ", overruns " ); write( tProfile::format( digits, s.overruns ) );
+        }
+        write( "\n" );
+    }
+}
+
+/** Clears the statistics of all of the stages, keeping their budgets **/
+inline void fixedProfileReset() {
+    for (unsigned i = 0; i <= FIXEDPOINT_PROFILE_STAGES; ++i) tFixedProfile_<>::stages[i].reset();
+}
+
+/** Returns the statistics of the stage called 'name', or null if it hasn't run yet **/
+inline const tFixedProfileStage* fixedProfileStage( const char* name ) {
+    if (tFixedProfile_<>::stages[FIXEDPOINT_PROFILE_STAGES].name && std::strcmp( name, "other stages" ) == 0)
+        return &tFixedProfile_<>::stages[FIXEDPOINT_PROFILE_STAGES];
+    return tFixedProfile_<>::find( name );
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
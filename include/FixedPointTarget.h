@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file selects the instruction set extensions used by the fixed-point
+//   library from the compiler's predefined macros.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTTARGET_H
+#define FIXEDPOINTTARGET_H
+
+
+/**************************************************************************************************
+                          Fixed-Point Target Selection
+***************************************************************************************************
+
+The saturating operations (SatFixedPoint.h) and the batch kernels (FixedPointBatch.h) have versions
+that use the instructions particular targets provide. This file works out which of them can be
+used from the macros the compiler predefines for the target (-mcpu etc.), and defines one of the
+following for each group of instructions found,
+
+    FIXEDPOINT_TARGET_MVE       Helium (M-profile vector extension) integer instructions, eg.
+                                Cortex-M55 and M85, for the 16-bit batch kernels 8 values at a time.
+    FIXEDPOINT_TARGET_SIMD32    the DSP extension's 2x16-bit SIMD instructions, eg. Cortex-M4, M7,
+                                M33 (with the DSP extension) and M55.
+    FIXEDPOINT_TARGET_DSP       the DSP extension's QADD/QSUB saturating instructions.
+    FIXEDPOINT_TARGET_SAT       the SSAT instruction, eg. Cortex-M3 and later.
+    FIXEDPOINT_TARGET_RVP       the RISC-V packed-SIMD (P) extension on RV32, for saturating 32-bit
+                                operations, clipping and 2x16-bit SIMD additions.
+    FIXEDPOINT_TARGET_VFP       a single-precision FPU on a 32-bit Arm target, eg. Cortex-M4F, M7 and
+                                M33, for the VCVT fixed-point to float conversions.
+    FIXEDPOINT_TARGET_NEON      NEON, for host simulation on AArch64 or Armv7-A.
+    FIXEDPOINT_TARGET_SSE2      SSE2, for host simulation on x86.
+    FIXEDPOINT_TARGET_HOSTFPU   the hardware float conversions of x86 and AArch64 hosts.
+
+along with FIXEDPOINT_TARGET_NAME, a string naming the set used for the batch kernels (eg. for a
+benchmark report). Anything not covered by these uses the generic C++ versions, which every
+target specific version gives exactly the same results as - the FixedPointBatch and SatFixedPoint
+tests check this when they are built for each target.
+
+Defining FIXEDPOINT_TARGET_GENERIC before including any of the library's headers disables all of
+them, eg. to compare a target's results or timings with the generic versions.
+
+Only the SSE2 and host FPU versions have been built and tested so far. The others haven't yet
+been built with a toolchain for their targets, let alone run on one, so they are only used if
+FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS is also defined. Otherwise those targets use the generic
+versions. Run the FixedPointBatch, SatFixedPoint, FixedVector and FixedPoint tests on the target
+before relying on them.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Target Selection
+
+#if !defined(FIXEDPOINT_TARGET_GENERIC)
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#       define FIXEDPOINT_TARGET_MVE
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__ARM_FEATURE_SIMD32)
+#       define FIXEDPOINT_TARGET_SIMD32
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__ARM_FEATURE_DSP)
+#       define FIXEDPOINT_TARGET_DSP
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__ARM_FEATURE_SAT)
+#       define FIXEDPOINT_TARGET_SAT
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__ARM_NEON) && !defined(FIXEDPOINT_TARGET_MVE)
+#       define FIXEDPOINT_TARGET_NEON
+#   endif
+#   if defined(__SSE2__)
+#       define FIXEDPOINT_TARGET_SSE2
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__arm__) && defined(__ARM_FP) && (__ARM_FP & 4)
+#       define FIXEDPOINT_TARGET_VFP
+#   endif
+#   if defined(__SSE__) || defined(__aarch64__)
+#       define FIXEDPOINT_TARGET_HOSTFPU
+#   endif
+#   if defined(FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS) && defined(__riscv) && (defined(__riscv_p) || defined(__riscv_dsp)) && (__riscv_xlen == 32)
+#       define FIXEDPOINT_TARGET_RVP
+#   endif
+#endif
+
+#if defined(FIXEDPOINT_TARGET_MVE)
+#   include <arm_mve.h>
+#endif
+#if defined(FIXEDPOINT_TARGET_SIMD32) || defined(FIXEDPOINT_TARGET_DSP) || defined(FIXEDPOINT_TARGET_SAT)
+#   include <arm_acle.h>
+#endif
+#if defined(FIXEDPOINT_TARGET_NEON)
+#   include <arm_neon.h>
+#endif
+#if defined(FIXEDPOINT_TARGET_SSE2)
+#   include <emmintrin.h>
+#endif
+
+#if defined(FIXEDPOINT_TARGET_MVE)
+#   define FIXEDPOINT_TARGET_NAME  "Helium MVE"
+#elif defined(FIXEDPOINT_TARGET_SIMD32)
+#   define FIXEDPOINT_TARGET_NAME  "Arm DSP extension"
+#elif defined(FIXEDPOINT_TARGET_NEON)
+#   define FIXEDPOINT_TARGET_NAME  "NEON"
+#elif defined(FIXEDPOINT_TARGET_SSE2)
+#   define FIXEDPOINT_TARGET_NAME  "SSE2"
+#elif defined(FIXEDPOINT_TARGET_RVP)
+#   define FIXEDPOINT_TARGET_NAME  "RISC-V P extension"
+#else
+#   define FIXEDPOINT_TARGET_NAME  "generic"
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// RISC-V P Extension
+
+#if defined(FIXEDPOINT_TARGET_RVP)
+/** The P extension instructions used, as there is no settled set of intrinsics for them yet. The
+    packed versions operate on two 16-bit values in the halves of a register **/
+struct tFixedTargetRvp_
+{
+    static unsigned add16( unsigned a, unsigned b ) { unsigned r; __asm__( "add16 %0, %1, %2" : "=r"( r ) : "r"( a ), "r"( b ) ); return r; }
+    static unsigned kadd16( unsigned a, unsigned b ) { unsigned r; __asm__( "kadd16 %0, %1, %2" : "=r"( r ) : "r"( a ), "r"( b ) ); return r; }
+
+    /** Saturating 32-bit addition and subtraction. These also set the OV flag in vxsat, which
+        the library doesn't use **/
+    static int kaddw( int a, int b ) { int r; __asm__ volatile( "kaddw %0, %1, %2" : "=r"( r ) : "r"( a ), "r"( b ) ); return r; }
+    static int ksubw( int a, int b ) { int r; __asm__ volatile( "ksubw %0, %1, %2" : "=r"( r ) : "r"( a ), "r"( b ) ); return r; }
+
+    /** Clamps 'value' to the range of a signed 'Bits' bit value **/
+    template< int Bits > static int sclip32( int value ) { int r; __asm__ volatile( "sclip32 %0, %1, %2" : "=r"( r ) : "r"( value ), "i"( Bits - 1 ) ); return r; }
+};
+#endif
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
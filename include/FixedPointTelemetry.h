@@ -0,0 +1,328 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a compact binary encoding for streams of fixed-point
+//   values, for logging and telemetry.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDPOINTTELEMETRY_H
+#define FIXEDPOINTTELEMETRY_H
+
+#include "FixedPoint.h"
+#include <limits>
+
+
+/**************************************************************************************************
+                          Fixed-Point Telemetry Encoding
+***************************************************************************************************
+
+Sending fixed-point values as text or doubles wastes most of a link's bandwidth. The classes here
+send the raw qValues instead, packed into just the number of bits each channel needs, after a
+header that describes each channel once so that the receiver can decode them without knowing the
+types at compile-time.
+
+A channel is declared with its fixed-point type, the number of bits sent per value (by default
+the full width of the data-type) and whether each value is sent as the difference from the
+previous one (for slowly changing signals),
+
+    typedef tFixedTelemetryChannel< tQ12s, 12 >          tCurrentChannel;    // +-8A in 12 bits
+    typedef tFixedTelemetryChannel< tQ16, 10, true >     tSpeedChannel;      // +-512 LSBs per sample
+
+    unsigned char frame[64];
+    tFixedTelemetryWriter out( frame, sizeof(frame) );
+    tCurrentChannel::header().write( out );         // 4 bytes, once at the start of the stream
+    tSpeedChannel::header().write( out );
+    ...
+    current.write( out, ia12 );                     // 12 bits
+    speed.write( out, speed16 );                    // 10 bits
+    out.flush();                                    // pads the last byte, out.size() bytes to send
+
+Values (or differences) that don't fit in the bits given are clamped, and "write" returns false.
+Delta channels track the value the receiver will reconstruct, so a clamped difference is caught up
+on the following samples rather than leaving a permanent offset.
+
+The receiver reads the headers with "tFixedTelemetryHeader::read", and then decodes each value as
+a raw qValue with a tFixedTelemetryDecoder made from its header (or with the "read" method of the
+same tFixedTelemetryChannel type if it is known at compile-time). A tFixedTelemetryEncoder does
+the reverse for raw qValues, eg. to write recorded or simulated data back out in the same format
+on a host. The header is,
+
+    byte 0      qbits
+    byte 1      width of the data-type in bits (8, 16, 32 or 64)
+    byte 2      bits sent per value (1 to 64)
+    byte 3      flags, bit 0: the data-type is signed, bit 1: the values are deltas
+
+Values are packed least significant bit first, starting at bit 0 of each byte. Headers and values
+can be mixed freely, and neither needs to start on a byte boundary.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedTelemetry_
+{
+    typedef unsigned long long tULL;
+
+    /** Returns a mask of the bottom 'bits' bits **/
+    static tULL mask( unsigned bits ) { return (bits >= 64)? ~0ull : ((1ull << bits) - 1); }
+
+    /** Returns 'value' clamped to the range of a 'bits' wide field, which is signed or not **/
+    static long long clamped( long long value, unsigned bits, bool isSigned ) {
+        if (bits >= 64) return value;
+        long long max = isSigned? (1ll << (bits - 1)) - 1 : (1ll << bits) - 1;
+        long long min = isSigned? -max - 1 : 0;
+        return (value > max)? max : (value < min)? min : value;
+    }
+
+    /** Returns a 'bits' wide field read back as a value, sign extending it if it is signed **/
+    static long long extended( tULL field, unsigned bits, bool isSigned ) {
+        if (bits >= 64 || !isSigned) return (long long)( field );
+        tULL sign = 1ull << (bits - 1);
+        return (long long)( (field ^ sign) - sign );
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Bit Streams
+
+/** Packs fields of up to 64 bits into a caller supplied buffer **/
+class tFixedTelemetryWriter
+{
+public:
+    tFixedTelemetryWriter( unsigned char* buffer, unsigned size ) : buffer_( buffer ), size_( size ), used_( 0 ), bits_( 0 ), count_( 0 ), overflowed_( false ) {}
+
+    /** Adds the bottom 'bits' bits of 'value' **/
+    void put( unsigned long long value, unsigned bits ) {
+        if (bits > 32) {
+            put( value, 32 );
+            value >>= 32;
+            bits -= 32;
+        }
+        bits_ |= (value & tFixedTelemetry_::mask( bits )) << count_;
+        count_ += bits;
+        while (count_ >= 8) {
+            byte_( (unsigned char)( bits_ ) );
+            bits_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    /** Writes out any partly filled byte, padded with zeros **/
+    void flush() { if (count_ > 0) { byte_( (unsigned char)( bits_ ) ); bits_ = 0; count_ = 0; } }
+
+    /** Starts again at the beginning of the buffer **/
+    void reset() { used_ = 0; bits_ = 0; count_ = 0; overflowed_ = false; }
+
+    /** Returns the number of complete bytes written to the buffer **/
+    unsigned size() const { return used_; }
+
+    /** Returns true if the buffer ran out of room (the extra bytes are lost) **/
+    bool overflowed() const { return overflowed_; }
+
+private:
+    void byte_( unsigned char value ) { if (used_ < size_) buffer_[used_++] = value; else overflowed_ = true; }
+
+    unsigned char*      buffer_;
+    unsigned            size_;
+    unsigned            used_;
+    unsigned long long  bits_;          // bits not yet written to the buffer
+    unsigned            count_;         // the number of them
+    bool                overflowed_;
+};
+
+/** Unpacks the fields written by tFixedTelemetryWriter **/
+class tFixedTelemetryReader
+{
+public:
+    tFixedTelemetryReader( const unsigned char* buffer, unsigned size ) : buffer_( buffer ), size_( size ), used_( 0 ), bits_( 0 ), count_( 0 ), overflowed_( false ) {}
+
+    /** Returns the next 'bits' bits, as the bottom bits of the result **/
+    unsigned long long get( unsigned bits ) {
+        if (bits > 32) {
+            unsigned long long low = get( 32 );
+            return low | (get( bits - 32 ) << 32);
+        }
+        while (count_ < bits) {
+            bits_ |= (unsigned long long)( byte_() ) << count_;
+            count_ += 8;
+        }
+        unsigned long long value = bits_ & tFixedTelemetry_::mask( bits );
+        bits_ >>= bits;
+        count_ -= bits;
+        return value;
+    }
+
+    /** Skips the rest of a partly read byte, matching "flush" on the writer **/
+    void align() { bits_ = 0; count_ = 0; }
+
+    /** Returns the number of bytes of the buffer not read yet **/
+    unsigned remaining() const { return size_ - used_; }
+
+    /** Returns true if a read went past the end of the buffer (zeros are read instead) **/
+    bool overflowed() const { return overflowed_; }
+
+private:
+    unsigned char byte_() { if (used_ < size_) return buffer_[used_++]; overflowed_ = true; return 0; }
+
+    const unsigned char*  buffer_;
+    unsigned              size_;
+    unsigned              used_;
+    unsigned long long    bits_;
+    unsigned              count_;
+    bool                  overflowed_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Channels
+
+/** Describes the values sent on a channel, see the format above **/
+struct tFixedTelemetryHeader
+{
+    enum { cSigned = 1, cDelta = 2 };
+
+    tFixedTelemetryHeader() : qBits( 0 ), dataBits( 0 ), bits( 0 ), flags( 0 ) {}
+    tFixedTelemetryHeader( unsigned qBits_, unsigned dataBits_, unsigned bits_, bool isSigned, bool delta )
+        : qBits( qBits_ ), dataBits( dataBits_ ), bits( bits_ ), flags( (isSigned? cSigned : 0) | (delta? cDelta : 0) ) {}
+
+    unsigned    qBits;
+    unsigned    dataBits;
+    unsigned    bits;
+    unsigned    flags;
+
+    bool isSigned() const { return (flags & cSigned) != 0; }
+    bool delta() const { return (flags & cDelta) != 0; }
+
+    /** Returns true if the fields of a value are signed, which deltas always are **/
+    bool signedField() const { return (flags & (cSigned | cDelta)) != 0; }
+
+    bool operator==( const tFixedTelemetryHeader& h ) const { return qBits == h.qBits && dataBits == h.dataBits && bits == h.bits && flags == h.flags; }
+    bool operator!=( const tFixedTelemetryHeader& h ) const { return !(*this == h); }
+
+    void write( tFixedTelemetryWriter& out ) const { out.put( qBits, 8 ); out.put( dataBits, 8 ); out.put( bits, 8 ); out.put( flags, 8 ); }
+    static tFixedTelemetryHeader read( tFixedTelemetryReader& in ) {
+        tFixedTelemetryHeader h;
+        h.qBits = unsigned( in.get( 8 ) );
+        h.dataBits = unsigned( in.get( 8 ) );
+        h.bits = unsigned( in.get( 8 ) );
+        h.flags = unsigned( in.get( 8 ) );
+        return h;
+    }
+};
+
+/** Encodes and decodes the values of the fixed-point type 'FPType', sent with 'Bits' bits each,
+    either directly or as the difference from the previous value if 'Delta' is true **/
+template< typename FPType, unsigned Bits = sizeof(typename FPType::tValue)*8, bool Delta = false >
+class tFixedTelemetryChannel
+{
+public:
+    typedef typename FPType::tValue tValue;
+
+    static const unsigned cBits = Bits;
+    static const bool cDelta = Delta;
+    static const bool cSignedField = Delta || std::numeric_limits<tValue>::is_signed;
+
+    static_assert( Bits >= 1 && Bits <= sizeof(tValue)*8 + (Delta? 1 : 0) && Bits <= 64, "invalid number of bits for a telemetry channel" );
+
+    /** Returns the header describing this channel **/
+    static tFixedTelemetryHeader header()
+        { return tFixedTelemetryHeader( FPType::cQBits, unsigned( sizeof(tValue)*8 ), Bits, std::numeric_limits<tValue>::is_signed, Delta ); }
+
+    tFixedTelemetryChannel() : previous_() {}
+
+    /** Restarts the deltas from 0, which must be done at the same point on both ends **/
+    void reset() { previous_ = 0; }
+
+    /** Writes 'value', returning false if it (or its delta) had to be clamped to fit **/
+    bool write( tFixedTelemetryWriter& out, const FPType& value ) {
+        long long field = (long long)( value.qValue() ) - (Delta? previous_ : 0);
+        long long sent = tFixedTelemetry_::clamped( field, Bits, cSignedField );
+        if (Delta) previous_ += sent;
+        out.put( (unsigned long long)( sent ), Bits );
+        return sent == field;
+    }
+
+    /** Reads the next value **/
+    FPType read( tFixedTelemetryReader& in ) {
+        long long value = tFixedTelemetry_::extended( in.get( Bits ), Bits, cSignedField );
+        if (Delta) value = (previous_ += value);
+        return FPType::create( tValue( value ) );
+    }
+
+private:
+    long long previous_;
+};
+
+/** Decodes the raw 64-bit qValues of a channel from its header, for receivers that don't know the
+    channel's type at compile-time **/
+class tFixedTelemetryDecoder
+{
+public:
+    tFixedTelemetryDecoder() : header_(), previous_( 0 ) {}
+    explicit tFixedTelemetryDecoder( const tFixedTelemetryHeader& header ) : header_( header ), previous_( 0 ) {}
+
+    const tFixedTelemetryHeader& header() const { return header_; }
+    void reset() { previous_ = 0; }
+
+    /** Reads the next raw qValue, which has header().qBits qbits **/
+    long long read( tFixedTelemetryReader& in ) {
+        long long value = tFixedTelemetry_::extended( in.get( header_.bits ), header_.bits, header_.signedField() );
+        return header_.delta()? (previous_ += value) : value;
+    }
+
+private:
+    tFixedTelemetryHeader  header_;
+    long long              previous_;
+};
+
+/** Encodes raw 64-bit qValues for a channel from its header, the reverse of tFixedTelemetryDecoder **/
+class tFixedTelemetryEncoder
+{
+public:
+    tFixedTelemetryEncoder() : header_(), previous_( 0 ) {}
+    explicit tFixedTelemetryEncoder( const tFixedTelemetryHeader& header ) : header_( header ), previous_( 0 ) {}
+
+    const tFixedTelemetryHeader& header() const { return header_; }
+    void reset() { previous_ = 0; }
+
+    /** Writes a raw qValue with header().qBits qbits, returning false if it (or its delta) had to
+        be clamped to fit **/
+    bool write( tFixedTelemetryWriter& out, long long value ) {
+        long long field = value - (header_.delta()? previous_ : 0);
+        long long sent = tFixedTelemetry_::clamped( field, header_.bits, header_.signedField() );
+        if (header_.delta()) previous_ += sent;
+        out.put( (unsigned long long)( sent ), header_.bits );
+        return sent == field;
+    }
+
+private:
+    tFixedTelemetryHeader  header_;
+    long long              previous_;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
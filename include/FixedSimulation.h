@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a host-side harness for running fixed-point control
+//   code over recorded telemetry, and comparing the results bit for bit.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDSIMULATION_H
+#define FIXEDSIMULATION_H
+
+#include "FixedPoint.h"
+#include "FixedPointTelemetry.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+
+/**************************************************************************************************
+                          Fixed-Point Simulation Harness
+***************************************************************************************************
+
+The fixed-point classes give the same results on a PC as on the target, so control code can be
+tuned by replaying recorded data through it on the host rather than through a floating-point
+stand-in. This file (which is for host builds only, as it uses the standard library's containers
+and threads) provides the pieces for doing that,
+
+    tFixedTrace                 a recording of fixed-point channels, as raw qValues along with
+                                the telemetry header of each channel. It can be decoded from (and
+                                encoded to) the FixedPointTelemetry.h format, and built up from
+                                the outputs of a simulation.
+    fixedSimulate               runs a model over a trace in blocks of samples.
+    fixedRunParallel            runs a number of independent simulations across all of the cores,
+                                eg. for sweeps over gains or Q formats.
+    fixedCompare                compares two traces bit for bit, eg. a simulation's outputs with
+                                those logged by the target, and reports the differences.
+
+A model is a class with a "run" method that is given blocks of up to FIXEDPOINT_SIMULATION_BLOCK
+samples of the input trace, and records its outputs in the output trace. Working on blocks lets
+it read each channel into an array of its own fixed-point type, and use the FixedPointBatch.h
+functions on whole arrays, eg. for a current loop,
+
+    struct tCurrentLoop {
+        tCurrentLoop( tQ16 kp, tQ16 ki ) : pi( kp, ki, -tQ12( 150 ), tQ12( 150 ) ) {}
+
+        void run( const tFixedTrace& in, unsigned first, unsigned count, tFixedTrace& out ) {
+            tQ12s id[FIXEDPOINT_SIMULATION_BLOCK];
+            in.samples( 0, first, id, count );                  // channel 0 as Q12 shorts
+            for (unsigned i = 0; i < count; ++i) out.record( 0, pi.update( idRef - id[i] ) );
+        }
+
+        tPIController< 16, 12 >  pi;
+    };
+
+    tFixedTrace recorded;
+    recorded.decode( log, logSize, 3, logFrames );              // the 3 channels of the log
+
+    std::vector< tFixedTrace > results( cGains );
+    fixedRunParallel( cGains, [&]( unsigned i ) {
+        tCurrentLoop loop( kp[i], ki[i] );
+        results[i].addChannel< tQ12 >();
+        fixedSimulate( recorded, loop, results[i] );
+    } );
+
+    tFixedTraceComparison c = fixedCompare( targetOutputs, results[0] );
+    c.write( []( const char* text ) { fputs( text, stdout ); } );
+
+which writes "identical, 1 channels of 600000 samples" or the number of values that differ and
+the first of them. Samples read from a channel with a different number of qbits to the type they
+are read as are shifted to it, rounding to the nearest value.
+
+The simulations must be independent of each other, so anything a model changes must belong to
+it. The FIXEDPOINT_ENABLE_INSTRUMENTATION counters are shared by all threads, so to find which
+simulations wrap (or saturate) run them with a single thread, which runs them one after another
+on the calling thread, and check fixedPointDumpStats after each one.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Support Macros
+
+/** The largest number of samples passed to a model's "run" at a time **/
+#ifndef FIXEDPOINT_SIMULATION_BLOCK
+#define FIXEDPOINT_SIMULATION_BLOCK  4096
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFixedSimulation_
+{
+    /** Shifts a raw 'value' from 'fromQ' to 'toQ' qbits, rounding to the nearest value **/
+    static long long rescaled( long long value, unsigned fromQ, unsigned toQ ) {
+        if (toQ >= fromQ) return (long long)( (unsigned long long)( value ) << (toQ - fromQ) );
+        return (value + (1ll << (fromQ - toQ - 1))) >> (fromQ - toQ);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Traces
+
+/** A recording of a number of fixed-point channels **/
+class tFixedTrace
+{
+public:
+    tFixedTrace() {}
+
+    //---------------------------------------------------------------------------------------------
+    // Channels
+
+    /** Adds a channel described by 'header', returning its index **/
+    unsigned addChannel( const tFixedTelemetryHeader& header ) {
+        headers_.push_back( header );
+        values_.push_back( std::vector< long long >() );
+        return unsigned( headers_.size() - 1 );
+    }
+
+    /** Adds a channel for values of the fixed-point type 'FPType', sent at full width **/
+    template< typename FPType > unsigned addChannel() { return addChannel( tFixedTelemetryChannel< FPType >::header() ); }
+
+    unsigned channels() const { return unsigned( headers_.size() ); }
+    const tFixedTelemetryHeader& header( unsigned channel ) const { return headers_[channel]; }
+
+    /** Returns the number of samples of the longest channel **/
+    unsigned frames() const {
+        size_t n = 0;
+        for (size_t c = 0; c < values_.size(); ++c) if (values_[c].size() > n) n = values_[c].size();
+        return unsigned( n );
+    }
+
+    /** Returns the number of samples of a 'channel' **/
+    unsigned size( unsigned channel ) const { return unsigned( values_[channel].size() ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Samples
+
+    /** Returns a sample as a raw qValue, with header( channel ).qBits qbits **/
+    long long raw( unsigned channel, unsigned frame ) const { return values_[channel][frame]; }
+
+    /** Returns a sample as the fixed-point type 'FPType' **/
+    template< typename FPType > FPType sample( unsigned channel, unsigned frame ) const
+        { return FPType::create( typename FPType::tValue( tFixedSimulation_::rescaled( values_[channel][frame], headers_[channel].qBits, FPType::cQBits ) ) ); }
+
+    /** Copies up to 'count' samples of a 'channel', from 'first', to 'out' as the fixed-point
+        type 'FPType', returning the number copied **/
+    template< typename FPType > unsigned samples( unsigned channel, unsigned first, FPType* out, unsigned count ) const {
+        const unsigned available = (first < size( channel ))? size( channel ) - first : 0;
+        if (count > available) count = available;
+        for (unsigned i = 0; i < count; ++i) out[i] = sample< FPType >( channel, first + i );
+        return count;
+    }
+
+    /** Adds a sample to the end of a 'channel', as a raw qValue or a fixed-point value **/
+    void appendRaw( unsigned channel, long long value ) { values_[channel].push_back( value ); }
+    template< typename FPType > void record( unsigned channel, FPType value )
+        { appendRaw( channel, tFixedSimulation_::rescaled( value.qValue(), FPType::cQBits, headers_[channel].qBits ) ); }
+
+    /** Removes all of the samples, keeping the channels **/
+    void clear() { for (size_t c = 0; c < values_.size(); ++c) values_[c].clear(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Telemetry
+
+    /** Replaces the trace with one decoded from a telemetry stream of 'size' bytes, which has the
+        headers of 'channels' channels followed by 'frames' frames of one value from each channel
+        in turn. The stream doesn't record the number of frames, as the padding to a whole byte at
+        the end could hold another frame of narrow channels, so it has to be passed in. Returns
+        false if the stream is too short for the headers and frames, or has an invalid header **/
+    bool decode( const unsigned char* data, unsigned size, unsigned channels, unsigned frames ) {
+        headers_.clear();
+        values_.clear();
+        tFixedTelemetryReader in( data, size );
+        std::vector< tFixedTelemetryDecoder > decoders;
+        unsigned long long frameBits = 0;
+        for (unsigned c = 0; c < channels; ++c) {
+            const tFixedTelemetryHeader h = tFixedTelemetryHeader::read( in );
+            if (in.overflowed() || h.bits < 1 || h.bits > 64) return false;
+            addChannel( h );
+            decoders.push_back( tFixedTelemetryDecoder( h ) );
+            frameBits += h.bits;
+        }
+
+        if (32ull*channels + frameBits*frames > 8ull*size) return false;
+        for (unsigned c = 0; c < channels; ++c) values_[c].reserve( frames );
+        for (unsigned f = 0; f < frames; ++f)
+            for (unsigned c = 0; c < channels; ++c) values_[c].push_back( decoders[c].read( in ) );
+        return true;
+    }
+
+    /** Encodes the trace in the same format to 'buffer', returning the number of bytes used or 0
+        if it doesn't fit. Channels shorter than the longest are padded with their last value, so
+        the trace is decoded again with "frames()" frames **/
+    unsigned encode( unsigned char* buffer, unsigned bufferSize ) const {
+        tFixedTelemetryWriter out( buffer, bufferSize );
+        std::vector< tFixedTelemetryEncoder > encoders;
+        for (unsigned c = 0; c < channels(); ++c) {
+            headers_[c].write( out );
+            encoders.push_back( tFixedTelemetryEncoder( headers_[c] ) );
+        }
+        const unsigned n = frames();
+        for (unsigned f = 0; f < n; ++f)
+            for (unsigned c = 0; c < channels(); ++c)
+                encoders[c].write( out, values_[c].empty()? 0 : values_[c][(f < size( c ))? f : size( c ) - 1] );
+        out.flush();
+        return out.overflowed()? 0 : out.size();
+    }
+
+private:
+    std::vector< tFixedTelemetryHeader >       headers_;
+    std::vector< std::vector< long long > >    values_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Simulation
+
+/** Runs 'model' over the 'input' trace, passing it blocks of up to 'block' samples from the start
+    to the end of the trace, with the 'output' trace to record its results in **/
+template< typename Model >
+void fixedSimulate( const tFixedTrace& input, Model& model, tFixedTrace& output, unsigned block = FIXEDPOINT_SIMULATION_BLOCK ) {
+    const unsigned frames = input.frames();
+    for (unsigned first = 0; first < frames; first += block)
+        model.run( input, first, (frames - first < block)? frames - first : block, output );
+}
+
+/** Calls 'run' with each index from 0 to 'count'-1, spread over 'threads' threads (by default one
+    per core). With a single thread they are all run in order on the calling thread **/
+template< typename Function >
+void fixedRunParallel( unsigned count, Function run, unsigned threads = 0 ) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads > count) threads = count;
+    if (threads <= 1) {
+        for (unsigned i = 0; i < count; ++i) run( i );
+        return;
+    }
+
+    std::atomic< unsigned > next( 0 );
+    std::vector< std::thread > workers;
+    for (unsigned t = 0; t < threads; ++t)
+        workers.push_back( std::thread( [&]() { for (unsigned i; (i = next++) < count; ) run( i ); } ) );
+    for (unsigned t = 0; t < threads; ++t) workers[t].join();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Comparison
+
+/** The result of comparing two traces with "fixedCompare" **/
+struct tFixedTraceComparison
+{
+    tFixedTraceComparison() : channels( 0 ), frames( 0 ), formatsMatch( true ), sizesMatch( true ), mismatches( 0 ),
+                              firstChannel( 0 ), firstFrame( 0 ), expected( 0 ), actual( 0 ), maxDifference( 0 ) {}
+
+    unsigned            channels;           // the number of channels compared
+    unsigned            frames;             // the number of samples of the longest channel compared
+    bool                formatsMatch;       // the traces had the same channels
+    bool                sizesMatch;         // and the same number of samples in each
+    unsigned long long  mismatches;         // the number of samples compared which differ
+    unsigned            firstChannel;       // the first sample which differs
+    unsigned            firstFrame;
+    long long           expected;           // its raw values
+    long long           actual;
+    unsigned long long  maxDifference;      // the largest difference, in LSBs
+
+    /** Returns true if the traces are the same, bit for bit **/
+    bool identical() const { return formatsMatch && sizesMatch && mismatches == 0; }
+
+    /** Writes a one line report using 'write', which is called with null-terminated strings **/
+    template< typename Writer > void write( Writer write ) const {
+        char line[256];
+        if (identical()) {
+            std::snprintf( line, sizeof(line), "identical, %u channels of %u samples\n", channels, frames );
+        } else if (mismatches == 0) {
+            std::snprintf( line, sizeof(line), "%s, %u channels of up to %u samples\n", formatsMatch? "different lengths" : "different channels", channels, frames );
+        } else {
+            std::snprintf( line, sizeof(line), "%llu samples differ in %u channels of %u samples%s, first at channel %u sample %u (expected %lld, got %lld), max difference %llu\n",
+                           mismatches, channels, frames, formatsMatch? "" : " (and the channels differ)", firstChannel, firstFrame, expected, actual, maxDifference );
+        }
+        write( line );
+    }
+};
+
+/** Compares the raw values of the channels and samples the traces have in common **/
+inline tFixedTraceComparison fixedCompare( const tFixedTrace& expected, const tFixedTrace& actual ) {
+    tFixedTraceComparison result;
+    result.channels = (expected.channels() < actual.channels())? expected.channels() : actual.channels();
+    result.formatsMatch = expected.channels() == actual.channels();
+    for (unsigned c = 0; c < result.channels; ++c) {
+        if (expected.header( c ) != actual.header( c )) result.formatsMatch = false;
+        if (expected.size( c ) != actual.size( c )) result.sizesMatch = false;
+        const unsigned n = (expected.size( c ) < actual.size( c ))? expected.size( c ) : actual.size( c );
+        if (n > result.frames) result.frames = n;
+        for (unsigned f = 0; f < n; ++f) {
+            const long long e = expected.raw( c, f ), a = actual.raw( c, f );
+            if (e == a) continue;
+            if (result.mismatches++ == 0 || f < result.firstFrame) {
+                result.firstChannel = c;
+                result.firstFrame = f;
+                result.expected = e;
+                result.actual = a;
+            }
+            const unsigned long long d = (e > a)? (unsigned long long)( e ) - (unsigned long long)( a ) : (unsigned long long)( a ) - (unsigned long long)( e );
+            if (d > result.maxDifference) result.maxDifference = d;
+        }
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
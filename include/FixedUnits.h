@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a unit-annotated variant of the fixed-point template
+//   class, which checks the units of expressions at compile-time.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDUNITS_H
+#define FIXEDUNITS_H
+
+#include "FixedPoint.h"
+#include <type_traits>
+
+#if __cplusplus < 201103L
+#   error "FixedUnits.h requires C++11 support"
+#endif
+
+
+/**************************************************************************************************
+                          Unit-Annotated Fixed-Point Template Class
+***************************************************************************************************
+
+The tFixedQuantity class wraps a tFixedPoint value together with its unit, recorded at compile-time
+as the powers of amps, volts, seconds and radians in a tFixedUnit. The unit is propagated through
+"*" and "/" in the same way as the qbits are, while "+", "-", the comparisons and assignment are
+only provided for quantities with the same unit, so mixing up a current and a voltage doesn't
+compile,
+
+    typedef tFixedQuantity< tUnitAmps, 12 >   tCurrent;
+    typedef tFixedQuantity< tUnitVolts, 12 >  tVoltage;
+    typedef tFixedQuantity< tUnitOhms, 16 >   tResistance;
+
+    tVoltage drop = rs.multipliedBy( iq ).roundedTo< tVoltage >();    // Q28 volts rounded to Q12
+    tCurrent sum = ia + ib;
+    tCurrent bad = ia + vbus;                                         // Error: different units
+    tVoltage bad2 = (rs.multipliedBy( iq ) * iq).roundedTo< tVoltage >(); // Error: watt-ohms
+
+The units were picked for power electronics rather than the SI base units, so that the common
+derived units are short (ohms are volts per amp, watts volts times amps, webers volt-seconds,
+henries volt-seconds per amp). Radians are a unit of their own, so a speed in radians per second
+can't be used where one in hertz is expected without the missing factor of 2*pi, and a torque is
+in watt-seconds per radian. Other units can be declared with tFixedUnit directly, or as products
+and quotients of others with tFixedUnitProduct and tFixedUnitQuotient.
+
+A quantity is multiplied or divided by a plain tFixedPoint or an integer without changing its
+unit, and "value()" returns the unitless tFixedPoint, eg. to pass it to the functions in
+FixedPointMath.h. As with tRangedFixedPoint the precision conversions keep the unit, while the
+"roundedTo< QuantityType >()" forms also check the unit of the destination type.
+
+All of the checking is done by the types - a tFixedQuantity has the layout of its tFixedPoint, and
+every operation is the tFixedPoint one, so the checks cost nothing at run-time and can replace
+defensive conversions and sanity checks in the ISR.
+
+Note this file requires C++11.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Units
+
+/** Records a unit as the powers of amps, volts, seconds and radians it is made up of **/
+template< int Amps, int Volts, int Seconds, int Radians >
+struct tFixedUnit
+{
+    static const int cAmps = Amps;
+    static const int cVolts = Volts;
+    static const int cSeconds = Seconds;
+    static const int cRadians = Radians;
+};
+
+/** Returns the units of the product and the quotient of two quantities in "type" **/
+template< typename Unit1, typename Unit2 > struct tFixedUnitProduct
+{
+    typedef tFixedUnit< Unit1::cAmps + Unit2::cAmps, Unit1::cVolts + Unit2::cVolts,
+                        Unit1::cSeconds + Unit2::cSeconds, Unit1::cRadians + Unit2::cRadians > type;
+};
+template< typename Unit1, typename Unit2 > struct tFixedUnitQuotient
+{
+    typedef tFixedUnit< Unit1::cAmps - Unit2::cAmps, Unit1::cVolts - Unit2::cVolts,
+                        Unit1::cSeconds - Unit2::cSeconds, Unit1::cRadians - Unit2::cRadians > type;
+};
+
+typedef tFixedUnit<  0,  0,  0,  0 >  tUnitless;
+typedef tFixedUnit<  1,  0,  0,  0 >  tUnitAmps;
+typedef tFixedUnit<  0,  1,  0,  0 >  tUnitVolts;
+typedef tFixedUnit<  0,  0,  1,  0 >  tUnitSeconds;
+typedef tFixedUnit<  0,  0,  0,  1 >  tUnitRadians;
+typedef tFixedUnit<  0,  0, -1,  0 >  tUnitHertz;
+typedef tFixedUnit<  0,  0, -1,  1 >  tUnitRadiansPerSecond;
+typedef tFixedUnit< -1,  1,  0,  0 >  tUnitOhms;
+typedef tFixedUnit<  1, -1,  0,  0 >  tUnitSiemens;
+typedef tFixedUnit<  1,  1,  0,  0 >  tUnitWatts;
+typedef tFixedUnit<  1,  1,  1,  0 >  tUnitJoules;
+typedef tFixedUnit<  0,  1,  1,  0 >  tUnitWebers;
+typedef tFixedUnit< -1,  1,  1,  0 >  tUnitHenries;
+typedef tFixedUnit<  1, -1,  1,  0 >  tUnitFarads;
+typedef tFixedUnit<  1,  1,  1, -1 >  tUnitNewtonMetres;
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for unit-annotated fixed-point arithmetic. Where 'Unit' is the tFixedUnit of
+    the value, and 'QBits' and 'DataType' are as for tFixedPoint **/
+template< typename Unit, int QBits, typename DataType = int >
+class tFixedQuantity
+{
+public:
+    typedef Unit tUnit;
+    typedef DataType tValue;
+    typedef tFixedPoint< QBits, DataType > tFixed;
+    typedef typename tFixed::tCompute tCompute;
+    typedef typename tFixed::tWide tWide;
+
+    /** Records the number of qbits for this type **/
+    static const unsigned cQBits = QBits;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    /** Creates a quantity from a qValue or a unitless fixed-point value **/
+    static constexpr tFixedQuantity create( tValue qValue ) { return tFixedQuantity( tFixed::create( qValue ) ); }
+    explicit constexpr tFixedQuantity( tFixed value ) : value_( value ) {}
+
+    /** Creates a quantity from a whole number of units **/
+    explicit constexpr tFixedQuantity( tValue value ) : value_( value ) {}
+
+    constexpr tFixedQuantity() : value_() {}
+    constexpr tFixedQuantity( const tFixedQuantity& ) = default;
+    tFixedQuantity& operator=( const tFixedQuantity& ) = default;
+
+    /** Constructs a quantity from another with the same unit, which must have lower or equal
+        precision (see the tFixedPoint constructor of the same form) **/
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity( tFixedQuantity<Unit,QBits2,DataType2> value )
+        : value_( value.value() ) {}
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    explicit constexpr tFixedQuantity( double value ) : value_( value ) {}
+    double toDouble() const { return value_.toDouble(); }
+#   else
+    /** As for tFixedPoint, a floating-point value is an error rather than being truncated **/
+    template< typename FloatType, typename = typename std::enable_if< std::is_floating_point< FloatType >::value >::type >
+    tFixedQuantity( FloatType value ) = delete;
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Returns the value without its unit **/
+    constexpr tFixed value() const { return value_; }
+    constexpr tValue qValue() const { return value_.qValue(); }
+
+    float toFloat() const { return value_.toFloat(); }
+    static tFixedQuantity fromFloat( float value ) { return tFixedQuantity( tFixed::fromFloat( value ) ); }
+
+    /** Change the precision of the value, keeping its unit. See the tFixedPoint methods of the
+        same names **/
+    template< int QBits2 > constexpr tFixedQuantity<Unit,QBits2,DataType> truncatedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType>( value_.template truncatedTo< QBits2 >() ); }
+    template< int QBits2 > constexpr tFixedQuantity<Unit,QBits2,DataType> roundedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType>( value_.template roundedTo< QBits2 >() ); }
+    template< int QBits2 > constexpr tFixedQuantity<Unit,QBits2,DataType> increasedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType>( value_.template increasedTo< QBits2 >() ); }
+
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits2,DataType2> truncatedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType2>( value_.template truncatedTo< QBits2, DataType2 >() ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits2,DataType2> roundedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType2>( value_.template roundedTo< QBits2, DataType2 >() ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits2,DataType2> increasedTo() const
+        { return tFixedQuantity<Unit,QBits2,DataType2>( value_.template increasedTo< QBits2, DataType2 >() ); }
+
+    /** As above, converting to another quantity type, which must have the same unit **/
+    template< typename QuantityType > constexpr QuantityType truncatedTo() const {
+        static_assert( std::is_same< typename QuantityType::tUnit, Unit >::value, "tFixedQuantity: can't convert to a different unit" );
+        return QuantityType( value_.template truncatedTo< typename QuantityType::tFixed >() );
+    }
+    template< typename QuantityType > constexpr QuantityType roundedTo() const {
+        static_assert( std::is_same< typename QuantityType::tUnit, Unit >::value, "tFixedQuantity: can't convert to a different unit" );
+        return QuantityType( value_.template roundedTo< typename QuantityType::tFixed >() );
+    }
+    template< typename QuantityType > constexpr QuantityType increasedTo() const {
+        static_assert( std::is_same< typename QuantityType::tUnit, Unit >::value, "tFixedQuantity: can't convert to a different unit" );
+        return QuantityType( value_.template increasedTo< typename QuantityType::tFixed >() );
+    }
+
+    /** Increases the precision by that of another quantity, of any unit, normally the divisor **/
+    template< typename Unit2, int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits+QBits2,DataType2> increasedBy( tFixedQuantity<Unit2,QBits2,DataType2> value ) const
+        { return tFixedQuantity<Unit,QBits+QBits2,DataType2>( value_.increasedBy( value.value() ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Comparisons
+
+    template< int QBits2, typename DataType2 > constexpr bool operator==( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ == value.value()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator!=( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ != value.value()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator< ( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ <  value.value()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator<=( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ <= value.value()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator>=( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ >= value.value()); }
+    template< int QBits2, typename DataType2 > constexpr bool operator> ( tFixedQuantity<Unit,QBits2,DataType2> value ) const { return (value_ >  value.value()); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+    //   As with tFixedPoint the result of "+" and "-" has the precision of the left hand argument,
+    //   the result of "*" has the sum of the qbits of both arguments and "/" their difference.
+
+    constexpr tFixedQuantity operator-() const { return tFixedQuantity( -value_ ); }
+
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity operator+( tFixedQuantity<Unit,QBits2,DataType2> value ) const
+        { return tFixedQuantity( value_ + value.value() ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity operator-( tFixedQuantity<Unit,QBits2,DataType2> value ) const
+        { return tFixedQuantity( value_ - value.value() ); }
+
+    template< int QBits2, typename DataType2 > tFixedQuantity& operator+=( tFixedQuantity<Unit,QBits2,DataType2> value ) { value_ += value.value(); return *this; }
+    template< int QBits2, typename DataType2 > tFixedQuantity& operator-=( tFixedQuantity<Unit,QBits2,DataType2> value ) { value_ -= value.value(); return *this; }
+
+    /** Products and quotients of two quantities have the product or quotient of their units **/
+    template< typename Unit2, int QBits2, typename DataType2 >
+    constexpr tFixedQuantity< typename tFixedUnitProduct<Unit,Unit2>::type, QBits+QBits2, tCompute > operator*( tFixedQuantity<Unit2,QBits2,DataType2> value ) const
+        { return tFixedQuantity< typename tFixedUnitProduct<Unit,Unit2>::type, QBits+QBits2, tCompute >( value_ * value.value() ); }
+    template< typename Unit2, int QBits2, typename DataType2 >
+    constexpr tFixedQuantity< typename tFixedUnitQuotient<Unit,Unit2>::type, QBits-QBits2, DataType > operator/( tFixedQuantity<Unit2,QBits2,DataType2> value ) const
+        { return tFixedQuantity< typename tFixedUnitQuotient<Unit,Unit2>::type, QBits-QBits2, DataType >( value_ / value.value() ); }
+
+    /** As above, but calculated in the double-width tWide type (see tFixedPoint::multipliedBy) **/
+    template< typename Unit2, int QBits2, typename DataType2 >
+    constexpr tFixedQuantity< typename tFixedUnitProduct<Unit,Unit2>::type, QBits+QBits2, tWide > multipliedBy( tFixedQuantity<Unit2,QBits2,DataType2> value ) const
+        { return tFixedQuantity< typename tFixedUnitProduct<Unit,Unit2>::type, QBits+QBits2, tWide >( value_.multipliedBy( value.value() ) ); }
+
+    /** Scaling by a unitless fixed-point value or an integer keeps the unit **/
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits+QBits2,tCompute> operator*( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedQuantity<Unit,QBits+QBits2,tCompute>( value_ * value ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits-QBits2,DataType> operator/( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedQuantity<Unit,QBits-QBits2,DataType>( value_ / value ); }
+    template< int QBits2, typename DataType2 > constexpr tFixedQuantity<Unit,QBits+QBits2,tWide> multipliedBy( tFixedPoint<QBits2,DataType2> value ) const
+        { return tFixedQuantity<Unit,QBits+QBits2,tWide>( value_.multipliedBy( value ) ); }
+
+    constexpr tFixedQuantity operator*( tValue value ) const { return tFixedQuantity( value_ * value ); }
+    constexpr tFixedQuantity operator/( tValue value ) const { return tFixedQuantity( value_ / value ); }
+
+    template< int QBits2, typename DataType2 > tFixedQuantity& operator*=( tFixedPoint<QBits2,DataType2> value ) { value_ *= value; return *this; }
+    template< int QBits2, typename DataType2 > tFixedQuantity& operator/=( tFixedPoint<QBits2,DataType2> value ) { value_ /= value; return *this; }
+    tFixedQuantity& operator*=( tValue value ) { value_ *= value; return *this; }
+    tFixedQuantity& operator/=( tValue value ) { value_ /= value; return *this; }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    tFixed  value_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+template< typename Unit, int QBits, typename DataType > constexpr tFixedQuantity<Unit,QBits,DataType> operator*( DataType lhs, tFixedQuantity<Unit,QBits,DataType> rhs ) { return rhs * lhs; }
+template< typename Unit, int QBits, typename DataType, int QBits2, typename DataType2 >
+constexpr tFixedQuantity<Unit,QBits+QBits2,typename tFixedPoint<QBits2,DataType2>::tCompute> operator*( tFixedPoint<QBits2,DataType2> lhs, tFixedQuantity<Unit,QBits,DataType> rhs )
+    { return tFixedQuantity<Unit,QBits+QBits2,typename tFixedPoint<QBits2,DataType2>::tCompute>( lhs * rhs.value() ); }
+
+/** Returns a fixed-point value as a quantity of 'Unit', mainly for use with the fixed-point
+    literals. eg. "fixedQuantity< tUnitAmps >( 1.5_q12 )" **/
+template< typename Unit, int QBits, typename DataType > constexpr tFixedQuantity<Unit,QBits,DataType> fixedQuantity( tFixedPoint<QBits,DataType> value )
+    { return tFixedQuantity<Unit,QBits,DataType>( value ); }
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
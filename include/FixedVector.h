@@ -0,0 +1,370 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides 2-element vector and complex fixed-point types, for
+//   the pairs of values (alpha/beta, d/q, sin/cos) used by motor control.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FIXEDVECTOR_H
+#define FIXEDVECTOR_H
+
+#include "FixedPoint.h"
+#include "FixedPointMath.h"
+#include "FixedPointTarget.h"
+#include "FixedAngle.h"
+#include "FocTransform.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point Vector and Complex Template Classes
+***************************************************************************************************
+
+Most of the signals in motor control come in pairs, and written out a component at a time the
+common operations on them round each product separately. The classes here hold a pair of
+tFixedPoint values with 'QBits' qbits, and do those operations with every product kept at full
+precision in 64 bits, rounding (to the nearest value) and saturating just once at the end,
+
+    tFixedVec2< QBits, DataType >       a vector with members x and y, which converts to and from
+                                        tAlphaBeta and tDq (see FocTransform.h).
+    tFixedComplex< QBits, DataType >    a complex number with members re and im.
+
+For example, with Q12 currents and a voltage vector limited to the bus voltage,
+
+    tFixedVec2< 12 > i( ia12, ib12 );
+    tFixedVec2< 12 > idq = i.rotated< 12 >( sincos< 15 >( -theta ) );     // theta is a tFixedAngle
+    tQ12 magnitude = idq.magnitude< 12 >();
+    tFixedVec2< 12 > v = vdq.limited( vbus12 );                           // keeps the angle
+
+The operations are,
+
+    +, -, unary -, ==, !=               componentwise, wrapping as tFixedPoint does.
+    dot( v ), cross( v )                the full-precision dot (x1*x2 + y1*y2) and cross (x1*y2 -
+                                        y1*x2) products, as a tFixedPoint< QBits+QBits2, long long >.
+    rotated< QOut >( sc or angle )      rotated by the angle whose sin and cos are 'sc' (a tSinCos)
+                                        or by a tFixedAngle, counter-clockwise.
+    scaled< QOut >( k )                 multiplied by the scalar 'k'.
+    magnitude< QOut >()                 sqrt(x^2 + y^2), to within an LSB, using an integer square
+                                        root of the 64-bit sum with no division.
+    approxMagnitude< QOut >()           alpha*max + beta*min of |x| and |y|, with the alpha and beta
+                                        that give the least peak error (about 4%), for when that's
+                                        good enough - it is just two multiplies.
+    limited( limit )                    the vector scaled down to a magnitude of 'limit' if it is
+                                        longer, keeping its direction (the result is within an LSB).
+                                        It needs a division only when the vector is limited.
+    roundedTo< QOut >(), ...            each component converted as by tFixedPoint.
+
+tFixedComplex has the same operations (with "abs" and "approxAbs" for the magnitude) plus,
+
+    z * w, z.multipliedBy( w )          the full-precision complex product, as a tFixedComplex<
+                                        QBits+QBits2, long long > (ie. in the wide accumulator).
+    z.multiplied< QOut >( w )           the product rounded and saturated once.
+    z *= w                              the product rounded back to the type of z.
+    conj(), norm()                      the conjugate, and re^2 + im^2 at full precision.
+    fromSinCos( sc ), fromAngle( a )    the unit complex number cos + i*sin of an angle.
+
+For 16-bit data-types both members fit in one 32-bit word, with x (or re) in the bottom half, and
+"packed" and "unpacked" convert to and from that word. On targets with the DSP extension's SIMD
+instructions (Cortex-M4, M7, M33) the products of 16-bit vectors can be done by the dual 16x16
+multiply-accumulate instructions SMLALD, SMLSLD, SMLALDX and SMLSLDX on the packed words, so a
+complex multiply (or rotation by a Q15 tSinCos) is two instructions. These accumulate in 64 bits,
+so give exactly the same results as the generic versions. As they haven't been built for a target
+yet they are only used with FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS defined, see FixedPointTarget.h.
+
+The classes only support data-types of 32 bits or less.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Helpers for the products and magnitudes of pairs of raw values **/
+struct tFixedVector_
+{
+    /** Return x1*x2 + y1*y2, x1*y2 - y1*x2, x1*x2 - y1*y2 and x1*y2 + y1*x2 at full precision **/
+    template< typename DT1, typename DT2 > static long long dot( DT1 x1, DT1 y1, DT2 x2, DT2 y2 ) { return (long long)( x1 )*x2 + (long long)( y1 )*y2; }
+    template< typename DT1, typename DT2 > static long long cross( DT1 x1, DT1 y1, DT2 x2, DT2 y2 ) { return (long long)( x1 )*y2 - (long long)( y1 )*x2; }
+    template< typename DT1, typename DT2 > static long long real( DT1 x1, DT1 y1, DT2 x2, DT2 y2 ) { return (long long)( x1 )*x2 - (long long)( y1 )*y2; }
+    template< typename DT1, typename DT2 > static long long imaginary( DT1 x1, DT1 y1, DT2 x2, DT2 y2 ) { return (long long)( x1 )*y2 + (long long)( y1 )*x2; }
+
+    /** Returns a pair of 16-bit values packed into a word, 'x' in the bottom half **/
+    static unsigned pack( short x, short y ) { return unsigned( (unsigned short)( x ) ) | (unsigned( (unsigned short)( y ) ) << 16); }
+
+#   if defined(FIXEDPOINT_TARGET_SIMD32)     // only with FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS
+    static long long dot( short x1, short y1, short x2, short y2 ) { return __smlald( int( pack( x1, y1 ) ), int( pack( x2, y2 ) ), 0 ); }
+    static long long cross( short x1, short y1, short x2, short y2 ) { return __smlsldx( int( pack( x1, y1 ) ), int( pack( x2, y2 ) ), 0 ); }
+    static long long real( short x1, short y1, short x2, short y2 ) { return __smlsld( int( pack( x1, y1 ) ), int( pack( x2, y2 ) ), 0 ); }
+    static long long imaginary( short x1, short y1, short x2, short y2 ) { return __smlaldx( int( pack( x1, y1 ) ), int( pack( x2, y2 ) ), 0 ); }
+#   endif
+
+    /** Returns a raw 'value' with 'fromQ' qbits rounded to 'QOut' qbits and saturated to DataType **/
+    template< int QOut, typename DataType > static tFixedPoint<QOut,DataType> result( long long value, int fromQ )
+        { return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( value, fromQ, QOut ) ) ); }
+
+    /** Returns the integer square-root of 'value', rounded to the nearest integer **/
+    static unsigned long long isqrt( unsigned long long value ) {
+        unsigned long long root = 0, bit = 1ull << 62;
+        while (bit > value) bit >>= 2;
+        while (bit != 0) {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        // what is left is value - root^2, and (root + 1/2)^2 = root^2 + root + 1/4
+        return (value > root)? root + 1 : root;
+    }
+
+    /** Returns sqrt(x^2 + y^2) for raw values with 'qBits' qbits, with qBits+'extraQBits' qbits
+        where extraQBits is as large as the 64-bit sum allows **/
+    static long long magnitude( long long x, long long y, int& extraQBits ) {
+        const unsigned long long sum = (unsigned long long)( x*x ) + (unsigned long long)( y*y );
+        int n = 0;
+        while (n < 62 && (sum >> (62 - n)) == 0) n += 2;
+        extraQBits = n/2;
+        return (long long)( isqrt( sum << n ) );
+    }
+
+    /** Returns alpha*max + beta*min of |x| and |y|, with cApproxQBits more qbits than them **/
+    static const int cApproxQBits = 16;
+    static long long approxMagnitude( long long x, long long y ) {
+        const long long cAlpha = 62943;             // 0.96043387 in Q16
+        const long long cBeta = 26072;              // 0.39782473 in Q16
+        x = (x < 0)? -x : x;
+        y = (y < 0)? -y : y;
+        return (x > y)? (cAlpha*x + cBeta*y) : (cAlpha*y + cBeta*x);
+    }
+
+    /** Scales the raw vector ('x','y') down to a magnitude of 'limit' if it is longer **/
+    template< typename DataType > static void limit( DataType& x, DataType& y, long long limit ) {
+        if (limit <= 0) {
+            x = y = 0;
+            return;
+        }
+        const unsigned long long sum = (unsigned long long)( (long long)( x )*x ) + (unsigned long long)( (long long)( y )*y );
+        if (sum <= (unsigned long long)( limit*limit )) return;
+
+        // scale both by limit/|v| in Q31, which is below 1
+        int extra;
+        const long long m = magnitude( x, y, extra );
+        const long long f = (long long)( ((unsigned long long)( limit ) << 31) / (unsigned long long)( (m + (1ll << extra) - 1) >> extra ) );
+        x = DataType( ((long long)( x )*f) / (1ll << 31) );
+        y = DataType( ((long long)( y )*f) / (1ll << 31) );
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Vector
+
+/** Template class for a 2-element vector of fixed-point values with 'QBits' qbits **/
+template< int QBits, typename DataType = int >
+struct tFixedVec2
+{
+    typedef tFixedPoint< QBits, DataType > tFixed;
+    static const unsigned cQBits = QBits;
+
+    static_assert( sizeof(DataType) <= sizeof(int), "fixed-point vectors only support data-types of 32 bits or less" );
+
+    tFixed x;
+    tFixed y;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    constexpr tFixedVec2() : x(), y() {}
+    constexpr tFixedVec2( tFixed x_, tFixed y_ ) : x( x_ ), y( y_ ) {}
+    constexpr tFixedVec2( const tAlphaBeta<QBits,DataType>& ab ) : x( ab.alpha ), y( ab.beta ) {}
+    constexpr tFixedVec2( const tDq<QBits,DataType>& dq ) : x( dq.d ), y( dq.q ) {}
+
+    /** Returns the vector as an alpha/beta or d/q pair **/
+    tAlphaBeta<QBits,DataType> alphaBeta() const { tAlphaBeta<QBits,DataType> ab; ab.alpha = x; ab.beta = y; return ab; }
+    tDq<QBits,DataType> dq() const { tDq<QBits,DataType> v; v.d = x; v.q = y; return v; }
+
+    /** Convert a vector of 16-bit values to and from a packed word, with x in the bottom half **/
+    unsigned packed() const {
+        static_assert( sizeof(DataType) == 2, "only vectors of 16-bit values can be packed" );
+        return tFixedVector_::pack( short( x.qValue() ), short( y.qValue() ) );
+    }
+    static tFixedVec2 unpacked( unsigned word ) {
+        static_assert( sizeof(DataType) == 2, "only vectors of 16-bit values can be packed" );
+        return tFixedVec2( tFixed::create( DataType( word & 0xFFFF ) ), tFixed::create( DataType( word >> 16 ) ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    constexpr tFixedVec2 operator+( tFixedVec2 v ) const { return tFixedVec2( x + v.x, y + v.y ); }
+    constexpr tFixedVec2 operator-( tFixedVec2 v ) const { return tFixedVec2( x - v.x, y - v.y ); }
+    constexpr tFixedVec2 operator-() const { return tFixedVec2( -x, -y ); }
+    tFixedVec2& operator+=( tFixedVec2 v ) { x += v.x; y += v.y; return *this; }
+    tFixedVec2& operator-=( tFixedVec2 v ) { x -= v.x; y -= v.y; return *this; }
+    constexpr bool operator==( tFixedVec2 v ) const { return x == v.x && y == v.y; }
+    constexpr bool operator!=( tFixedVec2 v ) const { return !(*this == v); }
+
+    /** Return the full-precision dot and cross products with 'v' **/
+    template< int QBits2, typename DataType2 > tFixedPoint<QBits+QBits2,long long> dot( tFixedVec2<QBits2,DataType2> v ) const
+        { return tFixedPoint<QBits+QBits2,long long>::create( tFixedVector_::dot( x.qValue(), y.qValue(), v.x.qValue(), v.y.qValue() ) ); }
+    template< int QBits2, typename DataType2 > tFixedPoint<QBits+QBits2,long long> cross( tFixedVec2<QBits2,DataType2> v ) const
+        { return tFixedPoint<QBits+QBits2,long long>::create( tFixedVector_::cross( x.qValue(), y.qValue(), v.x.qValue(), v.y.qValue() ) ); }
+
+    /** Returns the vector rotated counter-clockwise by the angle whose sin and cos are 'sc', or by
+        an 'angle', with 'QOut' qbits **/
+    template< int QOut, typename DataTypeOut = DataType, int QBits2, typename DataType2 > tFixedVec2<QOut,DataTypeOut> rotated( tSinCos<QBits2,DataType2> sc ) const {
+        const DataType2 c = sc.cos.qValue(), s = sc.sin.qValue();
+        return tFixedVec2<QOut,DataTypeOut>( tFixedVector_::result< QOut, DataTypeOut >( tFixedVector_::real( x.qValue(), y.qValue(), c, s ), QBits + QBits2 ),
+                                             tFixedVector_::result< QOut, DataTypeOut >( tFixedVector_::imaginary( x.qValue(), y.qValue(), c, s ), QBits + QBits2 ) );
+    }
+    template< int QOut, typename DataTypeOut = DataType, typename StorageType > tFixedVec2<QOut,DataTypeOut> rotated( tFixedAngle<StorageType> angle ) const
+        { return rotated< QOut, DataTypeOut >( sincos< 30 >( angle ) ); }
+
+    /** Returns the vector multiplied by the scalar 'k', with 'QOut' qbits **/
+    template< int QOut, typename DataTypeOut = DataType, int QBits2, typename DataType2 > tFixedVec2<QOut,DataTypeOut> scaled( tFixedPoint<QBits2,DataType2> k ) const {
+        return tFixedVec2<QOut,DataTypeOut>( tFixedVector_::result< QOut, DataTypeOut >( (long long)( x.qValue() )*k.qValue(), QBits + QBits2 ),
+                                             tFixedVector_::result< QOut, DataTypeOut >( (long long)( y.qValue() )*k.qValue(), QBits + QBits2 ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Magnitude
+
+    /** Return the magnitude, or an approximation of it (see above), with 'QOut' qbits **/
+    template< int QOut, typename DataTypeOut = DataType > tFixedPoint<QOut,DataTypeOut> magnitude() const {
+        int extra;
+        const long long m = tFixedVector_::magnitude( x.qValue(), y.qValue(), extra );
+        return tFixedVector_::result< QOut, DataTypeOut >( m, QBits + extra );
+    }
+    template< int QOut, typename DataTypeOut = DataType > tFixedPoint<QOut,DataTypeOut> approxMagnitude() const
+        { return tFixedVector_::result< QOut, DataTypeOut >( tFixedVector_::approxMagnitude( x.qValue(), y.qValue() ), QBits + tFixedVector_::cApproxQBits ); }
+
+    /** Returns the vector scaled down to a magnitude of 'limit' if it is longer, keeping its
+        direction. A negative limit gives a zero vector **/
+    tFixedVec2 limited( tFixed limit ) const {
+        DataType vx = x.qValue(), vy = y.qValue();
+        tFixedVector_::limit( vx, vy, limit.qValue() );
+        return tFixedVec2( tFixed::create( vx ), tFixed::create( vy ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Return each component converted, as by the same tFixedPoint methods **/
+    template< int QOut > tFixedVec2<QOut,DataType> roundedTo() const { return tFixedVec2<QOut,DataType>( x.template roundedTo< QOut >(), y.template roundedTo< QOut >() ); }
+    template< int QOut > tFixedVec2<QOut,DataType> truncatedTo() const { return tFixedVec2<QOut,DataType>( x.template truncatedTo< QOut >(), y.template truncatedTo< QOut >() ); }
+    template< int QOut, typename DataTypeOut > tFixedVec2<QOut,DataTypeOut> roundedTo() const
+        { return tFixedVec2<QOut,DataTypeOut>( x.template roundedTo< QOut, DataTypeOut >(), y.template roundedTo< QOut, DataTypeOut >() ); }
+    template< int QOut, typename DataTypeOut > tFixedVec2<QOut,DataTypeOut> truncatedTo() const
+        { return tFixedVec2<QOut,DataTypeOut>( x.template truncatedTo< QOut, DataTypeOut >(), y.template truncatedTo< QOut, DataTypeOut >() ); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Complex
+
+/** Template class for a complex number with fixed-point parts with 'QBits' qbits **/
+template< int QBits, typename DataType = int >
+struct tFixedComplex
+{
+    typedef tFixedPoint< QBits, DataType > tFixed;
+    static const unsigned cQBits = QBits;
+
+    tFixed re;
+    tFixed im;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    constexpr tFixedComplex() : re(), im() {}
+    constexpr tFixedComplex( tFixed re_, tFixed im_ = tFixed() ) : re( re_ ), im( im_ ) {}
+    explicit constexpr tFixedComplex( tFixedVec2<QBits,DataType> v ) : re( v.x ), im( v.y ) {}
+
+    /** Returns the complex number as a vector **/
+    constexpr tFixedVec2<QBits,DataType> vec() const { return tFixedVec2<QBits,DataType>( re, im ); }
+
+    /** Return the unit complex number cos + i*sin of an angle **/
+    template< int QBits2, typename DataType2 > static tFixedComplex fromSinCos( tSinCos<QBits2,DataType2> sc )
+        { return tFixedComplex( tFixedVector_::result< QBits, DataType >( sc.cos.qValue(), QBits2 ), tFixedVector_::result< QBits, DataType >( sc.sin.qValue(), QBits2 ) ); }
+    template< typename StorageType > static tFixedComplex fromAngle( tFixedAngle<StorageType> angle ) {
+        tSinCos<QBits,DataType> sc = sincos< QBits, DataType >( angle );
+        return tFixedComplex( sc.cos, sc.sin );
+    }
+
+    /** Convert 16-bit parts to and from a packed word, with re in the bottom half **/
+    unsigned packed() const { return vec().packed(); }
+    static tFixedComplex unpacked( unsigned word ) { return tFixedComplex( tFixedVec2<QBits,DataType>::unpacked( word ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    constexpr tFixedComplex operator+( tFixedComplex z ) const { return tFixedComplex( re + z.re, im + z.im ); }
+    constexpr tFixedComplex operator-( tFixedComplex z ) const { return tFixedComplex( re - z.re, im - z.im ); }
+    constexpr tFixedComplex operator-() const { return tFixedComplex( -re, -im ); }
+    constexpr tFixedComplex conj() const { return tFixedComplex( re, -im ); }
+    tFixedComplex& operator+=( tFixedComplex z ) { re += z.re; im += z.im; return *this; }
+    tFixedComplex& operator-=( tFixedComplex z ) { re -= z.re; im -= z.im; return *this; }
+    constexpr bool operator==( tFixedComplex z ) const { return re == z.re && im == z.im; }
+    constexpr bool operator!=( tFixedComplex z ) const { return !(*this == z); }
+
+    /** Return the full-precision product with 'z' **/
+    template< int QBits2, typename DataType2 > tFixedComplex<QBits+QBits2,long long> multipliedBy( tFixedComplex<QBits2,DataType2> z ) const {
+        typedef tFixedPoint<QBits+QBits2,long long> tWide;
+        return tFixedComplex<QBits+QBits2,long long>( tWide::create( tFixedVector_::real( re.qValue(), im.qValue(), z.re.qValue(), z.im.qValue() ) ),
+                                                      tWide::create( tFixedVector_::imaginary( re.qValue(), im.qValue(), z.re.qValue(), z.im.qValue() ) ) );
+    }
+    template< int QBits2, typename DataType2 > tFixedComplex<QBits+QBits2,long long> operator*( tFixedComplex<QBits2,DataType2> z ) const { return multipliedBy( z ); }
+
+    /** Returns the product with 'z' rounded and saturated once, with 'QOut' qbits **/
+    template< int QOut, typename DataTypeOut = DataType, int QBits2, typename DataType2 > tFixedComplex<QOut,DataTypeOut> multiplied( tFixedComplex<QBits2,DataType2> z ) const {
+        return tFixedComplex<QOut,DataTypeOut>( tFixedVector_::result< QOut, DataTypeOut >( tFixedVector_::real( re.qValue(), im.qValue(), z.re.qValue(), z.im.qValue() ), QBits + QBits2 ),
+                                                tFixedVector_::result< QOut, DataTypeOut >( tFixedVector_::imaginary( re.qValue(), im.qValue(), z.re.qValue(), z.im.qValue() ), QBits + QBits2 ) );
+    }
+    template< int QBits2, typename DataType2 > tFixedComplex& operator*=( tFixedComplex<QBits2,DataType2> z ) { return *this = multiplied< QBits >( z ); }
+
+    /** Returns re^2 + im^2 at full precision **/
+    tFixedPoint<QBits+QBits,long long> norm() const { return vec().dot( vec() ); }
+
+    /** Return the magnitude, or an approximation of it, with 'QOut' qbits **/
+    template< int QOut, typename DataTypeOut = DataType > tFixedPoint<QOut,DataTypeOut> abs() const { return vec().template magnitude< QOut, DataTypeOut >(); }
+    template< int QOut, typename DataTypeOut = DataType > tFixedPoint<QOut,DataTypeOut> approxAbs() const { return vec().template approxMagnitude< QOut, DataTypeOut >(); }
+
+    /** Returns the complex number scaled down to a magnitude of 'limit' if it is larger **/
+    tFixedComplex limited( tFixed limit ) const { return tFixedComplex( vec().limited( limit ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Return each part converted, as by the same tFixedPoint methods **/
+    template< int QOut > tFixedComplex<QOut,DataType> roundedTo() const { return tFixedComplex<QOut,DataType>( re.template roundedTo< QOut >(), im.template roundedTo< QOut >() ); }
+    template< int QOut > tFixedComplex<QOut,DataType> truncatedTo() const { return tFixedComplex<QOut,DataType>( re.template truncatedTo< QOut >(), im.template truncatedTo< QOut >() ); }
+    template< int QOut, typename DataTypeOut > tFixedComplex<QOut,DataTypeOut> roundedTo() const
+        { return tFixedComplex<QOut,DataTypeOut>( re.template roundedTo< QOut, DataTypeOut >(), im.template roundedTo< QOut, DataTypeOut >() ); }
+    template< int QOut, typename DataTypeOut > tFixedComplex<QOut,DataTypeOut> truncatedTo() const
+        { return tFixedComplex<QOut,DataTypeOut>( re.template truncatedTo< QOut, DataTypeOut >(), im.template truncatedTo< QOut, DataTypeOut >() ); }
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
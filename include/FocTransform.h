@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides the fixed-point Clarke, Park and inverse Park
+//   transforms and space-vector PWM used by field oriented control.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef FOCTRANSFORM_H
+#define FOCTRANSFORM_H
+
+#include "FixedPoint.h"
+#include "FixedPointMath.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point FOC Transforms
+***************************************************************************************************
+
+This file provides the transforms run every PWM period by field oriented control, all of which
+take the number of qbits of the result 'QOut' as their first template argument,
+
+    clarke< QOut >( ia, ib )                    phase currents to alpha/beta (ic = -ia - ib)
+    park< QOut >( alphaBeta, sc )               alpha/beta to d/q, 'sc' is a tSinCos of the angle
+    clarkePark< QOut >( ia, ib, sc )            both of the above at once
+    inversePark< QOut >( dq, sc )               d/q to alpha/beta
+    svpwm< QOut >( alphaBeta )                  alpha/beta voltages to phase duty cycles
+    inverseParkSvpwm< QOut >( dq, sc )          both of the above at once
+    sector( alphaBeta )                         the space-vector sector, 1 to 6
+
+For example, with Q12 currents and voltages that have been divided by the DC bus voltage (eg.
+using tReciprocal from FixedPointDivide.h),
+
+    tSinCos< 15 > sc = sincos< 15 >( theta12 );
+    tDq< 12 > idq = clarkePark< 12 >( ia12, ib12, sc );
+    ...
+    tAbc< 16 > duty = inverseParkSvpwm< 16 >( vdq12, sc );      // 0 to 1 for each phase
+
+The fused versions keep every intermediate at full precision in 64 bits, using only 32x32->64 bit
+multiplies, and round and saturate just once at the end. The constants 1/sqrt(3) and sqrt(3)/2 are
+folded into the sin/cos coefficients rather than applied to the data, keeping an extra 14 qbits
+(or fewer for a sin/cos with more than 16 qbits, so that the coefficients still fit in 32 bits and
+the products in 64). A sin/cos with more than 30 qbits is rounded to Q30 first.
+
+The SVPWM uses min/max zero-sequence injection, which gives the same duty cycles as the sector
+based calculation without any table or division. The duty cycles are clamped to [0,1], so vectors
+outside the hexagon (overmodulation) are limited rather than wrapping. Voltages must be normalised
+to the bus voltage, when a duty cycle step of 1 corresponds to the full bus voltage.
+
+The transforms only support data-types of 32 bits or less. Use FixedPoint_bench.cpp to measure the
+cycles taken on a target.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Vector Types
+
+/** A vector in the stationary two-phase (alpha/beta) frame **/
+template< int QBits, typename DataType = int >
+struct tAlphaBeta
+{
+    tFixedPoint< QBits, DataType > alpha;
+    tFixedPoint< QBits, DataType > beta;
+};
+
+/** A vector in the rotating (d/q) frame **/
+template< int QBits, typename DataType = int >
+struct tDq
+{
+    tFixedPoint< QBits, DataType > d;
+    tFixedPoint< QBits, DataType > q;
+};
+
+/** A value for each of the three phases **/
+template< int QBits, typename DataType = int >
+struct tAbc
+{
+    tFixedPoint< QBits, DataType > a;
+    tFixedPoint< QBits, DataType > b;
+    tFixedPoint< QBits, DataType > c;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+struct tFoc_
+{
+    static const int cConstantQBits = 30;
+    static const long long cInvSqrt3 = 619925131ll;         // 1/sqrt(3) in Q30
+    static const long long cSqrt3By2 = 929887697ll;         // sqrt(3)/2 in Q30
+    static const int cFoldedQBits = 14;
+    static const int cMaxTrigQBits = 30;
+
+    /** Returns the qbits a sin or cos with 'qTrig' qbits is used with by the fused kernels, and the
+        number of extra qbits kept once a constant has been folded into it. The two never add up
+        to more than cMaxTrigQBits, so that a folded coefficient fits in 32 bits, and a product
+        of it with a 32-bit value (plus the sum of two of them) fits in 64 **/
+    static constexpr int trigQBits( int qTrig ) { return (qTrig < cMaxTrigQBits)? qTrig : cMaxTrigQBits; }
+    static constexpr int foldedQBits( int qTrig )
+        { return (trigQBits( qTrig ) + cFoldedQBits <= cMaxTrigQBits)? cFoldedQBits : cMaxTrigQBits - trigQBits( qTrig ); }
+
+    /** Returns a sin or cos 'value' with 'qTrig' qbits rounded to trigQBits( qTrig ) qbits **/
+    static long long trig( long long value, int qTrig ) { return tFixedMath_::rescaled( value, qTrig, trigQBits( qTrig ) ); }
+
+    /** Returns a sin or cos 'coefficient' scaled by a Q30 'constant', with 'foldQBits' more qbits
+        than the coefficient **/
+    static int folded( long long coefficient, long long constant, int foldQBits )
+        { return int( (coefficient * constant + (1ll << (cConstantQBits - foldQBits - 1))) >> (cConstantQBits - foldQBits) ); }
+
+    /** Returns a 'value' with 'fromQ' qbits rounded to 'toQ' qbits and saturated to DataType **/
+    template< int QOut, typename DataType > static tFixedPoint<QOut,DataType> result( long long value, int fromQ )
+        { return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( tFixedMath_::rescaled( value, fromQ, QOut ) ) ); }
+
+    /** Returns 'value' with 'fromQ' qbits rounded to a duty cycle with 'QOut' qbits, clamped to [0,1] **/
+    template< int QOut, typename DataType > static tFixedPoint<QOut,DataType> duty( long long value, int fromQ ) {
+        long long d = tFixedMath_::rescaled( value, fromQ, QOut );
+        long long cOne = 1ll << QOut;
+        return tFixedPoint<QOut,DataType>::create( tFixedMath_::clamped<DataType>( (d < 0)? 0 : (d > cOne)? cOne : d ) );
+    }
+
+    /** Returns the duty cycles for phase voltages 'va', 'vb' and 'vc' that are all scaled by 2,
+        with 'qBits' qbits. The zero-sequence offset -(max + min)/2 centres them in the PWM period **/
+    template< int QOut, typename DataType > static tAbc<QOut,DataType> duties( long long va, long long vb, long long vc, int qBits ) {
+        long long max = (va > vb)? va : vb;
+        long long min = (va < vb)? va : vb;
+        max = (vc > max)? vc : max;
+        min = (vc < min)? vc : min;
+
+        // 4*duty = 2 + 2*(2v) - (max + min), which keeps everything in integers
+        long long base = (2ll << qBits) - (max + min);
+        tAbc<QOut,DataType> result;
+        result.a = duty< QOut, DataType >( base + 2*va, qBits + 2 );
+        result.b = duty< QOut, DataType >( base + 2*vb, qBits + 2 );
+        result.c = duty< QOut, DataType >( base + 2*vc, qBits + 2 );
+        return result;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Transforms
+
+/** Returns the alpha/beta vector for the phase currents 'a' and 'b' (assuming c = -a - b) **/
+template< int QOut, int QBits, typename DataType > tAlphaBeta<QOut,DataType> clarke( tFixedPoint<QBits,DataType> a, tFixedPoint<QBits,DataType> b ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "clarke" );
+    tAlphaBeta<QOut,DataType> result;
+    result.alpha = tFoc_::result< QOut, DataType >( a.qValue(), QBits );
+    result.beta = tFoc_::result< QOut, DataType >( ((long long)( a.qValue() ) + 2ll*b.qValue()) * tFoc_::cInvSqrt3, QBits + tFoc_::cConstantQBits );
+    return result;
+}
+
+/** Returns the d/q vector for an alpha/beta vector 'ab', given the sin and cos of the angle 'sc' **/
+template< int QOut, int QBits, typename DataType, int QTrig > tDq<QOut,DataType> park( const tAlphaBeta<QBits,DataType>& ab, const tSinCos<QTrig,DataType>& sc ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "park" );
+    long long alpha = ab.alpha.qValue(), beta = ab.beta.qValue();
+    DataType s = sc.sin.qValue(), c = sc.cos.qValue();
+    tDq<QOut,DataType> result;
+    result.d = tFoc_::result< QOut, DataType >( alpha*c + beta*s, QBits + QTrig );
+    result.q = tFoc_::result< QOut, DataType >( beta*c - alpha*s, QBits + QTrig );
+    return result;
+}
+
+/** Returns the d/q vector for the phase currents 'a' and 'b', given the sin and cos of the angle
+    'sc', with a single rounding of each result **/
+template< int QOut, int QBits, typename DataType, int QTrig > tDq<QOut,DataType> clarkePark( tFixedPoint<QBits,DataType> a, tFixedPoint<QBits,DataType> b, const tSinCos<QTrig,DataType>& sc ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "clarke-park" );
+    // beta = (a + 2b)/sqrt(3), with the 1/sqrt(3) folded into the sin and cos
+    const int cTrigQBits = tFoc_::trigQBits( QTrig ), cFoldQBits = tFoc_::foldedQBits( QTrig );
+    long long alpha = a.qValue(), sum = (long long)( a.qValue() ) + 2ll*b.qValue();
+    long long s = tFoc_::trig( sc.sin.qValue(), QTrig ), c = tFoc_::trig( sc.cos.qValue(), QTrig );
+    int s3 = tFoc_::folded( s, tFoc_::cInvSqrt3, cFoldQBits ), c3 = tFoc_::folded( c, tFoc_::cInvSqrt3, cFoldQBits );
+    tDq<QOut,DataType> result;
+    result.d = tFoc_::result< QOut, DataType >( alpha*c*(1ll << cFoldQBits) + sum*s3, QBits + cTrigQBits + cFoldQBits );
+    result.q = tFoc_::result< QOut, DataType >( sum*c3 - alpha*s*(1ll << cFoldQBits), QBits + cTrigQBits + cFoldQBits );
+    return result;
+}
+
+/** Returns the alpha/beta vector for a d/q vector 'dq', given the sin and cos of the angle 'sc' **/
+template< int QOut, int QBits, typename DataType, int QTrig > tAlphaBeta<QOut,DataType> inversePark( const tDq<QBits,DataType>& dq, const tSinCos<QTrig,DataType>& sc ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "inverse park" );
+    long long d = dq.d.qValue(), q = dq.q.qValue();
+    DataType s = sc.sin.qValue(), c = sc.cos.qValue();
+    tAlphaBeta<QOut,DataType> result;
+    result.alpha = tFoc_::result< QOut, DataType >( d*c - q*s, QBits + QTrig );
+    result.beta = tFoc_::result< QOut, DataType >( d*s + q*c, QBits + QTrig );
+    return result;
+}
+
+/** Returns the phase duty cycles, 0 to 1 with 'QOut' qbits, for an alpha/beta voltage 'ab'
+    normalised to the bus voltage **/
+template< int QOut, int QBits, typename DataType > tAbc<QOut,DataType> svpwm( const tAlphaBeta<QBits,DataType>& ab ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    FIXEDPOINT_PROFILE( "svpwm" );
+    // (2*sqrt(3)/2)*beta, with the constant's qbits
+    long long alpha = FIXEDPOINT_IMPL_SHIFTUP( (long long)( ab.alpha.qValue() ), tFoc_::cConstantQBits );
+    long long beta = 2*tFoc_::cSqrt3By2*ab.beta.qValue();
+    return tFoc_::duties< QOut, DataType >( 2*alpha, beta - alpha, -beta - alpha, QBits + tFoc_::cConstantQBits );
+}
+
+/** Returns the phase duty cycles for a d/q voltage 'dq' normalised to the bus voltage, given the
+    sin and cos of the angle 'sc', with a single rounding of each duty cycle. Voltages up to twice
+    the bus voltage are supported **/
+template< int QOut, int QBits, typename DataType, int QTrig > tAbc<QOut,DataType> inverseParkSvpwm( const tDq<QBits,DataType>& dq, const tSinCos<QTrig,DataType>& sc ) {
+    static_assert( sizeof(DataType) <= sizeof(int), "FOC transforms only support data-types of 32 bits or less" );
+    static_assert( QBits + tFoc_::trigQBits( QTrig ) + tFoc_::foldedQBits( QTrig ) <= 57, "the voltage has too many qbits for the duty cycles to be calculated in 64 bits" );
+    FIXEDPOINT_PROFILE( "inverse park-svpwm" );
+    // alpha, and sqrt(3)/2*beta with the sqrt(3)/2 folded into the sin and cos
+    const int cTrigQBits = tFoc_::trigQBits( QTrig ), cFoldQBits = tFoc_::foldedQBits( QTrig );
+    long long d = dq.d.qValue(), q = dq.q.qValue();
+    long long s = tFoc_::trig( sc.sin.qValue(), QTrig ), c = tFoc_::trig( sc.cos.qValue(), QTrig );
+    int s3 = tFoc_::folded( s, tFoc_::cSqrt3By2, cFoldQBits ), c3 = tFoc_::folded( c, tFoc_::cSqrt3By2, cFoldQBits );
+    long long alpha = (d*c - q*s)*(1ll << cFoldQBits);
+    long long beta = 2*(d*s3 + q*c3);
+    return tFoc_::duties< QOut, DataType >( 2*alpha, beta - alpha, -beta - alpha, QBits + cTrigQBits + cFoldQBits );
+}
+
+/** Returns the space-vector sector, 1 to 6 anticlockwise from the alpha axis, of 'ab' **/
+template< int QBits, typename DataType > unsigned sector( const tAlphaBeta<QBits,DataType>& ab ) {
+    // the signs of beta, and of the two 60 degree lines sqrt(3)*alpha -+ beta
+    long long alpha = (long long)( ab.alpha.qValue() ) * (2*tFoc_::cSqrt3By2), beta = FIXEDPOINT_IMPL_SHIFTUP( (long long)( ab.beta.qValue() ), tFoc_::cConstantQBits );
+    unsigned n = (beta >= 0? 1u : 0u) | (alpha - beta > 0? 2u : 0u) | (-alpha - beta > 0? 4u : 0u);
+    static const unsigned char cSectors[8] = { 0, 2, 6, 1, 4, 3, 5, 0 };
+    return cSectors[n];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a fixed-point PI controller with anti-windup and a
+//   saturating output.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef PICONTROLLER_H
+#define PICONTROLLER_H
+
+#include "FixedPoint.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point PI Controller Template Class
+***************************************************************************************************
+
+The tPIController class implements the discrete PI controller
+
+    u = kp*e + I,   I += ki*e           (ki includes the sample period)
+
+with the output clamped to a pair of limits. The gains have 'QGain' qbits and the error, output
+and limits have 'QState' qbits, eg. for a current loop with Q12 currents and Q16 gains,
+
+    constexpr tQ16 cKp = 0.8_q16, cKi = 0.02_q16;
+    tPIController< 16, 12 > pi( cKp, cKi, -tQ12( 150 ), tQ12( 150 ) );
+    ...
+    tQ12 vd12 = pi.update( id12Ref - id12 );        // each PWM period
+
+The products kp*e and ki*e are kept at full precision (QGain+QState qbits) in a 64-bit integrator,
+so the only rounding is of the final output, and the integrator can't lose small ki*e terms that a
+QState integrator would round away. Each update is two 32x32->64 bit multiplies, the additions and
+the clamps, which compilers turn into conditional selects rather than branches.
+
+Integrator wind-up while the output is saturated is prevented by the 'AntiWindup' policy,
+
+    tPIClamping             clamps the integrator to the output limits (the default).
+    tPIBackCalculation      feeds the amount the output was clamped by back into the integrator,
+                            scaled by a back-calculation gain (see "setBackGain"), so that the
+                            integrator settles where the output is just at the limit.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Anti-Windup Policies
+
+/** Anti-windup policy that clamps the integrator to the output limits **/
+struct tPIClamping
+{
+    /** Returns the new integrator from its value 'integrator' after this update's ki*e has been
+        added, the amount 'excess' the output was clamped by, the limits and the back-calculation
+        gain, all with the controller's full precision (except the gain which has 'QGain' qbits) **/
+    template< int QGain > static long long integrator( long long integrator, long long, long long min, long long max, long long )
+        { return (integrator > max)? max : (integrator < min)? min : integrator; }
+};
+
+/** Anti-windup policy that subtracts the amount the output was clamped by, scaled by the
+    back-calculation gain, from the integrator **/
+struct tPIBackCalculation
+{
+    template< int QGain > static long long integrator( long long integrator, long long excess, long long, long long, long long backGain )
+        { return integrator - tFixedPointCheck_::round< QGain >( excess * backGain ); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for a PI controller, where 'QGain' is the number of qbits of the gains and
+    'QState' the number of qbits of the error and output **/
+template< int QGain, int QState, typename DataType = int, typename AntiWindup = tPIClamping >
+class tPIController
+{
+public:
+    /** Records the fixed-point types of the gains and of the error and output **/
+    typedef tFixedPoint< QGain, DataType >   tGain;
+    typedef tFixedPoint< QState, DataType >  tState;
+
+    static_assert( sizeof(DataType) <= 4, "tPIController needs the products of the gains and errors to fit in 64 bits" );
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    /** Constructs a controller with gains 'kp' and 'ki' and output limits 'min' and 'max'. The
+        back-calculation gain defaults to 1 **/
+    tPIController( const tGain& kp, const tGain& ki, const tState& min, const tState& max )
+        : kp_( kp.qValue() ), ki_( ki.qValue() ), kb_( tGain( 1 ).qValue() ), min_( wide_( min ) ), max_( wide_( max ) ), integrator_( 0 ), output_() {}
+
+    void setGains( const tGain& kp, const tGain& ki ) { kp_ = kp.qValue(); ki_ = ki.qValue(); }
+    void setBackGain( const tGain& kb ) { kb_ = kb.qValue(); }
+    void setLimits( const tState& min, const tState& max ) { min_ = wide_( min ); max_ = wide_( max ); }
+
+    /** Sets the integrator so that the next output is 'output' for an error of 0, for a bumpless
+        start or change of mode **/
+    void reset( const tState& output = tState() ) { integrator_ = wide_( output ); output_ = output; }
+
+    //---------------------------------------------------------------------------------------------
+    // Control
+
+    /** Returns the output for the 'error' (the reference minus the feedback) **/
+    tState update( const tState& error ) {
+        FIXEDPOINT_PROFILE( "pi" );
+        DataType e = error.qValue();
+        long long integrator = integrator_ + (long long)( ki_ ) * e;
+        long long sum = (long long)( kp_ ) * e + integrator;
+        long long clamped = (sum > max_)? max_ : (sum < min_)? min_ : sum;
+        integrator_ = AntiWindup::template integrator< QGain >( integrator, sum - clamped, min_, max_, kb_ );
+        output_ = tState::create( DataType( tFixedPointCheck_::round< QGain >( clamped ) ) );
+        return output_;
+    }
+
+    /** Returns the last output **/
+    tState output() const { return output_; }
+
+    /** Returns the integrator rounded to the output's qbits **/
+    tState integrator() const { return tState::create( DataType( tFixedPointCheck_::round< QGain >( integrator_ ) ) ); }
+
+    /** Returns true if the last output was at one of the limits **/
+    bool saturated() const { return wide_( output_ ) <= min_ || wide_( output_ ) >= max_; }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    /** Returns a 'value' with QState qbits shifted up to the full precision of the products **/
+    static long long wide_( const tState& value ) { return FIXEDPOINT_IMPL_SHIFTUP( (long long)( value.qValue() ), QGain ); }
+
+    DataType   kp_;             // the gains are kept as qValues so the products are widening multiplies
+    DataType   ki_;
+    DataType   kb_;
+    long long  min_;            // the limits and integrator have QGain+QState qbits
+    long long  max_;
+    long long  integrator_;
+    tState     output_;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
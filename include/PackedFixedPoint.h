@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a fixed-point storage type that keeps values in a
+//   narrow data-type, and does arithmetic on them in a wider one.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef PACKEDFIXEDPOINT_H
+#define PACKEDFIXEDPOINT_H
+
+#include "FixedPoint.h"
+#include "SatFixedPoint.h"
+
+
+/**************************************************************************************************
+                          Packed Fixed-Point Storage Template Class
+***************************************************************************************************
+
+The tPackedFixedPoint class stores a fixed-point value in a narrow 'StorageType' (a short by
+default), for large arrays such as history buffers, tables and logs where halving the RAM (and
+cache or TCM) used matters. Arithmetic isn't done in the storage type though, values are widened
+to the compute type of the storage type (see tFixedPointTraits, an int for a short) when they are
+read, and narrowed back down when they are stored,
+
+    tPackedFixedPoint< 15 > history[1024];          // 2KB rather than 4KB
+
+    tQ15 x15 = history[i];                          // widened to a tFixedPoint< 15, int >
+    tFixedPoint< 30 > p30 = history[i] * gain15;    // a 32-bit product, which can't overflow
+    history[j] = (p30 + history[j] * leak15).roundedTo< 15 >();     // narrowed on store
+
+Storing a value which doesn't fit in the storage type wraps in the same way as the other
+conversions (and is recorded when instrumentation is enabled), while "setSaturated" clamps it
+instead. The "+=", "-=" and "*=" operators read, compute and store in one go.
+
+A tPackedFixedPoint always has the same size and alignment as its storage type, so arrays of them
+can be copied or sent by DMA as raw data.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for a fixed-point value with 'QBits' qbits, stored in 'StorageType' **/
+template< int QBits, typename StorageType = short >
+class tPackedFixedPoint
+{
+public:
+    /** Records the type the value is stored in, and the fixed-point type it is computed with **/
+    typedef StorageType tStorage;
+    typedef tFixedPoint< QBits, typename tFixedPointTraits< StorageType >::tCompute > tFixed;
+    typedef typename tFixed::tValue tValue;
+
+    static const unsigned cQBits = QBits;
+
+    static_assert( sizeof(StorageType) < sizeof(tValue), "tPackedFixedPoint is only needed for data-types narrower than their compute type" );
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    /** Creates a value from the raw 'qValue' as stored **/
+    static constexpr tPackedFixedPoint create( StorageType qValue ) { return tPackedFixedPoint( qValue, 0 ); }
+
+    constexpr tPackedFixedPoint() : value_() {}
+
+    /** Stores a value of the compute type, or any lower precision fixed-point value **/
+    constexpr tPackedFixedPoint( const tFixed& value ) : value_( tFixedPointCheck_::wrapped< QBits, StorageType >( value.qValue() ) ) {}
+    template< int QBits2, typename DataType2 > constexpr tPackedFixedPoint( const tFixedPoint<QBits2,DataType2>& value )
+        : value_( tFixedPointCheck_::wrapped< QBits, StorageType >( tFixed( value ).qValue() ) ) {}
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    explicit constexpr tPackedFixedPoint( double value ) : value_( tFixedPointCheck_::wrapped< QBits, StorageType >( tFixed( value ).qValue() ) ) {}
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Returns the value widened to the compute type **/
+    constexpr tFixed value() const { return tFixed::create( value_ ); }
+    constexpr operator tFixed() const { return value(); }
+
+    /** Returns the raw value as stored **/
+    constexpr StorageType qValue() const { return value_; }
+
+    /** Stores 'value' clamped to the range of the storage type **/
+    void setSaturated( const tFixed& value ) { value_ = tSaturate< StorageType >::template recorded< QBits >( tSaturate< StorageType >::clamp( value.qValue() ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    /** These read the value, calculate in the compute type and store the result **/
+    template< typename T > tPackedFixedPoint& operator+=( const T& rhs ) { tFixed v = value(); v += widened( rhs ); return *this = v; }
+    template< typename T > tPackedFixedPoint& operator-=( const T& rhs ) { tFixed v = value(); v -= widened( rhs ); return *this = v; }
+    template< typename T > tPackedFixedPoint& operator*=( const T& rhs ) { tFixed v = value(); v *= widened( rhs ); return *this = v; }
+
+    /** Returns 'value' widened if it is a tPackedFixedPoint, otherwise unchanged **/
+    template< typename T > static constexpr const T& widened( const T& value ) { return value; }
+    template< int QBits2, typename StorageType2 > static constexpr typename tPackedFixedPoint<QBits2,StorageType2>::tFixed widened( const tPackedFixedPoint<QBits2,StorageType2>& value )
+        { return value.value(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    constexpr tPackedFixedPoint( StorageType qValue, int ) : value_( qValue ) {}
+
+    StorageType  value_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+/** The operators of tFixedPoint are templates, so they don't convert a tPackedFixedPoint on either
+    side - these widen it first **/
+template< int QBits, typename StorageType, typename T > constexpr auto operator+( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) -> decltype( lhs.value() + tPackedFixedPoint<QBits,StorageType>::widened( rhs ) )
+    { return lhs.value() + tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr auto operator-( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) -> decltype( lhs.value() - tPackedFixedPoint<QBits,StorageType>::widened( rhs ) )
+    { return lhs.value() - tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr auto operator*( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) -> decltype( lhs.value() * tPackedFixedPoint<QBits,StorageType>::widened( rhs ) )
+    { return lhs.value() * tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr auto operator/( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) -> decltype( lhs.value() / tPackedFixedPoint<QBits,StorageType>::widened( rhs ) )
+    { return lhs.value() / tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+
+template< int QBits2, typename DataType2, int QBits, typename StorageType > constexpr auto operator+( const tFixedPoint<QBits2,DataType2>& lhs, const tPackedFixedPoint<QBits,StorageType>& rhs ) -> decltype( lhs + rhs.value() )
+    { return lhs + rhs.value(); }
+template< int QBits2, typename DataType2, int QBits, typename StorageType > constexpr auto operator-( const tFixedPoint<QBits2,DataType2>& lhs, const tPackedFixedPoint<QBits,StorageType>& rhs ) -> decltype( lhs - rhs.value() )
+    { return lhs - rhs.value(); }
+template< int QBits2, typename DataType2, int QBits, typename StorageType > constexpr auto operator*( const tFixedPoint<QBits2,DataType2>& lhs, const tPackedFixedPoint<QBits,StorageType>& rhs ) -> decltype( lhs * rhs.value() )
+    { return lhs * rhs.value(); }
+template< int QBits2, typename DataType2, int QBits, typename StorageType > constexpr auto operator/( const tFixedPoint<QBits2,DataType2>& lhs, const tPackedFixedPoint<QBits,StorageType>& rhs ) -> decltype( lhs / rhs.value() )
+    { return lhs / rhs.value(); }
+
+template< int QBits, typename StorageType, typename T > constexpr bool operator==( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() == tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr bool operator!=( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() != tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr bool operator< ( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() <  tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr bool operator<=( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() <= tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr bool operator>=( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() >= tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+template< int QBits, typename StorageType, typename T > constexpr bool operator> ( const tPackedFixedPoint<QBits,StorageType>& lhs, const T& rhs ) { return lhs.value() >  tPackedFixedPoint<QBits,StorageType>::widened( rhs ); }
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
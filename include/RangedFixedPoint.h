@@ -0,0 +1,292 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a range-annotated variant of the fixed-point template
+//   class, which tracks the possible range of values at compile-time.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef RANGEDFIXEDPOINT_H
+#define RANGEDFIXEDPOINT_H
+
+#include "FixedPoint.h"
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus < 201103L
+#   error "RangedFixedPoint.h requires C++11 support"
+#endif
+
+
+/**************************************************************************************************
+                          Range-Annotated Fixed-Point Template Class
+***************************************************************************************************
+
+The tRangedFixedPoint class wraps a tFixedPoint value together with the range of values it can
+hold, recorded at compile-time as the minimum and maximum qValues in 'MinQ' and 'MaxQ'. This range
+is propagated through the arithmetic operators, so the range of an expression such as
+
+    typedef tRangedFixedPointInt< 12, -200, 200 >  tCurrent;     // +/-200A in Q12
+    typedef tRangedFixedPointInt< 15, -1, 1 >      tGain;        // +/-1.0 in Q15
+
+    auto v = (a * g).roundedTo< 12 >() + offset;
+
+is known to the compiler, and a static_assert fails if it can exceed the range of the underlying
+data-type. In the above "a * g" has 27 qbits and a range of +/-200 which requires 36 bits, so
+it won't compile with the default int data-type (but "a.multipliedBy( g )" will).
+
+Assigning to a ranged variable is only allowed from a value whose range is contained in the
+variable's range. Any operation whose range can't be tracked (eg. feeding an integrator back into
+itself) must use the "clampedTo" method, which restricts the value at run-time.
+
+The "cSpareBits" and "cMaxQBits" members, and the tFixedPointStorage template, can be used to pick
+the smallest data-type and the largest number of qbits for a given range.
+
+Note this file requires C++11.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Compile-time helpers for manipulating ranges of qValues **/
+struct tFixedRange_
+{
+    static constexpr long long min( long long a, long long b ) { return (a < b)? a : b; }
+    static constexpr long long max( long long a, long long b ) { return (a > b)? a : b; }
+    static constexpr long long min( long long a, long long b, long long c, long long d ) { return min( min( a, b ), min( c, d ) ); }
+    static constexpr long long max( long long a, long long b, long long c, long long d ) { return max( max( a, b ), max( c, d ) ); }
+
+    static constexpr long long scaled( long long value, int byQBits ) { return value * (1LL << byQBits); }
+    static constexpr long long truncated( long long value, int byQBits ) { return value >> byQBits; }
+
+    /** Returns the number of bits needed to represent the non-negative magnitude 'value' **/
+    static constexpr int bitsFor( long long value ) { return (value == 0)? 0 : 1 + bitsFor( value >> 1 ); }
+
+    /** Returns the number of bits needed to represent the range, excluding any sign bit **/
+    static constexpr int bitsFor( long long minQ, long long maxQ ) { return bitsFor( max( maxQ, (minQ < 0)? -(minQ+1) : 0 ) ); }
+
+    /** Returns true if the 'value' can be held by DataType **/
+    template< typename DataType > static constexpr bool fits( long long value ) {
+        return (value >= 0)? ((unsigned long long)( value ) <= (unsigned long long)( std::numeric_limits<DataType>::max() ))
+                           : (std::numeric_limits<DataType>::is_signed && value >= (long long)( std::numeric_limits<DataType>::min() ));
+    }
+};
+
+/** Returns the bounds of a range of qValues reduced by 'ByQBits' with a 'Rounding' policy (see
+    FixedPoint.h). The policies are monotonic, so these are just the rounded bounds, except for
+    tRoundStochastic which can round either way **/
+template< typename Rounding >
+struct tFixedRangeRounding_
+{
+    template< int ByQBits > static constexpr long long min( long long value ) { return Rounding::template shift< ByQBits >( value ); }
+    template< int ByQBits > static constexpr long long max( long long value ) { return Rounding::template shift< ByQBits >( value ); }
+};
+
+template<>
+struct tFixedRangeRounding_< tRoundStochastic >
+{
+    template< int ByQBits > static constexpr long long min( long long value ) { return value >> ByQBits; }
+    template< int ByQBits > static constexpr long long max( long long value ) { return (value + ((1LL << ByQBits) - 1)) >> ByQBits; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Data-Type Selection
+
+/** Selects the smallest signed data-type that can hold qValues in the range 'MinQ' to 'MaxQ' **/
+template< long long MinQ, long long MaxQ >
+struct tFixedPointStorage
+{
+    typedef typename std::conditional< tFixedRange_::fits<signed char>( MinQ ) && tFixedRange_::fits<signed char>( MaxQ ), signed char,
+            typename std::conditional< tFixedRange_::fits<short>( MinQ ) && tFixedRange_::fits<short>( MaxQ ), short,
+            typename std::conditional< tFixedRange_::fits<int>( MinQ ) && tFixedRange_::fits<int>( MaxQ ), int,
+                                       long long >::type >::type >::type tValue;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for range-annotated fixed-point arithmetic. Where 'QBits' is the number of bits
+    reserved to hold the fractional part of the value, and 'MinQ' and 'MaxQ' are the smallest and
+    largest qValues the variable can hold (ie. including the qbits) **/
+template< int QBits, long long MinQ, long long MaxQ, typename DataType = int >
+class tRangedFixedPoint
+{
+    static_assert( MinQ <= MaxQ, "tRangedFixedPoint: minimum is greater than maximum" );
+    static_assert( tFixedRange_::fits<DataType>( MinQ ) && tFixedRange_::fits<DataType>( MaxQ ),
+                   "tRangedFixedPoint: range can exceed the underlying data-type" );
+
+public:
+    /** Records the number of qbits, and the range of qValues, for this type **/
+    static const unsigned cQBits = QBits;
+    static constexpr long long cMinQ = MinQ;
+    static constexpr long long cMaxQ = MaxQ;
+
+    /** Records how many of the most significant bits of DataType aren't needed to hold the
+        range, and so the largest number of qbits that could be used for the range **/
+    static constexpr int cSpareBits = std::numeric_limits<DataType>::digits - tFixedRange_::bitsFor( MinQ, MaxQ );
+    static constexpr int cMaxQBits = QBits + cSpareBits;
+
+    typedef DataType tValue;
+    typedef tFixedPoint< QBits, DataType > tFixed;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    /** Creates a ranged value from a qValue or unranged fixed-point value. It is up to the caller
+        to make sure the value is inside the range, use "clamped" if this isn't known **/
+    static tRangedFixedPoint create( tValue qValue ) { return tRangedFixedPoint( tFixed::create( qValue ) ); }
+    explicit tRangedFixedPoint( const tFixed& value ) : value_( value ) {}
+
+    tRangedFixedPoint() : value_() {}
+
+    /** Constructs a ranged value from another ranged value, which must have lower or equal
+        precision and a range contained in this type's range **/
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) : value_( value.fixed() )
+    {
+        static_assert( QBits2 <= QBits, "tRangedFixedPoint: use roundedTo or truncatedTo to reduce the precision" );
+        static_assert( tFixedRange_::scaled( MinQ2, QBits - QBits2 ) >= MinQ && tFixedRange_::scaled( MaxQ2, QBits - QBits2 ) <= MaxQ,
+                       "tRangedFixedPoint: value's range is not contained in the destination range" );
+    }
+
+    /** Creates a ranged value from an unranged fixed-point value, restricting it to the range at
+        run-time **/
+    static tRangedFixedPoint clamped( const tFixed& value )
+        { return create( (value.qValue() < MinQ)? tValue( MinQ ) : (value.qValue() > MaxQ)? tValue( MaxQ ) : value.qValue() ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    const tFixed& fixed() const { return value_; }
+    tValue qValue() const { return value_.qValue(); }
+
+    /** Reduces the precision of the value, the resulting range is rounded (with the same rounding
+        policy as the value) or truncated to match **/
+    template< int QBits2 > tRangedFixedPoint< QBits2, tFixedRange_::truncated( MinQ, QBits-QBits2 ), tFixedRange_::truncated( MaxQ, QBits-QBits2 ), DataType > truncatedTo() const
+        { return tRangedFixedPoint< QBits2, tFixedRange_::truncated( MinQ, QBits-QBits2 ), tFixedRange_::truncated( MaxQ, QBits-QBits2 ), DataType >( value_.template truncatedTo< QBits2 >() ); }
+    template< int QBits2 > tRangedFixedPoint< QBits2, tFixedRangeRounding_< FIXEDPOINT_ROUNDING >::template min< QBits-QBits2 >( MinQ ),
+                                              tFixedRangeRounding_< FIXEDPOINT_ROUNDING >::template max< QBits-QBits2 >( MaxQ ), DataType > roundedTo() const
+        { return roundedTo< QBits2, DataType, FIXEDPOINT_ROUNDING >(); }
+
+    /** As above, but also converting to another data-type, normally a smaller one that the
+        reduced range now fits in, and optionally with another rounding policy **/
+    template< int QBits2, typename DataType2 > tRangedFixedPoint< QBits2, tFixedRange_::truncated( MinQ, QBits-QBits2 ), tFixedRange_::truncated( MaxQ, QBits-QBits2 ), DataType2 > truncatedTo() const
+        { return tRangedFixedPoint< QBits2, tFixedRange_::truncated( MinQ, QBits-QBits2 ), tFixedRange_::truncated( MaxQ, QBits-QBits2 ), DataType2 >( value_.template truncatedTo< QBits2, DataType2 >() ); }
+    template< int QBits2, typename DataType2, typename Rounding = FIXEDPOINT_ROUNDING >
+    tRangedFixedPoint< QBits2, tFixedRangeRounding_< Rounding >::template min< QBits-QBits2 >( MinQ ), tFixedRangeRounding_< Rounding >::template max< QBits-QBits2 >( MaxQ ), DataType2 > roundedTo() const
+        { return tRangedFixedPoint< QBits2, tFixedRangeRounding_< Rounding >::template min< QBits-QBits2 >( MinQ ), tFixedRangeRounding_< Rounding >::template max< QBits-QBits2 >( MaxQ ), DataType2 >(
+                value_.template roundedTo< QBits2, DataType2, Rounding >() ); }
+
+    /** Increases the precision of the value, to 'QBits2' or by the precision of another ranged
+        type respectively. See the tFixedPoint methods of the same name **/
+    template< int QBits2 > tRangedFixedPoint< QBits2, tFixedRange_::scaled( MinQ, QBits2-QBits ), tFixedRange_::scaled( MaxQ, QBits2-QBits ), DataType > increasedTo() const
+        { return tRangedFixedPoint< QBits2, tFixedRange_::scaled( MinQ, QBits2-QBits ), tFixedRange_::scaled( MaxQ, QBits2-QBits ), DataType >( value_.template increasedTo< QBits2 >() ); }
+
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint< QBits+QBits2, tFixedRange_::scaled( MinQ, QBits2 ), tFixedRange_::scaled( MaxQ, QBits2 ), DataType >
+    increasedBy( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& ) const
+        { return tRangedFixedPoint< QBits+QBits2, tFixedRange_::scaled( MinQ, QBits2 ), tFixedRange_::scaled( MaxQ, QBits2 ), DataType >( value_.template increasedTo< QBits+QBits2 >() ); }
+
+    /** Restricts the value to the range of another (normally smaller) ranged type at run-time.
+        The destination type must have equal or higher precision **/
+    template< typename RangedType > RangedType clampedTo() const {
+        const long long q = tFixedRange_::scaled( value_.qValue(), RangedType::cQBits - QBits );
+        return RangedType::create( typename RangedType::tValue( (q < RangedType::cMinQ)? RangedType::cMinQ : (q > RangedType::cMaxQ)? RangedType::cMaxQ : q ) );
+    }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    double toDouble() const { return value_.toDouble(); }
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Comparisons
+
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator==( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ == value.fixed()); }
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator!=( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ != value.fixed()); }
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator< ( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ <  value.fixed()); }
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator<=( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ <= value.fixed()); }
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator>=( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ >= value.fixed()); }
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 > bool operator> ( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return (value_ >  value.fixed()); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+    //   As with tFixedPoint the result of "+" and "-" has the precision of the left hand argument,
+    //   while the result of "*" has the sum of the qbits of both arguments.
+
+    tRangedFixedPoint< QBits, -MaxQ, -MinQ, DataType > operator-() const
+        { return tRangedFixedPoint< QBits, -MaxQ, -MinQ, DataType >( -value_ ); }
+
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint< QBits, MinQ + tFixedRange_::scaled( MinQ2, QBits-QBits2 ), MaxQ + tFixedRange_::scaled( MaxQ2, QBits-QBits2 ), DataType >
+    operator+( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return tRangedFixedPoint< QBits, MinQ + tFixedRange_::scaled( MinQ2, QBits-QBits2 ), MaxQ + tFixedRange_::scaled( MaxQ2, QBits-QBits2 ), DataType >( value_ + value.fixed() ); }
+
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint< QBits, MinQ - tFixedRange_::scaled( MaxQ2, QBits-QBits2 ), MaxQ - tFixedRange_::scaled( MinQ2, QBits-QBits2 ), DataType >
+    operator-( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return tRangedFixedPoint< QBits, MinQ - tFixedRange_::scaled( MaxQ2, QBits-QBits2 ), MaxQ - tFixedRange_::scaled( MinQ2, QBits-QBits2 ), DataType >( value_ - value.fixed() ); }
+
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint< QBits+QBits2, tFixedRange_::min( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), tFixedRange_::max( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), typename tFixed::tCompute >
+    operator*( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return tRangedFixedPoint< QBits+QBits2, tFixedRange_::min( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), tFixedRange_::max( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), typename tFixed::tCompute >( value_ * value.fixed() ); }
+
+    /** As above, but calculated in the double-width tWide type (see tFixedPoint::multipliedBy) **/
+    template< int QBits2, long long MinQ2, long long MaxQ2, typename DataType2 >
+    tRangedFixedPoint< QBits+QBits2, tFixedRange_::min( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), tFixedRange_::max( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), typename tFixed::tWide >
+    multipliedBy( const tRangedFixedPoint<QBits2,MinQ2,MaxQ2,DataType2>& value ) const
+        { return tRangedFixedPoint< QBits+QBits2, tFixedRange_::min( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), tFixedRange_::max( MinQ*MinQ2, MinQ*MaxQ2, MaxQ*MinQ2, MaxQ*MaxQ2 ), typename tFixed::tWide >( value_.multipliedBy( value.fixed() ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    tFixed  value_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Type Helpers
+
+/** Declares a ranged fixed-point type whose range is given in whole (integer) units rather
+    than qValues. eg. "tRangedFixedPointInt< 12, -200, 200 >" for a Q12 value in +/-200 **/
+template< int QBits, long long Min, long long Max, typename DataType = int >
+using tRangedFixedPointInt = tRangedFixedPoint< QBits, tFixedRange_::scaled( Min, QBits ), tFixedRange_::scaled( Max, QBits ), DataType >;
+
+/** Declares a ranged fixed-point type for the range given in whole units using the smallest
+    signed data-type that can hold it **/
+template< int QBits, long long Min, long long Max >
+using tRangedFixedPointAuto = tRangedFixedPointInt< QBits, Min, Max,
+        typename tFixedPointStorage< tFixedRange_::scaled( Min, QBits ), tFixedRange_::scaled( Max, QBits ) >::tValue >;
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a fixed-point type whose operators round using a
+//   rounding policy chosen for the type.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef ROUNDEDFIXEDPOINT_H
+#define ROUNDEDFIXEDPOINT_H
+
+#include "FixedPoint.h"
+
+
+/**************************************************************************************************
+                          Fixed-Point Arithmetic With a Rounding Policy
+***************************************************************************************************
+
+The tRoundedFixedPoint class behaves like the tFixedPoint class it is derived from, except that
+the operations that lose precision round using the 'Rounding' policy given (see "Rounding
+Policies" in FixedPoint.h) rather than the FIXEDPOINT_ROUNDING default. This covers,
+
+    a *= b;   a /= b;   a / b;   a / 3;   a.roundedTo< ... >();
+    tRoundedFixedPoint( 1.3 );   a = 1.3;   a * 1.3;   a / 1.3;      // with floating-point support
+
+So different parts of a program can each use the rounding they need, eg.
+
+    typedef tRoundedFixedPoint< 16, tRoundTruncate >  tFastQ16;        // cheapest, in the ISR
+    typedef tRoundedFixedPoint< 16, tRoundHalfEven >  tEstimateQ16;    // unbiased, in the estimator
+
+The results of "+", "-" and the conversions keep the policy, other operations (the summed-Q
+"operator*", comparisons etc.) are inherited unchanged from tFixedPoint, and a tRoundedFixedPoint
+can be used anywhere a tFixedPoint of the same type is expected.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for fixed-point arithmetic rounded with the 'Rounding' policy. Where 'QBits' is
+    the number of bits reserved to hold the fractional part of the value **/
+template< int QBits, typename Rounding, typename DataType = int >
+class tRoundedFixedPoint : public tFixedPoint< QBits, DataType >
+{
+public:
+    /** Records the fixed-point type this class is based on, and the rounding policy **/
+    typedef tFixedPoint< QBits, DataType > tBase;
+    typedef Rounding tRounding;
+
+    typedef typename tBase::tValue tValue;
+    typedef typename tBase::tWide  tWide;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    static constexpr tRoundedFixedPoint create( tValue qValue ) { return tRoundedFixedPoint( tBase::create( qValue ) ); }
+
+    constexpr tRoundedFixedPoint() {}
+    constexpr tRoundedFixedPoint( const tBase& value ) : tBase( value ) {}
+    constexpr tRoundedFixedPoint( tValue value ) : tBase( value ) {}
+    constexpr tRoundedFixedPoint( tValue qValue, unsigned qBits ) : tBase( qValue, qBits ) {}
+
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint( tFixedPoint<QBits2,DataType2> value ) : tBase( value ) {}
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    explicit constexpr tRoundedFixedPoint( double value ) : tBase( tBase::template rounded< Rounding >( value ) ) {}
+#   else
+    /** As for tFixedPoint, a floating-point value is an error rather than being truncated **/
+    template< typename FloatType, typename = typename std::enable_if< std::is_floating_point< FloatType >::value >::type >
+    tRoundedFixedPoint( FloatType value ) = delete;
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Versions of the tFixedPoint "roundedTo" conversions that use the policy, and keep it **/
+    template< int QBits2 > constexpr tRoundedFixedPoint<QBits2,Rounding,DataType> roundedTo() const
+        { return tBase::template roundedTo< QBits2, DataType, Rounding >(); }
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint<QBits2,Rounding,DataType2> roundedTo() const
+        { return tBase::template roundedTo< QBits2, DataType2, Rounding >(); }
+    template< typename FPType > constexpr FPType roundedTo() const
+        { return FPType::create( roundedTo< FPType::cQBits, typename FPType::tValue >().qValue() ); }
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint<QBits2,Rounding,DataType2> roundedTo( tFixedPoint<QBits2,DataType2> ) const
+        { return roundedTo< QBits2, DataType2 >(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    tRoundedFixedPoint& operator*=( const tBase& value )
+        { return set_( tFixedPointCheck_::round< QBits, Rounding >( tWide(this->qValue())*value.qValue() ) ); }
+    tRoundedFixedPoint& operator/=( const tBase& value )
+        { return set_( tFixedPointCheck_::divide< Rounding >( FIXEDPOINT_IMPL_SHIFTUP( tWide(this->qValue()), QBits ), tWide(value.qValue()) ) ); }
+
+    /** These overloads make sure arguments of this type aren't mistaken for the constants handled
+        by the "operator*=( const DataType2& )" templates **/
+    tRoundedFixedPoint& operator*=( tRoundedFixedPoint value ) { return *this *= static_cast< const tBase& >( value ); }
+    tRoundedFixedPoint& operator/=( tRoundedFixedPoint value ) { return *this /= static_cast< const tBase& >( value ); }
+
+    template< int QBits2, typename DataType2 > tRoundedFixedPoint& operator*=( tFixedPoint<QBits2,DataType2> value )
+        { return set_( tFixedPointCheck_::round< QBits2, Rounding >( tWide(this->qValue())*value.qValue() ) ); }
+    template< int QBits2, typename DataType2 > tRoundedFixedPoint& operator/=( tFixedPoint<QBits2,DataType2> value )
+        { return set_( tFixedPointCheck_::divide< Rounding >( FIXEDPOINT_IMPL_SHIFTUP( tWide(this->qValue()), QBits2 ), tWide(value.qValue()) ) ); }
+
+    /** Multiplication and division by a constant, see tFixedPoint **/
+    template< typename DataType2 > tRoundedFixedPoint& operator*=( const DataType2& value ) { tBase::operator*=( value ); return *this; }
+    template< typename DataType2 > tRoundedFixedPoint& operator/=( const DataType2& value )
+        { tValue v = value; return set_( tFixedPointCheck_::divide< Rounding >( this->qValue(), v ) ); }
+
+    constexpr tRoundedFixedPoint operator-() const { return tBase::operator-(); }
+    constexpr tRoundedFixedPoint operator+( const tBase& value ) const { return tBase::operator+( value ); }
+    constexpr tRoundedFixedPoint operator-( const tBase& value ) const { return tBase::operator-( value ); }
+
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint operator+( tFixedPoint<QBits2,DataType2> value ) const
+        { return tBase::operator+( value ); }
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint operator-( tFixedPoint<QBits2,DataType2> value ) const
+        { return tBase::operator-( value ); }
+
+    using tBase::operator*;
+    using tBase::multipliedBy;
+
+    constexpr tValue operator/( tRoundedFixedPoint value ) const { return tFixedPointCheck_::divide< Rounding >( this->qValue(), value.qValue() ); }
+    constexpr tValue operator/( const tBase& value ) const { return tFixedPointCheck_::divide< Rounding >( this->qValue(), value.qValue() ); }
+    template< typename DataType2 > constexpr tRoundedFixedPoint operator/( const DataType2& value ) const
+        { return create( tFixedPointCheck_::divide< Rounding >( this->qValue(), tValue(value) ) ); }
+    template< int QBits2, typename DataType2 > constexpr tRoundedFixedPoint<QBits-QBits2,Rounding,DataType> operator/( tFixedPoint<QBits2,DataType2> value ) const
+        { return tRoundedFixedPoint<QBits-QBits2,Rounding,DataType>::create(
+                tFixedPointCheck_::divide< Rounding, decltype( this->qValue() + value.qValue() ) >( this->qValue(), value.qValue() ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Floating Point
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    tRoundedFixedPoint& operator=( double value ) { tBase::operator=( tBase::template rounded< Rounding >( value ) ); return *this; }
+    void setRounded( double value ) { *this = value; }
+
+    tRoundedFixedPoint& operator*=( double value ) { return set_( converted_( this->qValue()*value ) ); }
+    tRoundedFixedPoint& operator/=( double value ) { return set_( converted_( this->qValue()/value ) ); }
+
+    constexpr tRoundedFixedPoint operator*( double value ) const { return create( converted_( this->qValue()*value ) ); }
+    constexpr tRoundedFixedPoint operator/( double value ) const { return create( converted_( this->qValue()/value ) ); }
+
+    static constexpr tRoundedFixedPoint rounded( double value ) { return tBase::template rounded< Rounding >( value ); }
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    template< typename T > tRoundedFixedPoint& set_( T qValue )
+        { tBase::operator=( tBase::create( tFixedPointCheck_::wrapped< QBits, DataType >( qValue ) ) ); return *this; }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    static constexpr tValue converted_( double value ) { return Rounding::template converted< QBits, DataType >( value ); }
+#   endif
+};
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,313 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a saturating variant of the fixed-point template class,
+//   for values such as PI-integrators and PWM duties which must never wrap.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef SATFIXEDPOINT_H
+#define SATFIXEDPOINT_H
+
+#include "FixedPoint.h"
+#include "FixedPointTarget.h"
+#include <limits>
+#include <cmath>
+
+
+/**************************************************************************************************
+                          Saturating Fixed-Point Arithmetic Template Class
+***************************************************************************************************
+
+The tSatFixedPoint class behaves like the tFixedPoint class it is derived from, except that the
+operations that can overflow clamp their result to the range of the underlying data-type instead
+of wrapping around. This covers,
+
+    a += b;   a -= b;   a *= b;   a + b;   a - b;   a * b;   -a;
+    a.roundedTo< ... >();   a.truncatedTo< ... >();
+    tSatFixedPoint( b );   tSatFixedPoint( qValue, qBits );   tSatFixedPoint( 1.5 );
+
+So given "typedef tSatFixedPoint<16> tSatQ16;" an integrator can be written as
+
+    integ += error * gain;       // will stick at the largest/smallest tSatQ16 value
+
+rather than having to clamp the value by hand after each operation. Unlike tFixedPoint, "a * b"
+returns the (rounded) product with the same qbits as 'a' rather than the summed-Q product, use
+"multipliedBy" when the full-precision product is wanted. Other operations (division, comparisons
+etc.) are inherited unchanged from tFixedPoint, and a tSatFixedPoint can be used anywhere a
+tFixedPoint of the same type is expected.
+
+Where the target provides them, and FIXEDPOINT_ENABLE_UNVERIFIED_TARGETS is defined (see
+FixedPointTarget.h), the ARM QADD/QSUB (DSP extension) and SSAT instructions, or the RISC-V P
+extension's KADDW/KSUBW and SCLIP32 instructions, are used to implement the saturation for 32-bit
+values, otherwise portable C++ is used which compilers will normally turn into conditional
+selects rather than branches.
+
+Saturating conversions are only provided between data-types with the same signedness.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation Details
+
+/** Clamps a 'value' of type T to the range of DataType. The 'Narrowing' parameter records whether
+    T can hold values outside of DataType's range, so that a plain conversion can be used when it
+    can't (and to avoid warnings about constant conversions that would overflow) **/
+template< typename T, typename DataType, bool Narrowing = (sizeof(T) > sizeof(DataType)) >
+struct tSaturateClamp_
+{
+    static DataType clamp( T value ) { return DataType( value ); }
+};
+
+template< typename T, typename DataType >
+struct tSaturateClamp_< T, DataType, true >
+{
+    static DataType clamp( T value ) {
+        const T cMax = T( std::numeric_limits<DataType>::max() );
+        const T cMin = T( std::numeric_limits<DataType>::min() );
+        return (value > cMax)? DataType( cMax ) : (value < cMin)? DataType( cMin ) : DataType( value );
+    }
+};
+
+#if defined(FIXEDPOINT_TARGET_SAT)
+template<> struct tSaturateClamp_< int, short, true >
+{
+    static short clamp( int value ) { return short( __ssat( value, 16 ) ); }
+};
+template<> struct tSaturateClamp_< int, signed char, true >
+{
+    static signed char clamp( int value ) { return (signed char)( __ssat( value, 8 ) ); }
+};
+#elif defined(FIXEDPOINT_TARGET_RVP)
+template<> struct tSaturateClamp_< int, short, true >
+{
+    static short clamp( int value ) { return short( tFixedTargetRvp_::sclip32< 16 >( value ) ); }
+};
+template<> struct tSaturateClamp_< int, signed char, true >
+{
+    static signed char clamp( int value ) { return (signed char)( tFixedTargetRvp_::sclip32< 8 >( value ) ); }
+};
+#endif
+
+
+/** This template provides the saturating primitives used by tSatFixedPoint for a given DataType.
+    It may be specialised to provide faster versions for particular targets **/
+template< typename DataType >
+struct tSaturate
+{
+    typedef std::numeric_limits<DataType> tLimits;
+
+    /** Clamps a value of any type with the same signedness to the range of DataType **/
+    template< typename T > static DataType clamp( T value ) { return tSaturateClamp_<T,DataType>::clamp( value ); }
+
+    static DataType add( DataType a, DataType b ) {
+        return (b > 0 && a > tLimits::max() - b)? tLimits::max()
+             : (b < 0 && a < tLimits::min() - b)? tLimits::min() : DataType( a + b );
+    }
+    static DataType sub( DataType a, DataType b ) {
+        return (b < 0 && a > tLimits::max() + b)? tLimits::max()
+             : (b > 0 && a < tLimits::min() + b)? tLimits::min() : DataType( a - b );
+    }
+    static DataType negate( DataType a ) { return sub( DataType(), a ); }
+
+    /** Returns 'value' unchanged, but records a saturation against the fixed-point type with
+        'QBits' qbits if it is at either limit when instrumentation is enabled (see
+        FixedPointInstrument.h) **/
+    template< int QBits > static DataType recorded( DataType value )
+        { return FIXEDPOINT_IMPL_RECORD( QBits, DataType, cFixedPointSaturate, (value == tLimits::max() || value == tLimits::min()), value ); }
+
+    /** Shifts a value left by 'qBits', clamping it if any significant bits are lost **/
+    static DataType shiftLeft( DataType a, unsigned qBits ) {
+        return (a > (tLimits::max() >> qBits))? tLimits::max()
+             : (a < (tLimits::min() >> qBits))? tLimits::min() : DataType( FIXEDPOINT_IMPL_SHIFTUP( a, qBits ) );
+    }
+};
+
+#if defined(FIXEDPOINT_TARGET_DSP)
+template<> inline int tSaturate< int >::add( int a, int b ) { return __qadd( a, b ); }
+template<> inline int tSaturate< int >::sub( int a, int b ) { return __qsub( a, b ); }
+#elif defined(FIXEDPOINT_TARGET_RVP)
+template<> inline int tSaturate< int >::add( int a, int b ) { return tFixedTargetRvp_::kaddw( a, b ); }
+template<> inline int tSaturate< int >::sub( int a, int b ) { return tFixedTargetRvp_::ksubw( a, b ); }
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for saturating fixed-point arithmetic. Where 'QBits' is the number of bits
+    reserved to hold the fractional part of the value **/
+template< int QBits, typename DataType = int >
+class tSatFixedPoint : public tFixedPoint< QBits, DataType >
+{
+public:
+    /** Records the non-saturating fixed-point type this class is based on **/
+    typedef tFixedPoint< QBits, DataType > tBase;
+
+    typedef typename tBase::tValue tValue;
+    typedef typename tBase::tWide  tWide;
+    typedef tSaturate< DataType >  tSat;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    static tSatFixedPoint create( tValue qValue ) { return tSatFixedPoint( tBase::create( qValue ) ); }
+
+    tSatFixedPoint() {}
+    tSatFixedPoint( const tBase& value ) : tBase( value ) {}
+    tSatFixedPoint( tValue value ) : tBase( create_( tSat::shiftLeft( value, QBits ) ) ) {}
+    tSatFixedPoint( tValue qValue, unsigned qBits ) : tBase( create_( tSat::shiftLeft( qValue, QBits - qBits ) ) ) {}
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint( tFixedPoint<QBits2,DataType2> value )
+        : tBase( create_( tSat::shiftLeft( tSat::clamp( value.qValue() ), QBits - QBits2 ) ) ) {}
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    explicit tSatFixedPoint( double value ) : tBase( saturated_( value ) ) {}
+#   else
+    /** As for tFixedPoint, a floating-point value is an error rather than being truncated **/
+    template< typename FloatType, typename = typename std::enable_if< std::is_floating_point< FloatType >::value >::type >
+    tSatFixedPoint( FloatType value ) = delete;
+#   endif
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    /** Saturating versions of the tFixedPoint conversions, these reduce the precision of a value
+        and/or convert it to a smaller data-type, clamping the result to the range of the
+        destination data-type **/
+    template< int QBits2 > tSatFixedPoint<QBits2,DataType> truncatedTo() const
+        { return tSatFixedPoint<QBits2,DataType>::create( lost_< QBits2, DataType, QBits - QBits2 >() >> (QBits - QBits2) ); }
+    template< int QBits2 > tSatFixedPoint<QBits2,DataType> roundedTo()   const
+        { return tSatFixedPoint<QBits2,DataType>::create( tSat::template recorded< QBits2 >( tSat::clamp(
+                tFixedPointCheck_::round< QBits - QBits2 >( tWide(lost_< QBits2, DataType, QBits - QBits2 >()) ) ) ) ); }
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint<QBits2,DataType2> truncatedTo() const
+        { return tSatFixedPoint<QBits2,DataType2>::create( tSaturate<DataType2>::template recorded< QBits2 >( tSaturate<DataType2>::clamp(
+                lost_< QBits2, DataType2, QBits - QBits2 >() >> (QBits - QBits2) ) ) ); }
+    template< int QBits2, typename DataType2 > tSatFixedPoint<QBits2,DataType2> roundedTo()   const
+        { return tSatFixedPoint<QBits2,DataType2>::create( tSaturate<DataType2>::template recorded< QBits2 >( tSaturate<DataType2>::clamp(
+                tFixedPointCheck_::round< QBits - QBits2 >( tWide(lost_< QBits2, DataType2, QBits - QBits2 >()) ) ) ) ); }
+
+    template< typename FPType > FPType truncatedTo() const
+        { return FPType::create( truncatedTo< FPType::cQBits, typename FPType::tValue >().qValue() ); }
+    template< typename FPType > FPType roundedTo()   const
+        { return FPType::create( roundedTo< FPType::cQBits, typename FPType::tValue >().qValue() ); }
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint<QBits2,DataType2> truncatedTo( tFixedPoint<QBits2,DataType2> ) const
+        { return truncatedTo< QBits2, DataType2 >(); }
+    template< int QBits2, typename DataType2 > tSatFixedPoint<QBits2,DataType2> roundedTo(   tFixedPoint<QBits2,DataType2> ) const
+        { return roundedTo< QBits2, DataType2 >(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    tSatFixedPoint& operator+=( const tBase& value ) { return set_( tSat::add( this->qValue(), value.qValue() ) ); }
+    tSatFixedPoint& operator-=( const tBase& value ) { return set_( tSat::sub( this->qValue(), value.qValue() ) ); }
+    tSatFixedPoint& operator*=( const tBase& value )
+        { return set_( tSat::clamp( tFixedPointCheck_::round< QBits >( tWide(this->qValue())*value.qValue() ) ) ); }
+
+    /** These overloads make sure saturating arguments aren't mistaken for the constants handled by
+        the "operator*=( const DataType2& )" templates **/
+    tSatFixedPoint& operator+=( tSatFixedPoint value ) { return *this += static_cast< const tBase& >( value ); }
+    tSatFixedPoint& operator-=( tSatFixedPoint value ) { return *this -= static_cast< const tBase& >( value ); }
+    tSatFixedPoint& operator*=( tSatFixedPoint value ) { return *this *= static_cast< const tBase& >( value ); }
+
+    /** Saturating multiplication by an integer constant, see tFixedPoint. Only integral types are
+        accepted so that other fixed-point types aren't mistaken for constants. A constant outside
+        of the range of tValue is clamped first, which gives the same result as long as the
+        product fits in tWide **/
+    template< typename DataType2, typename = typename std::enable_if< std::is_integral< DataType2 >::value >::type >
+    tSatFixedPoint& operator*=( const DataType2& value )
+        { return set_( tSat::clamp( tWide(this->qValue()) * tSat::clamp( value ) ) ); }
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint& operator+=( tFixedPoint<QBits2,DataType2> value )
+        { return *this += tSatFixedPoint( value ); }
+    template< int QBits2, typename DataType2 > tSatFixedPoint& operator-=( tFixedPoint<QBits2,DataType2> value )
+        { return *this -= tSatFixedPoint( value ); }
+    template< int QBits2, typename DataType2 > tSatFixedPoint& operator*=( tFixedPoint<QBits2,DataType2> value )
+        { return set_( tSat::clamp( tFixedPointCheck_::round< QBits2 >( tWide(this->qValue())*value.qValue() ) ) ); }
+
+    tSatFixedPoint operator-() const { return create( tSat::template recorded< QBits >( tSat::negate( this->qValue() ) ) ); }
+    tSatFixedPoint operator+( const tBase& value ) const { return tSatFixedPoint( *this ) += value; }
+    tSatFixedPoint operator-( const tBase& value ) const { return tSatFixedPoint( *this ) -= value; }
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint operator+( tFixedPoint<QBits2,DataType2> value ) const
+        { return tSatFixedPoint( *this ) += value; }
+    template< int QBits2, typename DataType2 > tSatFixedPoint operator-( tFixedPoint<QBits2,DataType2> value ) const
+        { return tSatFixedPoint( *this ) -= value; }
+
+    /** Saturating multiplication, returning a result with the same qbits as this value (as for
+        "operator*=") rather than the summed-Q product of tFixedPoint. Use "multipliedBy" followed
+        by a saturating narrowing conversion for the full-precision product **/
+    tSatFixedPoint operator*( tBase value ) const { return tSatFixedPoint( *this ) *= value; }
+    tSatFixedPoint operator*( tSatFixedPoint value ) const { return tSatFixedPoint( *this ) *= value; }
+
+    template< int QBits2, typename DataType2 > tSatFixedPoint operator*( tFixedPoint<QBits2,DataType2> value ) const
+        { return tSatFixedPoint( *this ) *= value; }
+    template< int QBits2, typename DataType2 > tSatFixedPoint operator*( tSatFixedPoint<QBits2,DataType2> value ) const
+        { return tSatFixedPoint( *this ) *= static_cast< const tFixedPoint<QBits2,DataType2>& >( value ); }
+    template< typename DataType2, typename = typename std::enable_if< std::is_integral< DataType2 >::value >::type >
+    tSatFixedPoint operator*( DataType2 value ) const
+        { return tSatFixedPoint( *this ) *= value; }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    /** Multiplication by a double is inherited unchanged from tFixedPoint **/
+    tBase operator*( double value ) const { return tBase::operator*( value ); }
+#   endif
+
+    using tBase::multipliedBy;
+
+    tValue operator/( tSatFixedPoint value ) const { return tBase::operator/( static_cast< const tBase& >( value ) ); }
+    using tBase::operator/;
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    static tBase create_( tValue qValue ) { return tBase::create( tSat::template recorded< QBits >( qValue ) ); }
+    tSatFixedPoint& set_( tValue qValue ) { tBase::operator=( create_( qValue ) ); return *this; }
+
+#   ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    /** Converts a double as tFixedPoint does, clamping values outside of the representable range **/
+    static tBase saturated_( double value ) {
+        const double scaled = std::ldexp( value, QBits );
+        return (scaled >= double( tSat::tLimits::max() ))? create_( tSat::tLimits::max() )
+             : (scaled <= double( tSat::tLimits::min() ))? create_( tSat::tLimits::min() ) : tBase( value );
+    }
+#   endif
+
+    /** Returns the value, recording a rounding loss if reducing it by 'ByQBits' discards any set
+        bits (see tFixedPointCheck_) **/
+    template< int QBits2, typename DataType2, int ByQBits > tValue lost_() const
+        { return tFixedPointCheck_::lost< QBits2, DataType2, ByQBits >( this->qValue() ); }
+};
+
+/** Multiplying a tFixedPoint by a tSatFixedPoint gives the tFixedPoint summed-Q product, this
+    overload stops the tSatFixedPoint from being taken for a constant **/
+template< int QBits, typename DataType, int QBits2, typename DataType2 >
+constexpr tFixedPoint<QBits+QBits2,typename tFixedPoint<QBits,DataType>::tCompute> operator*( tFixedPoint<QBits,DataType> lhs, tSatFixedPoint<QBits2,DataType2> rhs )
+    { return lhs * static_cast< const tFixedPoint<QBits2,DataType2>& >( rhs ); }
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
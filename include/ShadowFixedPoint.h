@@ -0,0 +1,292 @@
+//------------------------------------------------------------------------------
+//   TumanakoVC - Electric Vehicle and Motor control software
+//   Copyright (C) 2011 Graeme Bell <graemeb@users.sourceforge.net>
+//
+//   This file is part of TumanakoVC.
+//
+//   TumanakoVC is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU Lesser General Public License as published
+//   by the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+//   TumanakoVC is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU Lesser General Public License for more details.
+//
+//   You should have received a copy of the GNU Lesser General Public License
+//   along with TumanakoVC.  If not, see <http://www.gnu.org/licenses/>.
+//
+// DESCRIPTION:
+//   This file provides a variant of the fixed-point template class that
+//   carries a floating-point reference value along with it, for checking the
+//   accuracy of fixed-point code.
+//
+// HISTORY:
+//   14/Oct/2026 - First Cut
+//------------------------------------------------------------------------------
+
+#ifndef SHADOWFIXEDPOINT_H
+#define SHADOWFIXEDPOINT_H
+
+#include "FixedPoint.h"
+#include <cmath>
+
+#ifndef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#   error "ShadowFixedPoint.h requires FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT"
+#endif
+
+
+/**************************************************************************************************
+                          Shadowed Fixed-Point Template Class
+***************************************************************************************************
+
+The tShadowFixedPoint class has the same interface as tFixedPoint, and gives exactly the same
+fixed-point results, but also carries a double "reference" value through every operation which is
+calculated as if there was no rounding or overflow at all. Each variable records the largest
+absolute and relative error between the two that it has held, so replacing (for instance)
+
+    typedef tFixedPoint< 12 >  tQ12;
+with
+    typedef tShadowFixedPoint< 12 >  tQ12;
+
+in code running on a host simulation shows how much accuracy each variable is actually losing,
+and so where qbits or storage width can be cut, or need to be added,
+
+    printf( "id: max error %g (%g%%)\n", id.maxAbsError(), 100*id.maxRelError() );
+
+The errors are updated whenever a variable is constructed or assigned a new value. Copies of a
+variable carry its recorded errors with them, but assigning to a variable keeps that variable's
+own record. The relative error is measured against the larger of the reference value and the
+value of one LSB, so values close to zero don't report huge relative errors.
+
+This class is only intended for host testing, and requires floating-point support.
+
+***************************************************************************************************/
+
+
+//-------------------------------------------------------------------------------------------------
+// Class Definition
+
+/** Template class for fixed-point arithmetic with a floating-point shadow value. Where 'QBits' is
+    the number of bits reserved to hold the fractional part of the value **/
+template< int QBits, typename DataType = int >
+class tShadowFixedPoint
+{
+    template< int, typename > friend class tShadowFixedPoint;
+
+public:
+    static const unsigned cQBits = QBits;
+    typedef DataType tValue;
+
+    /** Records the fixed-point type being shadowed **/
+    typedef tFixedPoint< QBits, DataType > tFixed;
+    typedef typename tFixed::tWide tWide;
+
+    //---------------------------------------------------------------------------------------------
+    // Construction
+
+    static tShadowFixedPoint create( tValue qValue ) { return tShadowFixedPoint( tFixed::create( qValue ) ); }
+
+    /** Creates a value from a fixed-point value and a separately calculated 'reference' **/
+    static tShadowFixedPoint create( const tFixed& value, double reference ) { return tShadowFixedPoint( value, reference ); }
+
+    tShadowFixedPoint() : fixed_(), reference_(), maxAbsError_(), maxRelError_() {}
+    tShadowFixedPoint( const tShadowFixedPoint& value )
+        : fixed_( value.fixed_ ), reference_( value.reference_ ), maxAbsError_( value.maxAbsError_ ), maxRelError_( value.maxRelError_ ) {}
+    tShadowFixedPoint( tValue value ) : fixed_( value ), reference_( value ), maxAbsError_(), maxRelError_() { update_(); }
+    tShadowFixedPoint( tValue qValue, unsigned qBits )
+        : fixed_( qValue, qBits ), reference_( std::ldexp( double( qValue ), -int( qBits ) ) ), maxAbsError_(), maxRelError_() { update_(); }
+    explicit tShadowFixedPoint( double value ) : fixed_( value ), reference_( value ), maxAbsError_(), maxRelError_() { update_(); }
+
+    /** A plain fixed-point value is taken to be exact **/
+    tShadowFixedPoint( const tFixed& value ) : fixed_( value ), reference_( value.toDouble() ), maxAbsError_(), maxRelError_() {}
+
+    template< int QBits2, typename DataType2 > tShadowFixedPoint( const tShadowFixedPoint<QBits2,DataType2>& value )
+        : fixed_( value.fixed_ ), reference_( value.reference_ ), maxAbsError_( value.maxAbsError_ ), maxRelError_( value.maxRelError_ ) { update_(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Accuracy
+
+    /** Returns the fixed-point value, and the floating-point reference value respectively **/
+    const tFixed& fixed() const { return fixed_; }
+    double reference() const { return reference_; }
+
+    /** Returns the current absolute error, and the largest absolute and relative errors recorded **/
+    double error() const { return std::fabs( fixed_.toDouble() - reference_ ); }
+    double maxAbsError() const { return maxAbsError_; }
+    double maxRelError() const { return maxRelError_; }
+
+    /** Clears the recorded errors, and optionally makes the reference value match the fixed-point
+        value again **/
+    void resetErrors( bool resync = false ) {
+        if (resync) reference_ = fixed_.toDouble();
+        maxAbsError_ = maxRelError_ = 0;
+        update_();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Conversions
+
+    tValue qValue() const { return fixed_.qValue(); }
+    double toDouble() const { return fixed_.toDouble(); }
+
+    /** See tFixedPoint, the reference value is not affected by the change in precision **/
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> truncatedTo( const tShadowFixedPoint<QBits2,DataType2>& ) const
+        { return truncatedTo< QBits2, DataType2 >(); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> roundedTo(   const tShadowFixedPoint<QBits2,DataType2>& ) const
+        { return roundedTo< QBits2, DataType2 >(); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> increasedTo( const tShadowFixedPoint<QBits2,DataType2>& ) const
+        { return increasedTo< QBits2, DataType2 >(); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits+QBits2,DataType2> increasedBy( const tShadowFixedPoint<QBits2,DataType2>& ) const
+        { return increasedTo< QBits+QBits2, DataType2 >(); }
+
+    template< int QBits2 > tShadowFixedPoint<QBits2,DataType> truncatedTo() const { return truncatedTo< QBits2, DataType >(); }
+    template< int QBits2 > tShadowFixedPoint<QBits2,DataType> roundedTo()   const { return roundedTo< QBits2, DataType >(); }
+    template< int QBits2 > tShadowFixedPoint<QBits2,DataType> increasedTo() const { return increasedTo< QBits2, DataType >(); }
+
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> truncatedTo() const
+        { return tShadowFixedPoint<QBits2,DataType2>( fixed_.template truncatedTo< QBits2, DataType2 >(), reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> roundedTo()   const
+        { return tShadowFixedPoint<QBits2,DataType2>( fixed_.template roundedTo< QBits2, DataType2 >(), reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits2,DataType2> increasedTo() const
+        { return tShadowFixedPoint<QBits2,DataType2>( fixed_.template increasedTo< QBits2, DataType2 >(), reference_ ); }
+
+    template< typename FPType > FPType truncatedTo() const { return truncatedTo< FPType::cQBits, typename FPType::tValue >(); }
+    template< typename FPType > FPType roundedTo()   const { return roundedTo< FPType::cQBits, typename FPType::tValue >(); }
+    template< typename FPType > FPType increasedTo() const { return increasedTo< FPType::cQBits, typename FPType::tValue >(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Assignment
+
+    /** Assignment keeps this variable's recorded errors, and adds the new value's error to them **/
+    tShadowFixedPoint& operator=( const tShadowFixedPoint& value ) { return set_( value.fixed_, value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint& operator=( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { return *this = value.template increasedTo< QBits, DataType >(); }
+    tShadowFixedPoint& operator=( double value ) { return set_( tFixed( value ), value ); }
+
+    void set( const tShadowFixedPoint& value ) { *this = value; }
+    template< int QBits2, typename DataType2 > void set( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { *this = value.template increasedTo< QBits >(); }
+    template< int QBits2, typename DataType2 > void setTruncated( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { *this = value.template truncatedTo< QBits >(); }
+    template< int QBits2, typename DataType2 > void setRounded( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { *this = value.template roundedTo< QBits >(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Comparisons
+
+    /** Comparisons are of the fixed-point values, so that code behaves exactly as it would with
+        tFixedPoint **/
+    bool operator!() const { return !fixed_; }
+
+    template< int QBits2, typename DataType2 > bool operator==( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ == value.fixed_); }
+    template< int QBits2, typename DataType2 > bool operator!=( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ != value.fixed_); }
+    template< int QBits2, typename DataType2 > bool operator< ( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ <  value.fixed_); }
+    template< int QBits2, typename DataType2 > bool operator<=( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ <= value.fixed_); }
+    template< int QBits2, typename DataType2 > bool operator>=( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ >= value.fixed_); }
+    template< int QBits2, typename DataType2 > bool operator> ( const tShadowFixedPoint<QBits2,DataType2>& value ) const { return (fixed_ >  value.fixed_); }
+
+    bool operator==( double value ) const { return (fixed_ == value); }
+    bool operator!=( double value ) const { return (fixed_ != value); }
+    bool operator< ( double value ) const { return (fixed_ <  value); }
+    bool operator<=( double value ) const { return (fixed_ <= value); }
+    bool operator>=( double value ) const { return (fixed_ >= value); }
+    bool operator> ( double value ) const { return (fixed_ >  value); }
+
+    //---------------------------------------------------------------------------------------------
+    // Arithmetic
+
+    template< int QBits2, typename DataType2 > tShadowFixedPoint& operator+=( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { tFixed f( fixed_ ); return set_( f += value.fixed_, reference_ + value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint& operator-=( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { tFixed f( fixed_ ); return set_( f -= value.fixed_, reference_ - value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint& operator*=( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { tFixed f( fixed_ ); return set_( f *= value.fixed_, reference_ * value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint& operator/=( const tShadowFixedPoint<QBits2,DataType2>& value )
+        { tFixed f( fixed_ ); return set_( f /= value.fixed_, reference_ / value.reference_ ); }
+
+    /** Multiplying or dividing by a constant, see tFixedPoint **/
+    template< typename DataType2 > tShadowFixedPoint& operator*=( const DataType2& value )
+        { tFixed f( fixed_ ); return set_( f *= value, reference_ * double( tValue( value ) ) ); }
+    template< typename DataType2 > tShadowFixedPoint& operator/=( const DataType2& value )
+        { tFixed f( fixed_ ); return set_( f /= value, reference_ / double( tValue( value ) ) ); }
+
+    tShadowFixedPoint& operator+=( double value ) { tFixed f( fixed_ ); return set_( f += value, reference_ + value ); }
+    tShadowFixedPoint& operator-=( double value ) { tFixed f( fixed_ ); return set_( f -= value, reference_ - value ); }
+    tShadowFixedPoint& operator*=( double value ) { tFixed f( fixed_ ); return set_( f *= value, reference_ * value ); }
+    tShadowFixedPoint& operator/=( double value ) { tFixed f( fixed_ ); return set_( f /= value, reference_ / value ); }
+
+    tShadowFixedPoint operator-() const { return tShadowFixedPoint( -fixed_, -reference_ ); }
+
+    template< int QBits2, typename DataType2 > tShadowFixedPoint operator+( const tShadowFixedPoint<QBits2,DataType2>& value ) const
+        { return tShadowFixedPoint( fixed_ + value.fixed_, reference_ + value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint operator-( const tShadowFixedPoint<QBits2,DataType2>& value ) const
+        { return tShadowFixedPoint( fixed_ - value.fixed_, reference_ - value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits+QBits2,typename tFixed::tCompute> operator*( const tShadowFixedPoint<QBits2,DataType2>& value ) const
+        { return tShadowFixedPoint<QBits+QBits2,typename tFixed::tCompute>( fixed_ * value.fixed_, reference_ * value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits-QBits2,DataType> operator/( const tShadowFixedPoint<QBits2,DataType2>& value ) const
+        { return tShadowFixedPoint<QBits-QBits2,DataType>( fixed_ / value.fixed_, reference_ / value.reference_ ); }
+    template< int QBits2, typename DataType2 > tShadowFixedPoint<QBits+QBits2,tWide> multipliedBy( const tShadowFixedPoint<QBits2,DataType2>& value ) const
+        { return tShadowFixedPoint<QBits+QBits2,tWide>( fixed_.multipliedBy( value.fixed_ ), reference_ * value.reference_ ); }
+
+    /** As for tFixedPoint, dividing values of the same type gives a plain integer **/
+    tValue operator/( const tShadowFixedPoint& value ) const { return fixed_ / value.fixed_; }
+
+    template< typename DataType2 > tShadowFixedPoint operator*( const DataType2& value ) const
+        { return tShadowFixedPoint( fixed_ * value, reference_ * double( tValue( value ) ) ); }
+    template< typename DataType2 > tShadowFixedPoint operator/( const DataType2& value ) const
+        { return tShadowFixedPoint( fixed_ / value, reference_ / double( tValue( value ) ) ); }
+
+    tShadowFixedPoint operator+( double value ) const { return tShadowFixedPoint( fixed_ + value, reference_ + value ); }
+    tShadowFixedPoint operator-( double value ) const { return tShadowFixedPoint( fixed_ - value, reference_ - value ); }
+    tShadowFixedPoint operator*( double value ) const { return tShadowFixedPoint( fixed_ * value, reference_ * value ); }
+    tShadowFixedPoint operator/( double value ) const { return tShadowFixedPoint( fixed_ / value, reference_ / value ); }
+
+    //---------------------------------------------------------------------------------------------
+    // Miscellaneous
+
+    tValue absolute() const { return fixed_.absolute(); }
+    tValue intPart() const { return fixed_.intPart(); }
+    tValue fracPart() const { return fixed_.fracPart(); }
+    tValue absFracPart() const { return fixed_.absFracPart(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Implementation Details
+
+private:
+    tShadowFixedPoint( const tFixed& value, double reference )
+        : fixed_( value ), reference_( reference ), maxAbsError_(), maxRelError_() { update_(); }
+
+    tShadowFixedPoint& set_( const tFixed& value, double reference ) {
+        fixed_ = value;
+        reference_ = reference;
+        update_();
+        return *this;
+    }
+
+    /** Adds the current error to the recorded errors **/
+    void update_() {
+        const double cLsb = std::ldexp( 1.0, -QBits );
+        const double e = error();
+        const double r = e / std::fmax( std::fabs( reference_ ), cLsb );
+        if (e > maxAbsError_) maxAbsError_ = e;
+        if (r > maxRelError_) maxRelError_ = r;
+    }
+
+    tFixed  fixed_;
+    double  reference_;
+    double  maxAbsError_;
+    double  maxRelError_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// External Helpers
+
+template< int QBits, typename DataType > tShadowFixedPoint<QBits,DataType> operator+( DataType lhs, const tShadowFixedPoint<QBits,DataType>& rhs ) { return tShadowFixedPoint<QBits,DataType>( lhs ) + rhs; }
+template< int QBits, typename DataType > tShadowFixedPoint<QBits,DataType> operator-( DataType lhs, const tShadowFixedPoint<QBits,DataType>& rhs ) { return tShadowFixedPoint<QBits,DataType>( lhs ) - rhs; }
+template< int QBits, typename DataType > tShadowFixedPoint<QBits,DataType> operator*( DataType lhs, const tShadowFixedPoint<QBits,DataType>& rhs ) { return rhs * lhs; }
+
+//-------------------------------------------------------------------------------------------------
+
+#endif  // inclusion guard
@@ -0,0 +1,49 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedAccumulator.h"
+#include <cassert>
+#include <cstdlib>
+
+typedef tFixedPoint< 15 >  tQ15;
+typedef tFixedPoint< 16 >  tQ16;
+typedef tFixedPoint< 12, short >  tShortQ12;
+
+int main()
+{
+    // the sum of products is exact, and only rounded at the end
+    tQ15 coeffs[32];
+    tQ16 samples[32];
+    long long exact = 0;
+    for (int i = 0; i < 32; ++i) {
+        coeffs[i] = tQ15::create( std::rand() % 65536 - 32768 );
+        samples[i] = tQ16::create( std::rand() - RAND_MAX/2 );
+        exact += (long long)( coeffs[i].qValue() ) * samples[i].qValue();
+    }
+
+    tFixedAccumulator< 31 > acc;
+    for (int i = 0; i < 32; ++i) acc.mac( coeffs[i], samples[i] );
+    assert( acc.qValue() == exact );
+    assert( (acc.roundedTo< 16, long long >().qValue() == (exact + (1 << 14)) >> 15) );
+    assert( (acc.truncatedTo< 16, long long >().qValue() == exact >> 15) );
+
+    for (int i = 0; i < 32; ++i) acc.msub( coeffs[i], samples[i] );
+    assert( acc.qValue() == 0 );
+
+    // products and values with fewer qbits are shifted up
+    acc.reset();
+    acc.mac( tQ15( 0.5 ), tFixedPoint< 8 >( 3 ) );
+    acc += tQ16( 0.25 );
+    acc -= tFixedPoint< 4 >( 1 );
+    assert( acc.roundedTo< tQ16 >() == tQ16( 0.75 ) );
+    assert( acc.value() == (tFixedPoint< 31, long long >( 0.75 )) );
+
+    tFixedAccumulator< 31 > acc2( tQ16( 2 ) );
+    acc2 += acc;
+    assert( acc2.roundedTo< 16 >() == (tFixedPoint< 16, long long >( 2.75 )) );
+
+    // narrow operands use a narrow accumulator if asked
+    tFixedAccumulator< 24, int > acc3;
+    acc3.mac( tShortQ12( 1.5 ), tShortQ12( short( -2 ) ) );
+    assert( acc3.roundedTo< tShortQ12 >() == tShortQ12( short( -3 ) ) );
+
+    return 0;
+}
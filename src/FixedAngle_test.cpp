@@ -0,0 +1,76 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedAngle.h"
+#include <assert.h>
+#include <string.h>
+#include <type_traits>
+
+typedef tFixedPoint< 12 > tQ12;
+typedef tFixedPoint< 15 > tQ15;
+typedef tFixedPoint< 30 > tQ30;
+typedef tFixedAngle<> tAngle;
+typedef tFixedAngle< unsigned short > tAngle16;
+
+static_assert( sizeof(tAngle) == 4 && sizeof(tAngle16) == 2, "angles take the size of their storage" );
+static_assert( std::is_trivially_copyable< tAngle >::value, "angles can be copied as raw data" );
+static_assert( tAngle::create( 0x40000000u ).index< 10 >() == 256, "a quarter turn is a quarter of the table" );
+static_assert( tAngle16::create( 0x8000 ).phase() == 0x80000000u, "the phase is the angle in 32 bits" );
+
+int main() {
+    const tAngle quarter = tAngle::create( 1u << 30 );
+
+    // angles wrap modulo one turn
+    tAngle a = quarter * 3;
+    a += quarter * 2;
+    assert( a == quarter );
+    assert( -quarter == quarter * 3 && 4 * quarter == tAngle() );
+    tAngle16 b = tAngle16::create( 0xC000 );
+    b += tAngle16::create( 0x8000 );
+    assert( b.raw() == 0x4000 );
+    b *= 5;
+    assert( b.raw() == 0x4000 );
+
+    // differences are signed
+    assert( (quarter - quarter * 3).signedRaw() == -0x80000000ll );
+    assert( (tAngle::create( 10 ) - tAngle::create( 0xFFFFFFF0u )).signedRaw() == 26 );
+    assert( (tAngle::create( 0xFFFFFFF0u ) - tAngle::create( 10 )).signedRaw() == -26 );
+    assert( (tAngle16::create( 3 ) - tAngle16::create( 0xFFFF )).signedRaw() == 4 );
+    assert( (tAngle() - quarter).turns< 15 >() == tQ15( -0.25 ) );
+    assert(( (quarter * 2).turns< 30 >() == tQ30( -0.5 ) && quarter.turns< 17, short >().qValue() == 32767 ));
+
+    // conversions from turns and radians
+    assert( tAngle::fromTurns( tQ15( 0.25 ) ) == quarter && tAngle::fromTurns( tQ15( -0.75 ) ) == quarter );
+    assert( tAngle::fromTurns( tFixedPoint< 0 >( 3 ) ) == tAngle() );
+    assert( tAngle16::fromTurns( tFixedPoint< 20 >::create( (1 << 18) + 7 ) ).raw() == 0x4000 );
+    assert( tAngle16::fromTurns( tFixedPoint< 20 >::create( (1 << 18) + 8 ) ).raw() == 0x4001 );
+    tAngle c = tAngle::fromRadians( tQ12( 3.14159265 / 2 ) );
+    assert( (c - quarter).signedRaw() < (1 << 20) && (c - quarter).signedRaw() > -(1 << 20) );
+    assert( tAngle16::fromRadians( tQ12( -3.14159265 / 2 ) ).raw() == 0xC000 );
+    assert( tAngle::fromRadians( 3.14159265358979 ) == quarter * 2 && tAngle::fromDegrees( -90 ) == quarter * 3 );
+    assert( tAngle16::fromDegrees( 450 ).raw() == 0x4000 && tAngle16::fromDegrees( 359.9999 ).raw() == 0 );
+    assert( (quarter * 3).radians< 12 >() == tQ12( -3.14159265 / 2 ) );
+    assert( (quarter * 2).radians< 28 >() == -tFixedPoint< 28 >( 3.14159265 ) );
+
+    // trig functions take the angle directly, and match the versions in radians
+    tSinCos< 15 > sc = sincos< 15 >( quarter );
+    assert( sc.sin == tQ15( 1 ) && sc.cos == tQ15( 0 ) );
+    assert(( sin< 15, short >( quarter ).qValue() == 32767 && cos< 14 >( quarter * 2 ) == tFixedPoint< 14 >( -1 ) ));
+    for (int i = -100; i <= 100; ++i) {
+        const tQ12 theta = tQ12::create( i * 97 );
+        const tAngle angle = tAngle::fromRadians( theta );
+        assert( sin< 15 >( angle ) == sin< 15 >( theta ) && cos< 15 >( angle ) == cos< 15 >( theta ) );
+        const tSinCos< 15 > v = sincos< 15 >( angle );
+        assert( v.sin == sin< 15 >( theta ) && v.cos == cos< 15 >( theta ) );
+        assert( tAngle::atan2( v.sin, v.cos ).radians< 12 >().qValue() - angle.radians< 12 >().qValue() <= 2 );
+        assert( angle.radians< 12 >().qValue() - tAngle::atan2( v.sin, v.cos ).radians< 12 >().qValue() <= 2 );
+    }
+    assert( tAngle::atan2( tQ15( 0.5 ), tQ15( 0 ) ).index< 2 >() == 1 );
+    assert( tAngle16::atan2( tQ15( -0.5 ), tQ15( -0.5 ) ).index< 3 >() == 5 );
+
+    // a phase accumulator wraps without reducing
+    tAngle theta;
+    const tAngle step = tAngle::fromTurns( tQ30( 0.001 ) );
+    for (int i = 0; i < 3000; ++i) theta += step;
+    assert( (theta - step * 3000).signedRaw() == 0 );
+    assert( (theta - tAngle()).turns< 15 >().qValue() >= tQ15( -0.001 ).qValue() && (theta - tAngle()).turns< 15 >().qValue() <= tQ15( 0.001 ).qValue() );
+    return 0;
+}
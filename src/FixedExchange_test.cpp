@@ -0,0 +1,65 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedExchange.h"
+#include <cassert>
+#include <thread>
+
+typedef tFixedPoint< 16 >  tQ16;
+typedef tFixedPoint< 12, short >  tQ12s;
+
+struct tMeasured { tQ16 id, iq, speed, vbus; };
+
+int main() {
+    // snapshots
+    tFixedSnapshot< tMeasured > measured;
+    assert( measured.count() == 0 && measured.read().vbus == tQ16( 0 ) );
+    tMeasured m = { tQ16( 1.5 ), tQ16( -2 ), tQ16( 300 ), tQ16( 48 ) };
+    measured.write( m );
+    tMeasured r = measured.read();
+    assert( r.id == tQ16( 1.5 ) && r.iq == tQ16( -2 ) && r.speed == tQ16( 300 ) && r.vbus == tQ16( 48 ) );
+    assert( measured.count() == 1 && measured.tryRead( r ) );
+
+    // a type that isn't a whole number of words
+    tFixedSnapshot< tQ12s > current( tQ12s( 3.25 ) );
+    assert( current.read() == tQ12s( 3.25 ) );
+
+    // rings
+    tFixedRing< tQ12s, 4 > ring;
+    tQ12s v;
+    assert( ring.empty() && !ring.pop( v ) );
+    for (int i = 0; i < 4; ++i) assert( ring.push( tQ12s( short( i ) ) ) );
+    assert( ring.full() && !ring.push( tQ12s( short( 9 ) ) ) );
+    assert( ring.pop( v ) && v == tQ12s( short( 0 ) ) && ring.size() == 3 );
+    tQ12s block[8] = { tQ12s( short( 4 ) ), tQ12s( short( 5 ) ), tQ12s( short( 6 ) ) };
+    assert( ring.push( block, 3 ) == 1 );
+    assert( ring.pop( block, 8 ) == 4 && block[0] == tQ12s( short( 1 ) ) && block[3] == tQ12s( short( 4 ) ) );
+    assert( ring.empty() );
+
+    // a writer racing a reader, every snapshot read must be from a single write and the ring
+    // must deliver every value in order
+    tFixedSnapshot< tMeasured > shared;
+    tFixedRing< tQ16, 64 > stream;
+    const int cWrites = 20000;
+    std::thread writer( [&]() {
+        for (int i = 1; i <= cWrites; ++i) {
+            tMeasured w = { tQ16::create( i ), tQ16::create( -i ), tQ16::create( 2*i ), tQ16::create( i ^ 0x5555 ) };
+            shared.write( w );
+            while (!stream.push( tQ16::create( i ) )) std::this_thread::yield();
+        }
+    } );
+    int expected = 1;
+    unsigned last = 0;
+    while (expected <= cWrites) {
+        tMeasured s = shared.read();
+        int i = s.id.qValue();
+        assert( i == 0 || (s.iq.qValue() == -i && s.speed.qValue() == 2*i && s.vbus.qValue() == (i ^ 0x5555)) );
+        unsigned count = shared.count();
+        assert( count >= last );
+        last = count;
+        tQ16 samples[16];
+        unsigned n = stream.pop( samples, 16 );
+        for (unsigned k = 0; k < n; ++k) assert( samples[k].qValue() == expected++ );
+        if (n == 0) std::this_thread::yield();
+    }
+    writer.join();
+    assert( shared.count() == unsigned( cWrites ) && stream.empty() );
+}
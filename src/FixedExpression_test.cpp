@@ -0,0 +1,62 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedExpression.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+typedef tFixedPoint< 4 >   tQ4;
+typedef tFixedPoint< 6 >   tQ6;
+typedef tFixedPoint< 8 >   tQ8;
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 16 >  tQ16;
+typedef tFixedPoint< 31 >  tQ31;
+typedef tFixedPoint< 15, short >  tQ15s;
+
+/** Returns a random double in [-range, range) **/
+static double random( double range ) { return (std::rand() / (RAND_MAX + 1.0) * 2 - 1) * range; }
+
+int main() {
+    // the qbits and widths chosen for each node
+    tQ8 a8( 1.5 );
+    tQ4 b4( -2.25 );
+    tQ12 c12( 0.125 );
+    tQ6 d6( 0.75 );
+    typedef decltype( expr( a8 ) * b4 ) tProduct;
+    static_assert( tProduct::cQBits == 12 && tProduct::cBits == 63 && std::is_same< tProduct::tValue, long long >::value, "a product keeps every bit" );
+    typedef decltype( expr( tQ15s( 0.5 ) ) * tQ15s( 0.5 ) + tQ15s( 0.25 ) ) tShortSum;
+    static_assert( tShortSum::cQBits == 30 && std::is_same< tShortSum::tValue, int >::value, "products of shorts are calculated in an int" );
+    typedef decltype( expr( tQ31() ) * tQ31() * tQ31() ) tTriple;
+    static_assert( tTriple::cBits == 64 && tTriple::cQBits == 93 - 30, "a product that doesn't fit in 64 bits is rounded down" );
+    typedef decltype( expr< 20 >( tQ16() ) * tQ16() / tQ6() ) tQuotient;
+    static_assert( tQuotient::cQBits == 32 + 8 && std::is_same< tQuotient::tValue, long long >::value, "a quotient has guard qbits" );
+    typedef decltype( expr( tQ15s() ) / tFixedPoint< 4, short >() ) tShortQuotient;
+    static_assert( tShortQuotient::cQBits == 15 + 8 && std::is_same< tShortQuotient::tValue, int >::value, "a narrow quotient is calculated in an int" );
+
+    // assigning rounds once, to the target's qbits
+    tQ16 y16 = (expr( a8 ) * b4 + c12) / d6;
+    assert( y16 == tQ16( (1.5 * -2.25 + 0.125) / 0.75 ) );
+    tQ12 x12;
+    x12 = expr( c12 ) * (a8 - b4);
+    assert( x12 == tQ12( 0.125 * 3.75 ) );
+    assert( (-expr( a8 ) + 2*b4 - 1).roundedTo< 4 >() == tQ4( -1.5 - 4.5 - 1 ) );
+    assert(( (expr( a8 ) / 3).roundedTo< tQ8, tRoundTruncate >() == tQ8::create( 128 ) ));
+    assert(( (expr( a8 ) * b4).evaluated() == tFixedPoint< 12, long long >( -3.375 ) ));
+    assert( (expr( tQ8::create( 1 ) ) * tQ8::create( 128 )).truncatedTo< 8 >().qValue() == 0 );
+    assert( (expr( tQ8::create( 1 ) ) * tQ8::create( 128 )).roundedTo< 8 >().qValue() == 1 );
+
+    // the result is within half an lsb of the exact value, where the step by step operators
+    // round each intermediate result
+    for (int i = 0; i < 10000; ++i) {
+        tQ16 a( random( 100 ) ), b( random( 100 ) ), c( random( 100 ) ), d( random( 16 ) + 32 );
+        double exact = (a.toDouble() * b.toDouble() + c.toDouble()) / d.toDouble();
+        tQ16 y = (expr( a ) * b + c) / d;
+        assert( std::fabs( y.toDouble() - exact ) <= (0.5 + 1.0/256) / 65536 );
+        tQ16 z = expr< 24 >( a ) * expr< 24 >( b ) * expr< 24 >( c ) / (expr< 23 >( d ) * expr< 23 >( d ));
+        assert( std::fabs( z.toDouble() - a.toDouble() * b.toDouble() * c.toDouble() / (d.toDouble() * d.toDouble()) ) <= (0.5 + 1.0/256) / 65536 );
+
+        tQ31 k( random( 0.99 ) ), u( random( 0.99 ) ), v( random( 0.99 ) );
+        tQ31 w = expr( k ) * u * v;
+        assert( std::fabs( w.toDouble() - k.toDouble() * u.toDouble() * v.toDouble() ) <= 1.0 / 2147483648.0 );
+    }
+}
@@ -0,0 +1,128 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedFilter.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+typedef tFixedPoint< 14 > tQ14;
+typedef tFixedPoint< 12 > tQ12;
+typedef tFixedPoint< 14, short > tQ14s;
+typedef tFixedPoint< 12, short > tQ12s;
+
+static const int cCount = 200;
+
+/** Returns a test signal, a step plus a couple of tones **/
+static double signal( int n ) { return ((n >= 10)? 1.5 : 0.0) + 0.5*sin( 0.3*n ) + 0.25*sin( 2.1*n ); }
+
+static void testFir() {
+    const double cTaps[5] = { 0.1, 0.2, 0.4, 0.2, 0.1 };
+    tQ14 taps[5];
+    tQ14s taps16[5];
+    for (int i = 0; i < 5; ++i) {
+        taps[i] = tQ14( cTaps[i] );
+        taps16[i] = tQ14s( cTaps[i] );
+    }
+
+    tFir< 5, 14, 12 > fir( taps );
+    tFir< 5, 14, 12 > block( taps );
+    tFir< 5, 14, 12, short > fir16( taps16 );
+    tQ12 in[cCount], out[cCount];
+    for (int n = 0; n < cCount; ++n) in[n] = tQ12( signal( n ) );
+    block.process( in, out, 30 );
+    block.process( in + 30, out + 30, cCount - 30 );
+
+    for (int n = 0; n < cCount; ++n) {
+        double expected = 0;
+        for (int k = 0; k < 5 && k <= n; ++k) expected += taps[k].toDouble() * in[n - k].toDouble();
+        tQ12 y = fir.process( in[n] );
+        assert( fabs( y.toDouble() - expected ) <= 0.5/4096 + 1e-9 );
+        assert( y == out[n] );
+
+        // 16-bit samples go through the SIMD dot kernels where there are any
+        assert( fir16.process( tQ12s::create( short( in[n].qValue() ) ) ).qValue() == y.qValue() );
+    }
+
+    // the outputs saturate rather than wrapping
+    tQ14s gain[2] = { tQ14s( 1.5 ), tQ14s( 1.5 ) };
+    tFir< 2, 14, 12, short > loud( gain );
+    loud.process( tQ12s( short(7) ) );
+    assert( loud.process( tQ12s( short(7) ) ).qValue() == 32767 );
+    assert( loud.process( -tQ12s( short(7) ) ).qValue() == 0 );
+    assert( loud.process( -tQ12s( short(7) ) ).qValue() == -32768 );
+
+    // reset fills the delay line
+    fir.reset( tQ12( 2 ) );
+    assert( fir.process( tQ12( 2 ) ) == tQ12( 2 ) );
+}
+
+/** Returns the coefficients of a low-pass biquad (the RBJ cookbook design) **/
+static void lowPass( double w, double q, double* c ) {
+    double alpha = sin( w )/(2*q), a0 = 1 + alpha;
+    c[0] = (1 - cos( w ))/2/a0;
+    c[1] = (1 - cos( w ))/a0;
+    c[2] = c[0];
+    c[3] = -2*cos( w )/a0;
+    c[4] = (1 - alpha)/a0;
+}
+
+template< typename Form > static void testBiquad() {
+    double c[5];
+    lowPass( 0.2, 0.707, c );
+    const tQ14 b0( c[0] ), b1( c[1] ), b2( c[2] ), a1( c[3] ), a2( c[4] );
+    tBiquad< 14, 12, int, Form > biquad( b0, b1, b2, a1, a2 );
+    tBiquad< 14, 12, int, Form > block( b0, b1, b2, a1, a2 );
+    double q[5];
+    for (int i = 0; i < 5; ++i) q[i] = tQ14( c[i] ).toDouble();
+
+    tQ12 in[cCount], out[cCount];
+    for (int n = 0; n < cCount; ++n) in[n] = tQ12( signal( n ) );
+    block.process( in, out, 17 );
+    block.process( in + 17, out + 17, cCount - 17 );
+
+    // the reference uses the same quantised coefficients, inputs and fed back outputs, so each
+    // output is within the single rounding
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (int n = 0; n < cCount; ++n) {
+        double x = in[n].toDouble();
+        double expected = q[0]*x + q[1]*x1 + q[2]*x2 - q[3]*y1 - q[4]*y2;
+        tQ12 y = biquad.process( in[n] );
+        assert( fabs( y.toDouble() - expected ) <= 0.5/4096 + 1e-9 );
+        x2 = x1; x1 = x; y2 = y1; y1 = y.toDouble();
+        assert( y == out[n] );
+    }
+
+    // a constant input settles at the (unity) DC gain, and reset starts there
+    biquad.reset( tQ12( 1 ) );
+    for (int n = 0; n < 10; ++n) assert( abs( biquad.process( tQ12( 1 ) ).qValue() - 4096 ) <= 2 );
+}
+
+static void testLowPass() {
+    tLowPass< 4, 12 > lowPass;
+    tLowPass< 4, 12 > block;
+    tQ12 in[cCount], out[cCount];
+    for (int n = 0; n < cCount; ++n) in[n] = tQ12( signal( n ) );
+    block.process( in, out, 50 );
+    block.process( in + 50, out + 50, cCount - 50 );
+
+    double y = 0;
+    for (int n = 0; n < cCount; ++n) {
+        y += (in[n].toDouble() - y)/16;
+        tQ12 filtered = lowPass.process( in[n] );
+        assert( fabs( filtered.toDouble() - y ) <= 1.0/4096 );
+        assert( filtered == out[n] );
+    }
+
+    // a small step isn't lost to a dead-band
+    lowPass.reset( tQ12( 1 ) );
+    for (int n = 0; n < 200; ++n) lowPass.process( tQ12::create( 4096 + 3 ) );
+    assert( lowPass.output().qValue() == 4096 + 3 );
+    assert(( tLowPass< 4, 12 >( tQ12( 3 ) ).output() == tQ12( 3 ) ));
+}
+
+int main() {
+    testFir();
+    testBiquad< tDirectForm1 >();
+    testBiquad< tDirectForm2Transposed >();
+    testLowPass();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedLut.h"
+#include <assert.h>
+#include <math.h>
+
+typedef tFixedPoint< 8 > tQ8;
+typedef tFixedPoint< 12 > tQ12;
+typedef tFixedPoint< 15 > tQ15;
+
+/** A derating curve, 1 up to 80 degrees then falling to 0 at 120 degrees **/
+struct tDerating
+{
+    static constexpr double cFirst = 20.0;
+    static const int cLog2Step = 2;
+    static constexpr double value( double celsius ) { return (celsius < 80)? 1.0 : (celsius > 120)? 0.0 : 1.0 - (celsius - 80)/40; }
+};
+
+/** A smooth curve with a negative start and fractional spacing **/
+struct tCurve
+{
+    static constexpr double cFirst = -2.0;
+    static const int cLog2Step = -3;
+    static constexpr double value( double x ) { return 0.25*x*x - x; }
+};
+
+/** A map with values that don't fit a Q15 int **/
+struct tMap
+{
+    static constexpr double cFirstX = 0.0;
+    static const int cLog2StepX = 0;
+    static constexpr double cFirstY = -1.0;
+    static const int cLog2StepY = -2;
+    static constexpr double value( double x, double y ) { return 10000*x + 3*y - x*y; }
+};
+
+typedef tFixedLut< 8, 15, 26, tDerating > tDeratingLut;
+typedef tFixedLut< 12, 12, 33, tCurve > tCurveLut;
+typedef tFixedLut2< 12, 12, 15, 8, 9, tMap > tMapLut;
+
+static_assert( tDeratingLut::cTable[0] == 32768, "the tables are generated at compile-time" );
+
+int main() {
+    // the entries are exact, and lookups between them are linear
+    assert( tDeratingLut::entry( 0 ) == tQ15( 1 ) );
+    assert( tDeratingLut::entry( 25 ) == tQ15( 0 ) );
+    assert( tDeratingLut::lookup( tQ8( 100 ) ) == tQ15( 0.5 ) );
+    assert( tDeratingLut::lookup( tQ8( 90.0 ) ) == tQ15( 0.75 ) );
+    assert( tDeratingLut::lookup( tQ8( 81.0 ) ) == tQ15( 0.975 ) );
+
+    // inputs outside the table are clamped to the ends
+    assert( tDeratingLut::lookup( tQ8( -40 ) ) == tQ15( 1 ) );
+    assert( tDeratingLut::lookup( tQ8( 119.0 ) ) == tQ15( 0.025 ) );
+    assert( tDeratingLut::lookup( tQ8( 125 ) ) == tQ15( 0 ) );
+    assert( tDeratingLut()( tQ8( 500 ) ) == tQ15( 0 ) );
+
+    // interpolation error of a quadratic is h^2/8 * f'' = 1/512 with a spacing of 1/8
+    for (int i = -3*4096; i <= 3*4096; ++i) {
+        double x = i/4096.0;
+        double c = (x < -2)? -2 : (x > 2)? 2 : x;
+        double expected = 0.25*c*c - c;
+        assert( fabs( tCurveLut::lookup( tQ12::create( i ) ).toDouble() - expected ) <= 1.0/512 + 1.0/4096 );
+    }
+
+    // bilinear interpolation is exact for this map, up to the saturated entries at x = 7
+    for (int i = 0; i <= 6*8; ++i) {
+        for (int j = -6*32; j <= 4*32; ++j) {
+            double x = i/8.0, yIn = j/32.0;
+            double y = (yIn < -1)? -1 : (yIn > 1)? 1 : yIn;
+            double expected = 10000*x + 3*y - x*y;
+            assert( fabs( tMapLut::lookup( tQ12( x ), tQ12( yIn ) ).toDouble() - expected ) <= 1.0/32768 );
+        }
+    }
+    assert(( tMapLut::entry( 7, 0 ) == tQ15::create( 2147483647 ) ));
+    assert(( tMapLut::entry( 1, 8 ) == tQ15( 10002.0 ) ));
+    assert(( tMapLut::lookup( tQ12( 7 ), tQ12( 1 ) ) == tQ15::create( 2147483647 ) ));
+    return 0;
+}
@@ -0,0 +1,90 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPointBatch.h"
+#include <cassert>
+#include <cstdlib>
+
+typedef tFixedPoint< 12, short >     tShortQ12;
+typedef tFixedPoint< 15, short >     tShortQ15;
+typedef tSatFixedPoint< 12, short >  tSatShortQ12;
+typedef tFixedPoint< 16 >            tQ16;
+typedef tFixedPoint< 8 >             tQ8;
+
+static const unsigned cMaxCount = 40;
+
+template< typename FPType > static void randomise( FPType* values, unsigned count ) {
+    for (unsigned i = 0; i < count; ++i) values[i] = FPType::create( typename FPType::tValue( std::rand() ) );
+}
+
+template< typename FPType, typename FPType2 > static void check( unsigned count ) {
+    FPType a[cMaxCount], b[cMaxCount], out[cMaxCount], expected[cMaxCount];
+    FPType2 c[cMaxCount];
+    randomise( a, count );
+    randomise( b, count );
+    randomise( c, count );
+
+    add( a, b, out, count );
+    for (unsigned i = 0; i < count; ++i) assert( out[i] == a[i] + b[i] );
+
+    mul( a, c, out, count );
+    for (unsigned i = 0; i < count; ++i) assert( out[i] == ((expected[i] = a[i]) *= c[i]) );
+
+    for (unsigned i = 0; i < count; ++i) expected[i] = out[i] = b[i];
+    mac( a, c, out, count );
+    for (unsigned i = 0; i < count; ++i) assert( out[i] == (expected[i] += FPType( a[i] ) *= c[i]) );
+
+    if (count > 0) {
+        scale( a, c[0], out, count );
+        for (unsigned i = 0; i < count; ++i) assert( out[i] == ((expected[i] = a[i]) *= c[0]) );
+    }
+
+    tFixedPoint< FPType::cQBits - 4, int > narrow[cMaxCount];
+    roundedTo( a, narrow, count );
+    for (unsigned i = 0; i < count; ++i) assert( narrow[i] == (a[i].template roundedTo< FPType::cQBits - 4, int >()) );
+
+    // 32-bit operands are reduced so that the sum of the products can't overflow 64 bits
+    FPType da[cMaxCount];
+    FPType2 dc[cMaxCount];
+    for (unsigned i = 0; i < count; ++i) {
+        da[i] = FPType::create( a[i].qValue() >> (sizeof( a[i].qValue() ) > 2? 4 : 0) );
+        dc[i] = FPType2::create( c[i].qValue() >> (sizeof( c[i].qValue() ) > 2? 4 : 0) );
+    }
+    long long sum = 0;
+    for (unsigned i = 0; i < count; ++i) sum += (long long)( da[i].qValue() ) * dc[i].qValue();
+    assert( dot( da, dc, count ).qValue() == sum );
+
+    // the output can be one of the inputs
+    for (unsigned i = 0; i < count; ++i) expected[i] = a[i] + b[i];
+    add( a, b, a, count );
+    for (unsigned i = 0; i < count; ++i) assert( a[i] == expected[i] );
+}
+
+int main()
+{
+    for (unsigned count = 0; count <= cMaxCount; ++count) {
+        check< tShortQ12, tShortQ15 >( count );
+        check< tShortQ15, tShortQ12 >( count );
+        check< tQ16, tQ8 >( count );
+
+        tSatShortQ12 a[cMaxCount], b[cMaxCount], out[cMaxCount];
+        randomise( a, count );
+        randomise( b, count );
+        add( a, b, out, count );
+        for (unsigned i = 0; i < count; ++i) assert( out[i] == a[i] + b[i] );
+    }
+
+    // extreme values
+    tShortQ15 m[16], one[16];
+    for (unsigned i = 0; i < 16; ++i) {
+        m[i] = tShortQ15::create( -32768 );
+        one[i] = tShortQ15::create( 32767 );
+    }
+    assert( dot( m, m, 16 ).qValue() == 16ll << 30 );
+    tSatShortQ12 s[16];
+    for (unsigned i = 0; i < 16; ++i) s[i] = tSatShortQ12::create( 30000 );
+    add( s, s, s, 16 );
+    assert( s[0].qValue() == 32767 && s[15].qValue() == 32767 );
+    mul( m, m, one, 16 );
+    assert( one[0].qValue() == -32768 && one[15].qValue() == -32768 );      // 1.0 wraps for a Q15 short
+
+    return 0;
+}
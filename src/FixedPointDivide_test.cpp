@@ -0,0 +1,62 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPointDivide.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+typedef tFixedPoint< 8 >   tQ8;
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 15 >  tQ15;
+typedef tFixedPoint< 16 >  tQ16;
+
+int main()
+{
+    // the operators widen their pre-shift so this no longer overflows
+    tQ16 a16( 1000 );
+    a16 /= tQ16( 8 );
+    assert( a16 == 125 );
+    a16 /= tQ8( 0.5 );
+    assert( a16 == 250 );
+
+    // exact quotients
+    assert( (quotient< 12 >( tQ16( 300 ), tQ8( 1.5 ) ) == 200) );
+    assert( (quotient< 15 >( tQ8( 1 ), tQ8( 3 ) ).qValue() == (32768 + 1) / 3) );
+    assert( (quotient< 8 >( tQ8( -7.5 ), tQ12( 2.5 ) ) == -3) );
+    assert( (quotient< 4 >( tQ16( -7.5 ), tQ8( 2.5 ) ) == -3) );                // the divisor is shifted up
+    assert( (quotient< 0 >( tQ16( 7 ), tQ8( 2 ) ) == 4) );
+    assert( (quotient< 0 >( tQ16::create( 7 ), tQ8( 2 ) ) == 0) );
+    assert( (quotient< 24 >( tQ16( 1000 ), tQ16( 1 ) ).qValue() == int( 1000ll << 24 )) );   // wraps
+
+    // reciprocal quotients are accurate to within a couple of LSBs
+    srand( 1 );
+    for (int i = 0; i < 10000; ++i) {
+        const tQ12 divisor = tQ12::create( (rand() % 2000000) - 1000000 );
+        const tQ8  dividend = tQ8::create( (rand() % 2000000) - 1000000 );
+        if (divisor.qValue() == 0) continue;
+
+        const double expected = dividend.toDouble() / divisor.toDouble();
+        if (std::fabs( expected ) >= 32768) continue;
+
+        const tQ16 fast = quotient< 16, tReciprocalDivide >( dividend, divisor );
+        const tQ16 exact = quotient< 16 >( dividend.increasedTo< 16 >(), divisor );
+        assert( std::fabs( fast.toDouble() - expected ) <= 2.0 / 65536 + std::fabs( expected ) * 1e-8 );
+        assert( std::abs( fast.qValue() - exact.qValue() ) <= 2 );
+    }
+
+    // one reciprocal, many divisions
+    tReciprocal< 8 > invBus( tQ8( 400 ) );
+    assert( invBus.divide< 15 >( tQ8( 200 ) ) == tQ15( 0.5 ) );
+    assert( invBus.divide< 15 >( tQ8( -100 ) ) == tQ15::create( -8192 ) );
+    assert( (invBus.divide< 15, 12, short >( tFixedPoint< 12, short >( short( 4 ) ) ).qValue() == 328) );
+
+    // overflow and divide by zero saturate
+    assert( invBus.divide< 30 >( tQ8( 1000 ) ).qValue() == std::numeric_limits<int>::max() );
+    tReciprocal< 8 > invZero( tQ8( 0 ) );
+    assert( invZero.divide< 8 >( tQ8( -1 ) ).qValue() == std::numeric_limits<int>::min() );
+
+    // powers of two normalise to exactly 0.5
+    tReciprocal< 0 > invTwo( tFixedPoint< 0 >( 2 ) );
+    assert( invTwo.divide< 0 >( tFixedPoint< 0 >( 1000 ) ) == 500 );
+
+    return 0;
+}
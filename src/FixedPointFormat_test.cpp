@@ -0,0 +1,83 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPointFormat.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef tFixedPoint< 8 >   tQ8;
+typedef tFixedPoint< 16 >  tQ16;
+
+/** Returns 'value' formatted by toChars, which is kept until the next call **/
+template< typename FPType > const char* text( const FPType& value, unsigned decimals ) {
+    static char buffer[64];
+    char* end = toChars( buffer, value, decimals );
+    assert( *end == '\0' && end == buffer + std::strlen( buffer ) );
+    return buffer;
+}
+
+template< typename FPType > FPType parsed( const char* text ) {
+    FPType value;
+    const char* end = fromChars( text, text + std::strlen( text ), value );
+    assert( *end == '\0' );
+    return value;
+}
+
+int main()
+{
+    // formatting, including negative values and rounding into the integer part
+    assert( std::strcmp( text( tQ8( 1.25 ), 2 ), "1.25" ) == 0 );
+    assert( std::strcmp( text( tQ8( -1.25 ), 3 ), "-1.250" ) == 0 );
+    assert( std::strcmp( text( tQ8( -0.25 ), 1 ), "-0.3" ) == 0 );
+    assert( std::strcmp( text( tQ8( 3 ), 0 ), "3" ) == 0 );
+    assert( std::strcmp( text( tQ8::create( 255 ), 2 ), "1.00" ) == 0 );
+    assert( std::strcmp( text( tQ8::create( -255 ), 2 ), "-1.00" ) == 0 );
+    assert( std::strcmp( text( tQ8::create( -1 ), 1 ), "0.0" ) == 0 );
+    assert( std::strcmp( text( tQ16::create( -2147483647 - 1 ), 4 ), "-32768.0000" ) == 0 );
+    assert( std::strcmp( text( tQ16( 0.5 ), 12 ), "0.500000000000" ) == 0 );
+    assert( std::strcmp( text( tFixedPoint< 0 >( 42 ), 2 ), "42.00" ) == 0 );
+    assert( std::strcmp( text( tFixedPoint< 60, long long >::create( 3ll << 59 ), 3 ), "1.500" ) == 0 );
+    assert( std::strcmp( text( tFixedPoint< 4, unsigned >( 200000000u ), 1 ), "200000000.0" ) == 0 );
+
+    // halves round away from 0
+    assert( std::strcmp( text( tQ16::create( 2048 ), 4 ), "0.0313" ) == 0 );
+    assert( std::strcmp( text( tQ16::create( -2048 ), 4 ), "-0.0313" ) == 0 );
+
+    // the same as printf with a double, except for the halves which printf rounds to even
+    for (int i = 0; i < 10000; ++i) {
+        tQ16 x = tQ16::create( std::rand() - RAND_MAX/2 );
+        char expected[64];
+        std::snprintf( expected, sizeof(expected), "%.4f", x.toDouble() );
+        if (std::strcmp( expected, "-0.0000" ) == 0) std::strcpy( expected, "0.0000" );
+        bool half = ((long long)( x.qValue() & 0xffff ) * 10000) % 65536 == 32768;
+        assert( half || std::strcmp( text( x, 4 ), expected ) == 0 );
+        assert( parsed< tQ16 >( text( x, 5 ) ) == x );
+    }
+
+    // fracPlaces
+    assert( tQ8( 1.25 ).fracPlaces( 3 ) == 250 );
+    assert( tQ8( -1.75 ).fracPlaces( 2 ) == 75 );
+    assert( tQ16::create( 1 ).fracPlaces( 9 ) == 15259 );
+
+    // parsing
+    assert( parsed< tQ8 >( "1.25" ) == tQ8( 1.25 ) );
+    assert( parsed< tQ8 >( "-1.25" ) == tQ8( -1.25 ) );
+    assert( parsed< tQ8 >( "+3" ) == tQ8( 3 ) );
+    assert( parsed< tQ8 >( ".5" ) == tQ8( 0.5 ) );
+    assert( parsed< tQ8 >( "2." ) == tQ8( 2 ) );
+    assert( parsed< tQ16 >( "0.00001525878906250000001" ).qValue() == 1 );
+    assert( parsed< tQ16 >( "-0.0000076296" ).qValue() == 0 );
+    assert( (parsed< tFixedPoint< 8, unsigned > >( "12.5" ).qValue() == 3200) );
+
+    tQ8 value( 7 );
+    const char* bad = "-x";
+    assert( fromChars( bad, bad + 2, value ) == bad && value == tQ8( 7 ) );
+    assert( fromChars( bad + 1, bad + 2, value ) == bad + 1 );
+    const char* unsignedText = "-1";
+    tFixedPoint< 8, unsigned > u;
+    assert( fromChars( unsignedText, unsignedText + 2, u ) == unsignedText );
+    const char* list = "1.5,2";
+    const char* end = fromChars( list, list + 5, value );
+    assert( *end == ',' && value == tQ8( 1.5 ) );
+    assert( fromChars( end + 1, list + 5, value ) == list + 5 && value == tQ8( 2 ) );
+}
@@ -0,0 +1,97 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#define FIXEDPOINT_ENABLE_INSTRUMENTATION
+#include "../include/SatFixedPoint.h"
+#include "../include/FixedPointDivide.h"
+#include <cassert>
+#include <cstring>
+#include <string>
+
+typedef tFixedPoint< 12 >            tQ12;
+typedef tFixedPoint< 8 >             tQ8;
+typedef tFixedPoint< 12, short >     tShortQ12;
+typedef tSatFixedPoint< 16 >         tSatQ16;
+
+static std::string output;
+static void write( const char* text ) { output += text; }
+
+template< int QBits, typename DataType > static unsigned long count( tFixedPointEvent event )
+    { return tFixedPointStats< QBits, DataType >::stats().counters.counts[event]; }
+
+// constants are still evaluated at compile-time
+constexpr tQ12 cHalf = 0.5_q12;
+static_assert( cHalf.qValue() == 2048, "constexpr construction must still work with instrumentation enabled" );
+
+int main()
+{
+    // operations that fit don't record anything
+    tShortQ12 a( short( 1 ) );
+    tShortQ12 b( short( 2 ) );
+    a += b;
+    a = a - b;
+    a *= b;
+    assert( (count< 12, short >( cFixedPointWrap ) == 0) );
+
+    // wraps
+    a = tShortQ12( short( 7 ) ) + b;            // 9 doesn't fit in a Q12 short
+    assert( (count< 12, short >( cFixedPointWrap ) == 1) );
+    a = tShortQ12( short( 4 ) );
+    a *= b;
+    a = tShortQ12( short( 6 ) );
+    a += b;
+    assert( (count< 12, short >( cFixedPointWrap ) == 3) );
+    tShortQ12 c( short( 100 ) );
+    assert( (count< 12, short >( cFixedPointWrap ) == 4) );
+
+    tQ12 big = tQ12::create( std::numeric_limits<int>::max() );
+    big += tQ12::create( 1 );
+    assert( (count< 12, int >( cFixedPointWrap ) == 1) );
+    tShortQ12 narrowed = tFixedPoint< 16 >( 10 ).roundedTo< 12, short >();
+    assert( (count< 12, short >( cFixedPointWrap ) == 5) );
+    assert( narrowed.qValue() == 40960 - 65536 );    // the value still wraps, it is only recorded
+
+    // rounding losses
+    tQ8 q8 = tQ12( 1.5 ).roundedTo< 8 >();
+    assert( (count< 8, int >( cFixedPointRoundingLoss ) == 0) );
+    q8 = tQ12::create( 4097 ).roundedTo< tQ8 >();
+    q8 = tQ12::create( 4097 ).truncatedTo< 8 >();
+    assert( (count< 8, int >( cFixedPointRoundingLoss ) == 2) );
+
+    // saturations, recorded against call sites as well
+    unsigned siteLine = 0;
+    {
+        FIXEDPOINT_SITE(); siteLine = __LINE__;
+        tSatQ16 s( 30000 );
+        s += tSatQ16( 20000 );
+        s = -tSatQ16( 30000 ) - tSatQ16( 20000 );
+        tSatQ16 t( 1.0 );
+        t += t;
+    }
+    assert( (count< 16, int >( cFixedPointSaturate ) == 2) );
+    tSatQ16( 30000 ) + tSatQ16( 20000 );
+    assert( (count< 16, int >( cFixedPointSaturate ) == 3) );
+
+    fixedPointDumpStats( write );
+    assert( output.find( "Q12 int16: wraps 5, saturations 0, rounding losses 0\n" ) != std::string::npos );
+    assert( output.find( "Q12 int32: wraps 1, saturations 0, rounding losses 0\n" ) != std::string::npos );
+    assert( output.find( "Q8 int32: wraps 0, saturations 0, rounding losses 2\n" ) != std::string::npos );
+    assert( output.find( "Q16 int32: wraps 0, saturations 3, rounding losses 0\n" ) != std::string::npos );
+    const std::string site = std::string( __FILE__ ) + ":" + std::to_string( siteLine ) + ": wraps 0, saturations 2, rounding losses 0\n";
+    assert( output.find( site ) != std::string::npos );
+
+    fixedPointResetStats();
+    output.clear();
+    fixedPointDumpStats( write );
+    assert( output.empty() );
+
+    // divisions, where an exact quotient wraps and a reciprocal one saturates
+    quotient< 24 >( tFixedPoint< 16 >( 1000 ), tFixedPoint< 16 >( 1 ) );
+    assert( (count< 24, int >( cFixedPointWrap ) == 1) );
+    tReciprocal< 8 > invBus( tQ8( 400 ) );
+    invBus.divide< 30 >( tQ8( 200 ) );
+    assert( (count< 30, int >( cFixedPointSaturate ) == 0) );
+    invBus.divide< 30 >( tQ8( 1000 ) );
+    invBus.divide< 30 >( tQ8( -1000 ) );
+    assert( (count< 30, int >( cFixedPointSaturate ) == 2) );
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPointMath.h"
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+typedef tFixedPoint< 12 >         tQ12;
+typedef tFixedPoint< 16 >         tQ16;
+typedef tFixedPoint< 30 >         tQ30;
+typedef tFixedPoint< 15, short >  tShortQ15;
+
+static bool near( double a, double b, double tolerance ) { return std::fabs( a - b ) <= tolerance; }
+
+int main()
+{
+    const double cPi = 3.14159265358979323846;
+
+    // sin and cos over several turns, including negative angles
+    for (double a = -7.0; a <= 7.0; a += 0.01) {
+        const tQ16 angle( a );
+        const double exact = angle.toDouble();
+        assert( near( sin< 30 >( angle ).toDouble(), std::sin( exact ), 1e-5 ) );
+        assert( near( cos< 30 >( angle ).toDouble(), std::cos( exact ), 1e-5 ) );
+
+        const tSinCos< 15 > sc = sincos< 15 >( angle );
+        assert( sc.sin == (sin< 15 >( angle )) );
+        assert( sc.cos == (cos< 15 >( angle )) );
+    }
+    assert( (sin< 30 >( tQ12( 0 ) ).qValue() == 0) );
+    assert( (cos< 30 >( tQ12( 0 ) ).qValue() == (1 << 30)) );
+
+    // results saturate
+    assert( (sin< 15 >( tFixedPoint< 12, short >( cPi/2 ) ).qValue() == 32767) );
+    assert( (cos< 15 >( tFixedPoint< 12, short >( cPi ) ).qValue() == -32768) );
+    assert( (cos< 31 >( tQ16( 0 ) ).qValue() == std::numeric_limits<int>::max()) );
+
+    // atan2 in every quadrant and on the axes
+    for (double a = -3.14; a < 3.14; a += 0.01) {
+        for (double r = 0.001; r < 30000; r *= 7) {
+            const tQ16 y( r*std::sin( a ) );
+            const tQ16 x( r*std::cos( a ) );
+            const double exact = std::atan2( y.toDouble(), x.toDouble() );
+            const double result = atan2< 28 >( y, x ).toDouble();
+            assert( near( result, exact, 1e-6 ) || near( std::fabs( result ), cPi, 1e-6 ) );
+        }
+    }
+    assert( atan2< 16 >( tQ16( 0 ), tQ16( 0 ) ) == 0 );
+    assert( near( (atan2< 16 >( tQ16( 1 ), tQ16( 0 ) ).toDouble()), cPi/2, 1e-4 ) );
+    assert( near( (atan2< 16 >( tQ16( -2 ), tQ16( 0 ) ).toDouble()), -cPi/2, 1e-4 ) );
+    assert( near( (atan2< 13 >( tShortQ15( 0.0 ), tShortQ15( -0.5 ) ).toDouble()), -cPi, 1e-3 ) );
+
+    // sqrt and rsqrt
+    for (int q = 1; q < std::numeric_limits<int>::max()/2; q += q/3 + 1) {
+        const tQ16 v = tQ16::create( q );
+        const double exact = std::sqrt( v.toDouble() );
+        assert( near( sqrt< 16 >( v ).toDouble(), exact, 1e-4 ) );
+        assert( std::fabs( rsqrt< 24 >( v ).toDouble() - std::min( 1/exact, 128.0 ) ) <= 1e-6 / exact + 1e-7 );     // saturates at 128
+        assert( near( (sqrt< 15 >( tFixedPoint< 15 >::create( q ) ).toDouble()), std::sqrt( q / 32768.0 ), 1e-4 ) );
+    }
+    assert( sqrt< 16 >( tQ16( 4 ) ) == 2 );
+    assert( sqrt< 16 >( tQ16( -4 ) ) == 0 );
+    assert( (sqrt< 28 >( tQ12( 2 ) ).qValue() - int( std::sqrt( 2.0 )*(1 << 28) ) <= 4) );
+    assert( rsqrt< 16 >( tQ16( 0 ) ).qValue() == std::numeric_limits<int>::max() );
+    assert( rsqrt< 16 >( tQ16( 0.25 ) ) == 2 );
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#define FIXEDPOINT_ENABLE_PROFILING
+
+// a fake clock that moves on by 'clockStep' each time it is read, so that the times are known
+static unsigned long long clockNow = 0, clockStep = 10;
+#define FIXEDPOINT_PROFILE_CLOCK()  (clockNow += clockStep)
+#define FIXEDPOINT_PROFILE_UNITS    "steps"
+
+static const char* overrunName = 0;
+static unsigned long long overrunTicks = 0;
+#define FIXEDPOINT_PROFILE_OVERRUN( name, ticks, budget )  (overrunName = (name), overrunTicks = (ticks))
+
+#include "../include/FixedPointDivide.h"
+#include "../include/FixedFilter.h"
+#include "../include/FocTransform.h"
+#include "../include/PIController.h"
+#include <cassert>
+#include <cstring>
+#include <string>
+
+static std::string output;
+static void append( const char* text ) { output += text; }
+
+static void stage( unsigned long long step ) {
+    FIXEDPOINT_PROFILE_BUDGET( "stage", 25 );
+    clockNow += step;
+}
+
+int main()
+{
+    // each run is the step plus one read of the clock
+    stage( 0 );
+    stage( 20 );
+    stage( 5 );
+    const tFixedProfileStage* s = fixedProfileStage( "stage" );
+    assert( s && s->runs == 3 && s->min == 10 && s->max == 30 && s->total == 55 && s->mean() == 18 );
+    assert( s->budget == 25 && s->overruns == 1 && std::strcmp( overrunName, "stage" ) == 0 && overrunTicks == 30 );
+
+    // nested stages are inclusive
+    {
+        FIXEDPOINT_PROFILE( "outer" );
+        stage( 0 );
+    }
+    assert( fixedProfileStage( "outer" )->max == 30 && fixedProfileStage( "stage" )->runs == 4 );
+
+    // the library's kernels are stages too, shared between types
+    tFixedPoint< 16 > angle( 1.0 );
+    sin< 15 >( angle );
+    sin< 30 >( tFixedPoint< 12, short >( short( 1 ) ) );
+    tSinCos< 15 > sc = sincos< 15 >( angle );
+    park< 12 >( clarke< 12 >( tFixedPoint< 12 >( 1 ), tFixedPoint< 12 >( 2 ) ), sc );
+    quotient< 16 >( tFixedPoint< 16 >( 3 ), tFixedPoint< 16 >( 2 ) );
+    tReciprocal< 16 > r( tFixedPoint< 16 >( 2 ) );
+    tPIController< 16, 16 > pi( tFixedPoint< 16 >( 0.5 ), tFixedPoint< 16 >( 0.1 ), -tFixedPoint< 16 >( 10 ), tFixedPoint< 16 >( 10 ) );
+    pi.update( tFixedPoint< 16 >( 1 ) );
+    tLowPass< 4, 12 > lp;
+    tFixedPoint< 12 > samples[4];
+    lp.process( samples, samples, 4 );
+    assert( fixedProfileStage( "sin" )->runs == 2 && fixedProfileStage( "sincos" )->runs == 1 );
+    assert( fixedProfileStage( "clarke" )->runs == 1 && fixedProfileStage( "park" )->runs == 1 );
+    assert( fixedProfileStage( "quotient" )->runs == 1 && fixedProfileStage( "reciprocal" )->runs == 1 );
+    assert( fixedProfileStage( "pi" )->runs == 1 && fixedProfileStage( "low-pass block" )->runs == 1 );
+    assert( !fixedProfileStage( "low-pass" ) && !fixedProfileStage( "cos" ) );
+
+    // the dump, and resetting keeps the stages and their budgets
+    fixedProfileDump( append );
+    assert( output.find( "stage: runs 4, min 10, mean 16, max 30 steps, budget 25, overruns 1\n" ) == 0 );
+    assert( output.find( "outer: runs 1, min 30, mean 30, max 30 steps\n" ) != std::string::npos );
+    assert( output.find( "sin: runs 2, min 10, mean 10, max 10 steps\n" ) != std::string::npos );
+    fixedProfileReset();
+    output.clear();
+    fixedProfileDump( append );
+    assert( output.empty() );
+    stage( 30 );
+    assert( fixedProfileStage( "stage" )->runs == 1 && fixedProfileStage( "stage" )->overruns == 1 );
+
+    return 0;
+}
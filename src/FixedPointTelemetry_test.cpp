@@ -0,0 +1,108 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPointTelemetry.h"
+#include <cassert>
+#include <cstdlib>
+
+typedef tFixedPoint< 12, short >  tShortQ12;
+typedef tFixedPoint< 16 >  tQ16;
+typedef tFixedPoint< 8, unsigned >  tUQ8;
+typedef tFixedPoint< 40, long long >  tBigQ40;
+
+typedef tFixedTelemetryChannel< tShortQ12, 12 >  tCurrentChannel;
+typedef tFixedTelemetryChannel< tQ16, 10, true >  tSpeedChannel;
+typedef tFixedTelemetryChannel< tUQ8, 5 >  tFlagsChannel;
+typedef tFixedTelemetryChannel< tBigQ40 >  tBigChannel;
+
+int main()
+{
+    unsigned char buffer[2048];
+    tFixedTelemetryWriter out( buffer, sizeof(buffer) );
+
+    tCurrentChannel::header().write( out );
+    tSpeedChannel::header().write( out );
+    tFlagsChannel::header().write( out );
+    tBigChannel::header().write( out );
+    assert( out.size() == 16 );
+
+    tShortQ12 currents[100];
+    tQ16 speeds[100];
+    tUQ8 flags[100];
+    tBigQ40 bigs[100];
+    tCurrentChannel current;
+    tSpeedChannel speed;
+    tFlagsChannel flag;
+    tBigChannel big;
+    int s = 0;
+    for (int i = 0; i < 100; ++i) {
+        currents[i] = tShortQ12::create( short( std::rand() % 4096 - 2048 ) );
+        s += std::rand() % 1000 - 500;
+        speeds[i] = tQ16::create( s );
+        flags[i] = tUQ8::create( unsigned( std::rand() % 32 ) );
+        bigs[i] = tBigQ40::create( (long long)( std::rand() ) * std::rand() - (1ll << 60) );
+        assert( current.write( out, currents[i] ) );
+        assert( speed.write( out, speeds[i] ) );
+        assert( flag.write( out, flags[i] ) );
+        assert( big.write( out, bigs[i] ) );
+    }
+    out.flush();
+    assert( out.size() == 16 + (100*(12 + 10 + 5 + 64) + 7)/8 && !out.overflowed() );
+
+    // decoding with the types known at compile-time
+    tFixedTelemetryReader in( buffer, out.size() );
+    assert( tFixedTelemetryHeader::read( in ) == tCurrentChannel::header() );
+    assert( tFixedTelemetryHeader::read( in ) == tSpeedChannel::header() );
+    assert( tFixedTelemetryHeader::read( in ) == tFlagsChannel::header() );
+    assert( tFixedTelemetryHeader::read( in ) == tBigChannel::header() );
+    tCurrentChannel current2;
+    tSpeedChannel speed2;
+    tFlagsChannel flag2;
+    tBigChannel big2;
+    for (int i = 0; i < 100; ++i) {
+        assert( current2.read( in ) == currents[i] );
+        assert( speed2.read( in ) == speeds[i] );
+        assert( flag2.read( in ) == flags[i] );
+        assert( big2.read( in ) == bigs[i] );
+    }
+    assert( in.remaining() == 0 && !in.overflowed() );
+
+    // decoding from the headers alone
+    tFixedTelemetryReader in2( buffer, out.size() );
+    tFixedTelemetryDecoder decoders[4];
+    for (int c = 0; c < 4; ++c) decoders[c] = tFixedTelemetryDecoder( tFixedTelemetryHeader::read( in2 ) );
+    assert( decoders[0].header().qBits == 12 && decoders[0].header().dataBits == 16 && decoders[0].header().isSigned() );
+    assert( decoders[1].header().bits == 10 && decoders[1].header().delta() );
+    assert( !decoders[2].header().isSigned() && decoders[2].header().dataBits == 32 );
+    for (int i = 0; i < 100; ++i) {
+        assert( decoders[0].read( in2 ) == currents[i].qValue() );
+        assert( decoders[1].read( in2 ) == speeds[i].qValue() );
+        assert( decoders[2].read( in2 ) == flags[i].qValue() );
+        assert( decoders[3].read( in2 ) == bigs[i].qValue() );
+    }
+
+    // values that don't fit are clamped, deltas catch up afterwards
+    tFixedTelemetryWriter out2( buffer, sizeof(buffer) );
+    tCurrentChannel current3;
+    tSpeedChannel speed3;
+    assert( !current3.write( out2, tShortQ12::create( 3000 ) ) );
+    assert( !current3.write( out2, tShortQ12::create( -3000 ) ) );
+    assert( speed3.write( out2, tQ16::create( 500 ) ) );
+    assert( !speed3.write( out2, tQ16::create( 1500 ) ) );
+    assert( speed3.write( out2, tQ16::create( 1500 ) ) );
+    out2.flush();
+    tFixedTelemetryReader in3( buffer, out2.size() );
+    tCurrentChannel current4;
+    tSpeedChannel speed4;
+    assert( current4.read( in3 ).qValue() == 2047 );
+    assert( current4.read( in3 ).qValue() == -2048 );
+    assert( speed4.read( in3 ).qValue() == 500 );
+    assert( speed4.read( in3 ).qValue() == 1011 );
+    assert( speed4.read( in3 ).qValue() == 1500 );
+
+    // running out of room
+    tFixedTelemetryWriter small( buffer, 2 );
+    tCurrentChannel::header().write( small );
+    assert( small.overflowed() && small.size() == 2 );
+    tFixedTelemetryReader short2( buffer, 1 );
+    short2.get( 12 );
+    assert( short2.overflowed() );
+}
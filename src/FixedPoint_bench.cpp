@@ -0,0 +1,178 @@
+// Micro-benchmarks comparing each tFixedPoint operation with the equivalent hand-written integer
+// code. On the host the times are in nanoseconds (from std::chrono::steady_clock), on a Cortex-M3
+// or later they are in cycles from the DWT cycle counter, which this enables. eg.
+//
+//   g++ -std=c++11 -O2 FixedPoint_bench.cpp && ./a.out
+//
+// Add -DFIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT to time the double conversions as well.
+//
+// On a target define FIXEDPOINT_BENCH_WRITE( text ) to a function that writes a string (eg. to a
+// UART) and call fixedPointBench() from the application, instead of building main().
+
+#include "../include/FixedPoint.h"
+#include "../include/FixedPointTarget.h"
+#include "../include/PIController.h"
+
+#include <stdio.h>
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define FIXEDPOINT_BENCH_DWT
+#else
+#include <chrono>
+#endif
+
+#ifndef FIXEDPOINT_BENCH_WRITE
+#define FIXEDPOINT_BENCH_WRITE( text )  fputs( text, stdout )
+#define FIXEDPOINT_BENCH_MAIN
+#endif
+
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 16 >  tQ16;
+
+/** The number of values each operation is timed over, and the number of times it is repeated **/
+static const int cValues = 256;
+static const int cRepeats = 64;
+
+static int rawA[cValues], rawB[cValues];
+static tQ16 fixedA[cValues], fixedB[cValues];
+static tQ12 fixedB12[cValues];
+static float floats[cValues];
+#ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+static double doubles[cValues];
+#endif
+
+static tPIController< 16, 16 > pi( 0.8_q16, 0.02_q16, -tQ16( 100 ), tQ16( 100 ) );
+static long long piIntegrator;
+static const long long cPiLimit = 100ll << 32;
+
+/** Stops the compiler from optimising away the results of the timed loops **/
+static volatile long long sink;
+
+
+//-------------------------------------------------------------------------------------------------
+// Timing
+
+#ifdef FIXEDPOINT_BENCH_DWT
+
+static volatile unsigned& cDemcr  = *reinterpret_cast< volatile unsigned* >( 0xE000EDFC );
+static volatile unsigned& cDwtCtrl = *reinterpret_cast< volatile unsigned* >( 0xE0001000 );
+static volatile unsigned& cCyccnt = *reinterpret_cast< volatile unsigned* >( 0xE0001004 );
+
+static const char* const cUnits = "cycles";
+static void startTimer() { cDemcr |= 1u << 24; cCyccnt = 0; cDwtCtrl |= 1u; }
+static unsigned long long now() { return cCyccnt; }
+
+#else
+
+static const char* const cUnits = "ns";
+static void startTimer() {}
+static unsigned long long now()
+    { return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count(); }
+
+#endif
+
+/** Returns the time per value taken by 'op', which is called with the index of each value and
+    returns a result to add to the sink **/
+template< typename Op > static double timed( Op op ) {
+    long long sum = 0;
+    unsigned long long start = now();
+    for (int r = 0; r < cRepeats; ++r)
+        for (int i = 0; i < cValues; ++i)
+            sum += op( i );
+    unsigned long long end = now();
+    sink = sink + sum;
+    return double( end - start ) / (double( cRepeats ) * cValues);
+}
+
+/** Times 'fixed' and its hand-written equivalent 'manual' and writes a line comparing them **/
+template< typename Fixed, typename Manual > static void compare( const char* name, Fixed fixed, Manual manual ) {
+    double fixedTime = timed( fixed );
+    double manualTime = timed( manual );
+    char line[128];
+    snprintf( line, sizeof(line), "%-16s fixed %8.2f %s  manual %8.2f %s  ratio %5.2f\n",
+              name, fixedTime, cUnits, manualTime, cUnits, manualTime > 0 ? fixedTime/manualTime : 0.0 );
+    FIXEDPOINT_BENCH_WRITE( line );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Benchmarks
+
+void fixedPointBench() {
+    startTimer();
+    FIXEDPOINT_BENCH_WRITE( "target: " FIXEDPOINT_TARGET_NAME "\n" );
+
+    unsigned seed = 12345;
+    for (int i = 0; i < cValues; ++i) {
+        seed = seed*1664525u + 1013904223u;
+        rawA[i] = int( seed >> 8 ) - (1 << 23);             // +-128.0 in Q16
+        seed = seed*1664525u + 1013904223u;
+        rawB[i] = int( seed >> 12 ) + (1 << 14);            // 0.25 to 16.25 in Q16
+        fixedA[i] = tQ16::create( rawA[i] );
+        fixedB[i] = tQ16::create( rawB[i] );
+        fixedB12[i] = tQ12::create( rawB[i] >> 4 );
+        floats[i] = float( rawA[i] ) * (1/65536.0f);
+#ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+        doubles[i] = rawA[i] / 65536.0;
+#endif
+    }
+
+    compare( "add",
+             []( int i ) { return (fixedA[i] + fixedB[i]).qValue(); },
+             []( int i ) { return rawA[i] + rawB[i]; } );
+
+    compare( "mul",
+             []( int i ) { tQ16 x = fixedA[i]; x *= fixedB[i]; return x.qValue(); },
+             []( int i ) { return int( ((long long)( rawA[i] ) * rawB[i] + (1 << 15)) >> 16 ); } );
+
+    compare( "mul cross-Q",
+             []( int i ) { tQ16 x = fixedA[i]; x *= fixedB12[i]; return x.qValue(); },
+             []( int i ) { return int( ((long long)( rawA[i] ) * (rawB[i] >> 4) + (1 << 11)) >> 12 ); } );
+
+    compare( "div",
+             []( int i ) { tQ16 x = fixedA[i]; x /= fixedB[i]; return x.qValue(); },
+             []( int i ) { long long n = (long long)( rawA[i] ) * 65536; return int( (n < 0)? (n - rawB[i]/2) / rawB[i] : (n + rawB[i]/2) / rawB[i] ); } );
+
+    compare( "roundedTo",
+             []( int i ) { return fixedA[i].roundedTo< 12 >().qValue(); },
+             []( int i ) { return (rawA[i] + (1 << 3)) >> 4; } );
+
+    compare( "fracPlaces",
+             []( int i ) { tQ16 x = fixedA[i]; return x.fracPlaces( 3 ); },
+             []( int i ) { int f = rawA[i] < 0 ? -rawA[i] : rawA[i]; return int( ((f & 0xFFFF)*1000LL + (1 << 15)) >> 16 ); } );
+
+    compare( "PI update",
+             []( int i ) { return pi.update( fixedA[i] ).qValue(); },
+             []( int i ) {
+                 long long integrator = piIntegrator + 1311ll * rawA[i];
+                 long long sum = 52429ll * rawA[i] + integrator;
+                 long long clamped = (sum > cPiLimit)? cPiLimit : (sum < -cPiLimit)? -cPiLimit : sum;
+                 piIntegrator = (integrator > cPiLimit)? cPiLimit : (integrator < -cPiLimit)? -cPiLimit : integrator;
+                 return int( (clamped + (1 << 15)) >> 16 );
+             } );
+
+    compare( "from float",
+             []( int i ) { return tQ16::fromFloat( floats[i] ).qValue(); },
+             []( int i ) { return int( floats[i]*65536.0f ); } );
+
+    compare( "to float",
+             []( int i ) { return (long long)( fixedA[i].toFloat()*8 ); },
+             []( int i ) { return (long long)( float( rawA[i] )*(8/65536.0f) ); } );
+
+#ifdef FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+    compare( "from double",
+             []( int i ) { return tQ16( doubles[i] ).qValue(); },
+             []( int i ) { return int( doubles[i]*65536 + (doubles[i] < 0 ? -0.5 : 0.5) ); } );
+
+    compare( "to double",
+             []( int i ) { return (long long)( fixedA[i].toDouble()*8 ); },
+             []( int i ) { return (long long)( rawA[i]/65536.0*8 ); } );
+#endif
+}
+
+#ifdef FIXEDPOINT_BENCH_MAIN
+int main() {
+    fixedPointBench();
+    return 0;
+}
+#endif
@@ -0,0 +1,64 @@
+// Pairs of functions used by FixedPoint_codegen.sh to check that each tFixedPoint operation
+// compiles to no more instructions than the equivalent hand-written integer code. Each "fixed_xxx"
+// function has a "manual_xxx" counterpart, and the arguments and results are passed by value so
+// that the cost of passing the fixed-point class around is checked as well.
+
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedPoint.h"
+#include "../include/FixedUnits.h"
+
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 16 >  tQ16;
+
+extern "C" {
+
+tQ16 fixed_add( tQ16 a, tQ16 b ) { return a + b; }
+int manual_add( int a, int b ) { return a + b; }
+
+tQ16 fixed_sub( tQ16 a, tQ16 b ) { return a - b; }
+int manual_sub( int a, int b ) { return a - b; }
+
+tQ16 fixed_negate( tQ16 a ) { return -a; }
+int manual_negate( int a ) { return -a; }
+
+tQ16 fixed_mul( tQ16 a, tQ16 b ) { return a *= b; }
+int manual_mul( int a, int b ) { return int( ((long long)( a ) * b + (1 << 15)) >> 16 ); }
+
+tQ16 fixed_mul_cross( tQ16 a, tQ12 b ) { return a *= b; }
+int manual_mul_cross( int a, int b ) { return int( ((long long)( a ) * b + (1 << 11)) >> 12 ); }
+
+tQ16 fixed_mul_int( tQ16 a, int b ) { return a * b; }
+int manual_mul_int( int a, int b ) { return a * b; }
+
+tFixedPoint< 28, long long > fixed_mul_wide( tQ16 a, tQ12 b ) { return a.multipliedBy( b ); }
+long long manual_mul_wide( int a, int b ) { return (long long)( a ) * b; }
+
+tQ16 fixed_div( tQ16 a, tQ16 b ) { return a /= b; }
+int manual_div( int a, int b ) { long long n = (long long)( a ) * 65536; return int( ((n < 0) == (b < 0))? (n + b/2) / b : (n - b/2) / b ); }
+
+tQ12 fixed_rounded( tQ16 a ) { return a.roundedTo< 12 >(); }
+int manual_rounded( int a ) { return (a + (1 << 3)) >> 4; }
+
+tQ12 fixed_truncated( tQ16 a ) { return a.truncatedTo< 12 >(); }
+int manual_truncated( int a ) { return a >> 4; }
+
+tQ16 fixed_increased( tQ12 a ) { return a.increasedTo< 16 >(); }
+int manual_increased( int a ) { return a << 4; }
+
+bool fixed_less( tQ16 a, tQ16 b ) { return a < b; }
+bool manual_less( int a, int b ) { return a < b; }
+
+int fixed_int_part( tQ16 a ) { return a.intPart(); }
+int manual_int_part( int a ) { return a >> 16; }
+
+tFixedQuantity< tUnitVolts, 12 > fixed_units( tFixedQuantity< tUnitOhms, 16 > r, tFixedQuantity< tUnitAmps, 12 > a, tFixedQuantity< tUnitAmps, 12 > b )
+    { return r.multipliedBy( a + b ).roundedTo< tFixedQuantity< tUnitVolts, 12 > >(); }
+int manual_units( int r, int a, int b ) { return int( ((long long)( r ) * (a + b) + (1 << 15)) >> 16 ); }
+
+tQ16 fixed_from_double( double a ) { return tQ16( a ); }
+int manual_from_double( double a ) { double v = a * 65536 + 0.5; int i = int( v ); return (double( i ) > v)? i - 1 : i; }
+
+double fixed_to_double( tQ16 a ) { return a.toDouble(); }
+double manual_to_double( int a ) { return double( a ) / 65536; }
+
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Compiles FixedPoint_codegen.cpp to assembly and checks that each "fixed_xxx" function has no more
+# instructions than its "manual_xxx" counterpart, exiting with a non-zero status if any do. Any
+# arguments are passed to the compiler, and the compiler can be set with CXX. eg.
+#
+#   ./FixedPoint_codegen.sh
+#   CXX=arm-none-eabi-g++ ./FixedPoint_codegen.sh -mcpu=cortex-m4 -mthumb -mfloat-abi=hard
+
+CXX=${CXX:-g++}
+SOURCE="$(dirname "$0")/FixedPoint_codegen.cpp"
+ASM=$(mktemp) || exit 1
+trap 'rm -f "$ASM"' EXIT
+
+"$CXX" -std=c++11 -O2 -fno-asynchronous-unwind-tables "$@" -S -o "$ASM" "$SOURCE" || exit 1
+
+# counts the instructions between a function's label and its .size directive, printing "missing"
+# if the function isn't in the assembly (eg. because it was compiled out)
+count() {
+    awk -v name="$1" '
+        $0 == name ":"              { found = 1; inside = 1; next }
+        inside && /^[ \t]*\.size/   { inside = 0 }
+        inside && /^[ \t]+[a-z]/    { n++ }
+        END                         { if (found) print n + 0; else print "missing" }' "$ASM"
+}
+
+status=0
+for op in $(sed -n 's/.* fixed_\([a-z0-9_]*\)(.*/\1/p' "$SOURCE"); do
+    fixed=$(count "fixed_$op")
+    manual=$(count "manual_$op")
+    if [ "$fixed" = "missing" ] || [ "$manual" = "missing" ] || [ "$fixed" -gt "$manual" ]; then
+        result="FAIL"
+        status=1
+    else
+        result="ok"
+    fi
+    printf '%-16s fixed %3s  manual %3s  %s\n' "$op" "$fixed" "$manual" "$result"
+done
+exit $status
@@ -1,6 +1,9 @@
-//TODO: turn this into a proper unit test
-
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
 #include "../include/FixedPoint.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
 
 typedef tFixedPoint< 4 >   tQ4;
 typedef tFixedPoint< 8 >   tQ8;
@@ -24,7 +27,24 @@ typedef tFixedPoint< 36, unsigned long long >  tBigQ36;
 
 #define Q8CONST( dec,frac )  FIXEDPOINT_CONSTANT( tQ8, dec,frac )
 
-int main()
+FIXEDPOINT_DEFINE_LITERAL( _bq36, tBigQ36 )
+
+constexpr tQ8 cConstants[] = { 1.25_q8, -2.3_q8, 3_q8, Q8CONST( -2,3 ), tQ8( 2.5 ), tQ8::rounded( 3.001 ), tQ4( 1.5 ) };
+static_assert( cConstants[0].qValue() == 320, "1.25_q8" );
+static_assert( cConstants[1] == cConstants[3], "-2.3_q8" );
+static_assert( cConstants[2] == 3 && 3 == cConstants[2] && 2 < cConstants[2] && !(3 != cConstants[2]), "3_q8" );
+static_assert( cConstants[4].roundedTo< 4 >() == tQ4( 2.5 ), "constexpr conversion" );
+static_assert( (cConstants[0] * cConstants[6]).qValue() == 320*384, "constexpr multiply" );
+static_assert( (0.0000152587890625_q16).qValue() == 1 && (0.99999_q16).qValue() == 65535, "literal rounding" );
+static_assert( (1.000000000001_bq36).qValue() == (1ll << 36), "literal digits" );
+static_assert( (127.99999994_q24).qValue() == 0x7fffffff && (-127.99999994_q24).qValue() == -0x7fffffff, "literal range" );
+static_assert( !tFixedPointLiteral_::fits< 24, int32_t, '2','0','0','.','0' >() && !tFixedPointLiteral_::fits< 24, int32_t, '1','2','8' >()
+            && !tFixedPointLiteral_::fits< 24, int32_t, '1','2','7','.','9','9','9','9','9','9','9','9' >(), "literal out of range" );
+//constexpr tFixedPoint< 24 > cOutOfRange = 200.0_q24;      // error: fixed-point literal out of range
+
+/** Uses each of the operations to check that they compile. It isn't run, as the values it ends up
+    with are meaningless (and it eventually divides by zero) **/
+void compileChecks()
 {
     tQ4 a4( 1.1 );
     tQ4 b4( 1 );
@@ -104,6 +124,9 @@ int main()
 //  a8 *= 3.2;          // Warning: converting to int from double
     a8 *= a4;
     a8 *= a12;
+    a8 *= a8;
+    a8 = a8.multipliedBy( a12 ).roundedTo< 8, int >();
+    a12 = tQ16( 200 ).multipliedBy( tQ16( 100 ) ).roundedTo< tQ12 >();   // Note: product needs 48 bits
     a8 = a8 * 2;
     a8 = 3 * a8;
     a12 = a8 * a4;
@@ -114,8 +137,9 @@ int main()
     a8 /= 5l;
     a8 /= 6lu;
 //  a8 /= 3.2;          // Warning: converting to int from double
-    a8 /= a4;           // Note: possible overflow due to pre-shifting "(a8 << 4) / a4"
-//  a8 /= a12;          // Warning: left shift count is negative
+    a8 /= a8;
+    a8 /= a4;
+    a8 /= a12;          // Note: pre-shifts "(a8 << 12) / a12" using the double-width type
     a8 = a8.increasedBy( a12 ) / a12;
     a8 = a8 / 2;
 //  a8 = 3 / a8;        // Error: no match for 'operator/'
@@ -183,3 +207,296 @@ int main()
     
     aB36 = tBigQ18( a18 ) * a18;
 }
+
+//-------------------------------------------------------------------------------------------------
+// Reference implementations, using a different method from the library where possible
+
+/** Returns the nearest integer to 'value', with halves rounded up (as FIXEDPOINT_IMPL_ROUND does) **/
+static long long nearest( double value ) { return (long long)( std::floor( value + 0.5 ) ); }
+
+/** Returns 'dividend' / 'divisor' rounded to the nearest integer, with halves rounded away from 0 **/
+static long long divided( long long dividend, long long divisor ) {
+    long long n = (dividend < 0)? -dividend : dividend;
+    long long d = (divisor < 0)? -divisor : divisor;
+    long long q = (2*n + d) / (2*d);
+    return ((dividend < 0) != (divisor < 0))? -q : q;
+}
+
+/** A small pseudo-random number generator, so that failures are repeatable **/
+static unsigned long long seed = 0x2545F4914F6CDD1Dull;
+static long long random( long long min, long long max ) {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+    return min + (long long)( seed % (unsigned long long)( max - min + 1 ) );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Exhaustive tests of small formats
+
+static void exhaustiveSigned()
+{
+    for (int a = -256; a < 256; ++a) {
+        tQ4 x = tQ4::create( a );
+
+        assert( x.toDouble() == a / 16.0 );
+        assert( tQ4( a / 16.0 ).qValue() == a );
+        assert( tQ4( (a + 0.5) / 16 ).qValue() == a + 1 );
+        assert( tQ4( (a - 0.25) / 16 ).qValue() == a );
+        assert( tQ4::truncated( (a + 0.75) / 16 ).qValue() == ((a < 0)? a + 1 : a) );
+
+        assert( (x.roundedTo< 2 >().qValue() == nearest( a / 4.0 )) );
+        assert( (x.truncatedTo< 2 >().qValue() == (long long)( std::floor( a / 4.0 ) )) );
+        assert( (x.increasedTo< 8 >().qValue() == a * 16) );
+
+        assert( x.intPart() == (long long)( std::floor( a / 16.0 ) ) );
+        assert( x.absFracPart() == ((a < 0)? -a : a) % 16 );
+        assert( x.fracPart() == a % 16 );
+
+        for (int i = -17; i <= 17; ++i) {
+            assert( (i == x) == (i*16 == a) );
+            assert( (i != x) == (i*16 != a) );
+            assert( (i <  x) == (i*16 <  a) );
+            assert( (i <= x) == (i*16 <= a) );
+            assert( (i >= x) == (i*16 >= a) );
+            assert( (i >  x) == (i*16 >  a) );
+        }
+
+        for (int b = -256; b < 256; ++b) {
+            tQ4 y = tQ4::create( b );
+
+            assert( (x + y).qValue() == a + b );
+            assert( (x - y).qValue() == a - b );
+            assert( (x * y).qValue() == a * b );
+
+            tQ4 p = x;
+            p *= y;
+            assert( p.qValue() == nearest( a * b / 16.0 ) );
+
+            if (b != 0) {
+                tQ4 q = x;
+                q /= y;
+                assert( q.qValue() == divided( a * 16, b ) );
+                assert( x / y == divided( a, b ) );
+            }
+
+            assert( (x == y) == (a == b) );
+            assert( (x != y) == (a != b) );
+            assert( (x <  y) == (a <  b) );
+            assert( (x <= y) == (a <= b) );
+            assert( (x >= y) == (a >= b) );
+            assert( (x >  y) == (a >  b) );
+        }
+    }
+}
+
+static void exhaustiveUnsigned()
+{
+    typedef tFixedPoint< 4, unsigned >  tUQ4;
+
+    for (unsigned a = 0; a < 512; ++a) {
+        tUQ4 x = tUQ4::create( a );
+
+        assert( x.toDouble() == a / 16.0 );
+        assert( tUQ4( (a + 0.5) / 16 ).qValue() == a + 1 );
+        assert( (x.roundedTo< 2 >().qValue() == (a + 2) / 4) );
+        assert( x.intPart() == a / 16 && x.fracPart() == a % 16 );
+
+        for (unsigned b = 0; b < 512; ++b) {
+            tUQ4 y = tUQ4::create( b );
+
+            assert( (x + y).qValue() == a + b );
+            if (a >= b) assert( (x - y).qValue() == a - b );
+
+            tUQ4 p = x;
+            p *= y;
+            assert( p.qValue() == (a*b + 8) / 16 );
+
+            if (b != 0) {
+                tUQ4 q = x;
+                q /= y;
+                assert( q.qValue() == (2*a*16 + b) / (2*b) );
+            }
+
+            assert( (x < y) == (a < b) && (x >= y) == (a >= b) );
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Randomised tests against a double reference
+
+static void randomised()
+{
+    typedef tFixedPoint< 16, unsigned >  tUQ16;
+    typedef tFixedPoint< 32, long long >  tBigQ32;
+
+    for (int i = 0; i < 100000; ++i) {
+        // int, with values of up to +-16 so the products fit
+        int a = int( random( -(1 << 20), 1 << 20 ) );
+        int b = int( random( -(1 << 20), 1 << 20 ) );
+        tQ16 x = tQ16::create( a ), y = tQ16::create( b );
+        double da = x.toDouble(), db = y.toDouble();
+
+        assert( (x + y).toDouble() == da + db );
+        assert( (x - y).toDouble() == da - db );
+        tQ16 p = x;
+        p *= y;
+        assert( p.qValue() == nearest( da * db * 65536 ) );
+        if (b >= (1 << 12) || b <= -(1 << 12)) {
+            tQ16 q = x;
+            q /= y;
+            assert( q.qValue() == divided( a * 65536ll, b ) );
+            assert( std::fabs( q.toDouble() - da / db ) <= 0.5 / 65536 );
+        }
+        assert( (x < y) == (da < db) && (x <= y) == (da <= db) );
+        assert( (x.roundedTo< 8 >().toDouble() == nearest( da * 256 ) / 256.0) );
+
+        double d = random( -(1ll << 40), 1ll << 40 ) / double( 1 << 30 );
+        assert( tQ16( d ).qValue() == nearest( d * 65536 ) );
+        assert( tQ16::truncated( d ).qValue() == (long long)( d * 65536 ) );
+        tQ16 m = x;
+        m *= d / 1024;
+        assert( m.qValue() == nearest( a * (d / 1024) ) );
+
+        // long long, the products are kept within 64 bits as there is no wider type
+        long long c = random( -(1ll << 31), 1ll << 31 );
+        long long e = random( -(1ll << 31), 1ll << 31 );
+        tBigQ32 u = tBigQ32::create( c ), v = tBigQ32::create( e );
+        assert( (u + v).qValue() == c + e );
+        tBigQ32 w = u;
+        w *= v;
+        assert( std::fabs( w.toDouble() - u.toDouble() * v.toDouble() ) <= 0.5000001 / 4294967296.0 );
+        assert( (u > v) == (c > e) );
+
+        // unsigned
+        unsigned f = unsigned( random( 0, 1 << 20 ) );
+        unsigned g = unsigned( random( 1 << 12, 1 << 20 ) );
+        tUQ16 r = tUQ16::create( f ), s = tUQ16::create( g );
+        assert( (r + s).qValue() == f + g );
+        tUQ16 t = r;
+        t *= s;
+        assert( t.qValue() == (unsigned long long)( nearest( r.toDouble() * s.toDouble() * 65536 ) ) );
+        t = r;
+        t /= s;
+        assert( t.qValue() == (unsigned long long)( divided( f * 65536ll, g ) ) );
+        assert( (r <= s) == (f <= g) );
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Edge cases
+
+static void edgeCases()
+{
+    // the integer part rounds down, the fractional part has the sign of the value
+    tQ8 n8( -1.25 );
+    assert( n8.intPart() == -2 && n8.fracPart() == -64 && n8.absFracPart() == 64 );
+    assert( tQ8( -0.25 ).intPart() == -1 && tQ8( -0.25 ).fracPart() == -64 );
+    assert( tQ8( 1.25 ).intPart() == 1 && tQ8( 1.25 ).fracPart() == 64 );
+    assert( tBigQ36( -1.5 ).fracPart() == -(1ll << 35) );
+
+    // halves are rounded up, including -0.5
+    assert( FIXEDPOINT_IMPL_ROUND( -8, 4 ) == 0 && FIXEDPOINT_IMPL_ROUND( 8, 4 ) == 1 && FIXEDPOINT_IMPL_ROUND( -24, 4 ) == -1 );
+    assert( tQ8( -0.5 ).roundedTo< 0 >().qValue() == 0 );
+    assert( tQ8( -1.5 ).roundedTo< 0 >().qValue() == -1 );
+    assert( tQ8( -0.5/256 ).qValue() == 0 && tQ8( -1.5/256 ).qValue() == -1 );
+    assert( tQ8::rounded( -1.3/256 ).qValue() == -1 && tQ8::rounded( -0.7/256 ).qValue() == -1 );
+    tQ8 h8 = tQ8::create( -1 );
+    h8 *= tQ8( 0.5 );
+    assert( h8.qValue() == 0 );
+
+    // division rounds halves away from 0, whatever the signs
+    assert( (tQ8::create( -5 ) / 2).qValue() == -3 && (tQ8::create( 5 ) / -2).qValue() == -3 );
+    assert( (tQ8::create( -5 ) / -2).qValue() == 3 && (tQ8::create( 5 ) / 2).qValue() == 3 );
+    assert( (tQ8::create( -7 ) / 3).qValue() == -2 && (tQ8::create( -8 ) / 3).qValue() == -3 );
+
+    // an integer on the left of a comparison
+    assert( !(3 < tQ8( 3 )) &&  (3 <= tQ8( 3 )) &&  (3 >= tQ8( 3 )) && !(3 > tQ8( 3 )) );
+    assert(  (2 < tQ8( 3 )) &&  (2 <= tQ8( 3 )) && !(2 >= tQ8( 3 )) && !(2 > tQ8( 3 )) );
+    assert( !(4 < tQ8( 3 )) && !(4 <= tQ8( 3 )) &&  (4 >= tQ8( 3 )) &&  (4 > tQ8( 3 )) );
+    assert( (3 == tQ8( 3 )) && (3 != tQ8( 3.5 )) );
+}
+
+//-------------------------------------------------------------------------------------------------
+// Float Conversions
+
+/** The float nearest to 'raw' * 2^-qBits, and a float * 2^qBits truncated and saturated **/
+static float expectedFloat( long long raw, int qBits ) { return float( std::ldexp( double( raw ), -qBits ) ); }
+template< typename DataType > static DataType expectedFixed( float value, int qBits ) {
+    if (value != value) return 0;
+    const double scaled = std::trunc( std::ldexp( double( value ), qBits ) );
+    if (scaled >= double( std::numeric_limits<DataType>::max() )) return std::numeric_limits<DataType>::max();
+    if (scaled <= double( std::numeric_limits<DataType>::min() )) return std::numeric_limits<DataType>::min();
+    return DataType( scaled );
+}
+
+/** Checks both the conversions used for this target and the integer-only ones on the bits **/
+template< int QBits, typename DataType > static void checkFloat( DataType raw, float value ) {
+    typedef tFixedPoint< QBits, DataType > tFP;
+    const bool negative = raw < 0;
+    const unsigned long long magnitude = negative? 0ull - (unsigned long long)( raw ) : (unsigned long long)( raw );
+    assert( tFP::create( raw ).toFloat() == expectedFloat( raw, QBits ) );
+    assert( tFixedPointFloat_::toFloat( magnitude, negative, QBits ) == expectedFloat( raw, QBits ) );
+    assert( tFP::fromFloat( value ).qValue() == expectedFixed<DataType>( value, QBits ) );
+    assert( tFixedPointFloat_::fromFloat<DataType>( value, QBits ) == expectedFixed<DataType>( value, QBits ) );
+}
+
+static void floats()
+{
+    for (int i = 0; i < 100000; ++i) {
+        const int exponent = int( random( -30, 40 ) );
+        const float value = float( std::ldexp( double( random( -(1ll << 30), 1ll << 30 ) ), exponent - 30 ) );
+        checkFloat< 16 >( int( random( -(1ll << 31), (1ll << 31) - 1 ) ), value );
+        checkFloat< 31 >( int( random( -(1ll << 31), (1ll << 31) - 1 ) ), value );
+        checkFloat< 0 >( int( random( -(1 << 24), 1 << 24 ) ), value );
+        checkFloat< 12, short >( short( random( -32768, 32767 ) ), value );
+        checkFloat< 20, unsigned >( unsigned( random( 0, (1ll << 32) - 1 ) ), value );
+        checkFloat< 36, long long >( random( -(1ll << 52), 1ll << 52 ), value );
+    }
+
+    // odd halves round to even, and the rounding can carry into the exponent
+    assert( tQ16::create( (1 << 24) + 1 ).toFloat() == 256.0f && tQ16::create( (1 << 24) + 3 ).toFloat() == 256.0f + 4/65536.0f );
+    assert( tQ16::create( 0x7FFFFFFF ).toFloat() == 32768.0f && tQ16::create( int( 0x80000000 ) ).toFloat() == -32768.0f );
+    assert( tQ16::create( 0 ).toFloat() == 0.0f && tQ16::create( -1 ).toFloat() == -1/65536.0f );
+
+    // truncation towards 0, saturation, NaN and negatives for unsigned data-types
+    const float inf = std::numeric_limits<float>::infinity();
+    assert( tQ16::fromFloat( 1.99999f ).qValue() == 131071 && tQ16::fromFloat( -1.99999f ).qValue() == -131071 );
+    assert( tQ16::fromFloat( 32768.0f ).qValue() == 0x7FFFFFFF && tQ16::fromFloat( -32768.0f ).qValue() == int( 0x80000000 ) );
+    assert( tQ16::fromFloat( inf ).qValue() == 0x7FFFFFFF && tQ16::fromFloat( -inf ).qValue() == int( 0x80000000 ) );
+    assert( tQ16::fromFloat( std::numeric_limits<float>::quiet_NaN() ).qValue() == 0 );
+    assert( tQ16::fromFloat( 1e-30f ).qValue() == 0 && tQ16::fromFloat( -1e-30f ).qValue() == 0 );
+    assert( (tFixedPoint< 8, unsigned >::fromFloat( -1.0f ).qValue() == 0) && (tFixedPoint< 8, unsigned >::fromFloat( 1e20f ).qValue() == 0xFFFFFFFFu) );
+    assert( (tFixedPoint< 8, short >::fromFloat( 200.0f ).qValue() == 32767) && (tFixedPoint< 8, short >::fromFloat( -200.0f ).qValue() == -32768) );
+    assert( tQ16::fromFloat( tQ16( 3.25 ).toFloat() ) == tQ16( 3.25 ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+// Layout
+
+static_assert( std::is_trivially_copyable< tQ16 >::value && std::is_standard_layout< tQ16 >::value, "tQ16 should be trivially copyable" );
+static_assert( sizeof(tFixedPoint< 15, short >) == sizeof(short) && alignof(tBigQ36) == alignof(long long), "tFixedPoint should have the layout of its data-type" );
+
+static void layout()
+{
+    // an array of tFixedPoint is an array of its qValues, so it can be copied as raw memory
+    int raw[4] = { 1, -2, 3 << 16, -(4 << 16) };
+    tQ16 values[4];
+    std::memcpy( values, raw, sizeof(raw) );
+    assert( values[0].qValue() == 1 && values[1].qValue() == -2 && values[2] == tQ16( 3 ) && values[3] == tQ16( -4 ) );
+    tQ16 copies[4];
+    std::memcpy( copies, values, sizeof(values) );
+    assert( copies[3] == tQ16( -4 ) );
+}
+
+int main()
+{
+    exhaustiveSigned();
+    exhaustiveUnsigned();
+    randomised();
+    edgeCases();
+    floats();
+    layout();
+}
@@ -0,0 +1,136 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedSimulation.h"
+#include "../include/PIController.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef tFixedPoint< 12 > tQ12;
+typedef tFixedPoint< 12, short > tQ12s;
+typedef tFixedPoint< 16 > tQ16;
+
+/** A current loop, run over channel 0 of the input (the measured current) **/
+struct tCurrentLoop
+{
+    tCurrentLoop( tQ16 kp, tQ16 ki ) : pi( kp, ki, -tQ12( 150 ), tQ12( 150 ) ), blocks( 0 ) {}
+
+    void run( const tFixedTrace& in, unsigned first, unsigned count, tFixedTrace& out ) {
+        tQ12s id[FIXEDPOINT_SIMULATION_BLOCK];
+        assert( in.samples( 0, first, id, count ) == count );
+        for (unsigned i = 0; i < count; ++i) out.record( 0, pi.update( tQ12( 10 ) - id[i] ) );
+        ++blocks;
+    }
+
+    tPIController< 16, 12 >  pi;
+    unsigned                 blocks;
+};
+
+static std::string gReport;
+static void report( const char* text ) { gReport += text; }
+
+int main() {
+    // a log as the target would write it, of a current (12 bits) and a speed (deltas)
+    typedef tFixedTelemetryChannel< tQ12s, 12 > tCurrentChannel;
+    typedef tFixedTelemetryChannel< tQ16, 10, true > tSpeedChannel;
+    const unsigned cFrames = 10000;
+    static unsigned char log[cFrames*4 + 16];
+    tFixedTelemetryWriter out( log, sizeof(log) );
+    tCurrentChannel::header().write( out );
+    tSpeedChannel::header().write( out );
+    tCurrentChannel current;
+    tSpeedChannel speed;
+    short currents[cFrames];
+    int s = 0;
+    for (unsigned i = 0; i < cFrames; ++i) {
+        currents[i] = short( rand() % 4096 - 2048 );
+        s += rand() % 1000 - 500;
+        current.write( out, tQ12s::create( currents[i] ) );
+        speed.write( out, tQ16::create( s ) );
+    }
+    out.flush();
+
+    // which can be decoded, read as other types, and encoded back to the same bytes
+    tFixedTrace recorded;
+    assert( recorded.decode( log, out.size(), 2, cFrames ) );
+    assert( recorded.channels() == 2 && recorded.frames() == cFrames && recorded.size( 1 ) == cFrames );
+    assert( recorded.header( 0 ) == tCurrentChannel::header() && recorded.header( 1 ) == tSpeedChannel::header() );
+    assert( recorded.raw( 0, 17 ) == currents[17] && recorded.raw( 1, cFrames - 1 ) == s );
+    assert( recorded.sample< tQ12s >( 0, 5 ).qValue() == currents[5] );
+    assert( recorded.sample< tFixedPoint< 15 > >( 0, 5 ).qValue() == currents[5]*8 );
+    assert( recorded.sample< tFixedPoint< 10 > >( 0, 5 ).qValue() == (currents[5] + 2) >> 2 );
+    static unsigned char encoded[sizeof(log)];
+    assert( recorded.encode( encoded, sizeof(encoded) ) == out.size() && memcmp( encoded, log, out.size() ) == 0 );
+    assert( recorded.encode( encoded, 100 ) == 0 );
+    assert( !tFixedTrace().decode( log, 5, 2, 0 ) );
+    assert( !tFixedTrace().decode( log, out.size(), 2, cFrames + 1 ) );
+
+    // narrow channels round trip without the padding at the end being taken for another frame
+    tFixedTrace narrow;
+    narrow.addChannel( tFixedTelemetryChannel< tQ12s, 3 >::header() );
+    narrow.addChannel( tFixedTelemetryChannel< tQ12s, 2 >::header() );
+    for (unsigned i = 0; i < 7; ++i) {
+        narrow.appendRaw( 0, int( i ) - 4 );
+        narrow.appendRaw( 1, int( i % 4 ) - 2 );
+    }
+    unsigned char narrowLog[16];
+    const unsigned narrowSize = narrow.encode( narrowLog, sizeof(narrowLog) );
+    assert( narrowSize == 8 + 5 );                              // 35 bits of frames, and 5 of padding
+    tFixedTrace narrowDecoded;
+    assert( narrowDecoded.decode( narrowLog, narrowSize, 2, narrow.frames() ) );
+    assert( narrowDecoded.frames() == 7 && narrowDecoded.size( 1 ) == 7 );
+    for (unsigned i = 0; i < 7; ++i)
+        assert( narrowDecoded.raw( 0, i ) == narrow.raw( 0, i ) && narrowDecoded.raw( 1, i ) == narrow.raw( 1, i ) );
+    unsigned char narrowEncoded[16];
+    assert( narrowDecoded.encode( narrowEncoded, sizeof(narrowEncoded) ) == narrowSize && memcmp( narrowEncoded, narrowLog, narrowSize ) == 0 );
+    tQ12s block[8];
+    assert( recorded.samples( 0, cFrames - 3, block, 8 ) == 3 && block[2].qValue() == currents[cFrames - 1] );
+
+    // a parameter sweep runs in parallel, and gives the same results as running each one alone
+    const unsigned cRuns = 6;
+    tFixedTrace results[cRuns];
+    unsigned blocks[cRuns];
+    fixedRunParallel( cRuns, [&]( unsigned i ) {
+        tCurrentLoop loop( tQ16( 0.1 + 0.2*i ), tQ16( 0.01 ) );
+        results[i].addChannel< tQ12 >();
+        fixedSimulate( recorded, loop, results[i] );
+        blocks[i] = loop.blocks;
+    } );
+    for (unsigned i = 0; i < cRuns; ++i) {
+        tCurrentLoop loop( tQ16( 0.1 + 0.2*i ), tQ16( 0.01 ) );
+        tFixedTrace expected;
+        expected.addChannel< tQ12 >();
+        for (unsigned f = 0; f < cFrames; ++f) expected.record( 0, loop.pi.update( tQ12( 10 ) - recorded.sample< tQ12s >( 0, f ) ) );
+        assert( blocks[i] == (cFrames + FIXEDPOINT_SIMULATION_BLOCK - 1)/FIXEDPOINT_SIMULATION_BLOCK );
+        assert( results[i].frames() == cFrames && fixedCompare( expected, results[i] ).identical() );
+    }
+    assert( !fixedCompare( results[0], results[1] ).identical() );
+
+    // comparisons report the first difference
+    tFixedTrace a, b;
+    a.addChannel< tQ12 >();
+    b.addChannel< tQ12 >();
+    for (int i = 0; i < 100; ++i) {
+        a.record( 0, tQ12::create( i ) );
+        b.record( 0, tQ12::create( (i == 40 || i == 70)? i + 3 : i ) );
+    }
+    fixedCompare( a, a ).write( report );
+    assert( gReport == "identical, 1 channels of 100 samples\n" );
+    tFixedTraceComparison c = fixedCompare( a, b );
+    assert( c.mismatches == 2 && c.firstFrame == 40 && c.expected == 40 && c.actual == 43 && c.maxDifference == 3 );
+    gReport.clear();
+    c.write( report );
+    assert( gReport == "2 samples differ in 1 channels of 100 samples, first at channel 0 sample 40 (expected 40, got 43), max difference 3\n" );
+    b.appendRaw( 0, 5 );
+    assert( !fixedCompare( a, b ).sizesMatch && fixedCompare( a, b ).mismatches == 2 );
+    b.clear();
+    assert( b.channels() == 1 && b.frames() == 0 && !fixedCompare( a, b ).identical() );
+    b.addChannel< tQ16 >();
+    assert( !fixedCompare( a, b ).formatsMatch );
+
+    // serial runs
+    unsigned order[4], n = 0;
+    fixedRunParallel( 4, [&]( unsigned i ) { order[n++] = i; }, 1 );
+    assert( n == 4 && order[0] == 0 && order[3] == 3 );
+    return 0;
+}
@@ -0,0 +1,91 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedUnits.h"
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+typedef tFixedQuantity< tUnitAmps, 12 >              tCurrent;
+typedef tFixedQuantity< tUnitVolts, 12 >             tVoltage;
+typedef tFixedQuantity< tUnitOhms, 16 >              tResistance;
+typedef tFixedQuantity< tUnitSeconds, 24 >           tTime;
+typedef tFixedQuantity< tUnitRadiansPerSecond, 8 >   tSpeed;
+typedef tFixedQuantity< tUnitHertz, 8 >              tFrequency;
+
+/** Detects whether two quantities can be added, or one assigned from the other **/
+template< typename A, typename B, typename = void > struct tCanAdd : std::false_type {};
+template< typename A, typename B > struct tCanAdd< A, B, decltype( void( std::declval<A>() + std::declval<B>() ) ) > : std::true_type {};
+
+static_assert( tCanAdd< tCurrent, tCurrent >::value && tCanAdd< tCurrent, tFixedQuantity< tUnitAmps, 8 > >::value, "same units add" );
+static_assert( !tCanAdd< tCurrent, tVoltage >::value && !tCanAdd< tSpeed, tFrequency >::value, "different units don't add" );
+static_assert( !tCanAdd< tCurrent, tFixedPoint< 12 > >::value, "a quantity and a unitless value don't add" );
+static_assert( std::is_convertible< tFixedQuantity< tUnitAmps, 8 >, tCurrent >::value, "same unit converts" );
+static_assert( !std::is_convertible< tVoltage, tCurrent >::value && !std::is_convertible< tFixedPoint< 12 >, tCurrent >::value, "different unit doesn't convert" );
+
+// units propagate through "*" and "/"
+static_assert( std::is_same< tFixedUnitProduct< tUnitOhms, tUnitAmps >::type, tUnitVolts >::value, "ohms times amps" );
+static_assert( std::is_same< tFixedUnitQuotient< tUnitWebers, tUnitAmps >::type, tUnitHenries >::value, "webers per amp" );
+static_assert( std::is_same< tFixedUnitProduct< tUnitNewtonMetres, tUnitRadiansPerSecond >::type, tUnitWatts >::value, "torque times speed" );
+static_assert( std::is_same< decltype( tResistance() * tCurrent() ), tFixedQuantity< tUnitVolts, 28 > >::value, "product type" );
+static_assert( std::is_same< decltype( tVoltage().multipliedBy( tCurrent() ) ), tFixedQuantity< tUnitWatts, 24, long long > >::value, "wide product type" );
+static_assert( std::is_same< decltype( tVoltage() / tTime() ), tFixedQuantity< tFixedUnit< 0, 1, -1, 0 >, -12 > >::value, "quotient type" );
+
+// no run-time cost
+static_assert( sizeof(tCurrent) == sizeof(int) && std::is_trivially_copyable< tCurrent >::value && std::is_standard_layout< tCurrent >::value, "layout" );
+static_assert( (tCurrent( 3 ) + tCurrent( 2 )).qValue() == 5 << 12, "constexpr" );
+static_assert( (tResistance::create( 1 << 15 ) * tCurrent( 4 )).roundedTo< tVoltage >() == tVoltage( 2 ), "constexpr product" );
+
+int main()
+{
+    tCurrent ia( 2.5 ), ib( -1.25 );
+    tResistance rs( 0.125 );
+
+    // same units add and compare, with the precision of the left hand side
+    tCurrent sum = ia + ib;
+    assert( sum.qValue() == (125 << 12) / 100 && sum == tCurrent( 1.25 ) );
+    assert( (ia - ib) == tCurrent( 3.75 ) && -ib == tCurrent( 1.25 ) );
+    assert( ia > ib && ib < ia && ia >= ia && ia <= ia && ia != ib );
+    tFixedQuantity< tUnitAmps, 8 > coarse( 1.5 );
+    assert( (ia + coarse) == tCurrent( 4 ) && ia > coarse );
+    sum += coarse;
+    sum -= ia;
+    assert( sum == tCurrent( 0.25 ) );
+    tCurrent fine = coarse;
+    assert( fine == coarse );
+
+    // ohms times amps is volts, rounded to the destination with its unit checked
+    tVoltage drop = rs.multipliedBy( ia ).roundedTo< tVoltage >();
+    assert( drop == tVoltage( 0.3125 ) );
+    assert(( (rs * ia).roundedTo< 12 >() == drop && (rs * ia).truncatedTo< 12, short >().qValue() == drop.qValue() ));
+    assert(( drop.increasedTo< 16 >().qValue() == drop.qValue() << 4 && drop.increasedTo< tFixedQuantity< tUnitVolts, 20 > >() == drop ));
+
+    // volts per amp is ohms
+    auto r = drop.increasedBy( ia ) / ia;
+    static_assert( std::is_same< decltype( r ), tFixedQuantity< tUnitOhms, 12 > >::value, "quotient" );
+    assert(( r == tFixedQuantity< tUnitOhms, 12 >( 0.125 ) ));
+
+    // unitless values and integers scale without changing the unit
+    const tFixedPoint< 15 > half( 0.5 );
+    assert( (ia * half).roundedTo< 12 >() == tCurrent( 1.25 ) && (half * ia).roundedTo< 12 >() == tCurrent( 1.25 ) );
+    assert( ia.multipliedBy( half ).roundedTo< tCurrent >() == tCurrent( 1.25 ) );
+    assert( ia * 2 == tCurrent( 5 ) && 2 * ia == tCurrent( 5 ) && ia / 2 == tCurrent( 1.25 ) );
+    assert( (ia / tFixedPoint< 4 >( 2 )).increasedTo< 12 >() == tCurrent( 1.25 ) );
+    tCurrent scaled = ia;
+    scaled *= half;
+    scaled *= 4;
+    scaled /= 2;
+    scaled /= tFixedPoint< 8 >( 0.5 );
+    assert( scaled == tCurrent( 5 ) );
+
+    // the value without its unit, and the other constructions
+    assert( ia.value() == tFixedPoint< 12 >( 2.5 ) && tCurrent::create( 5 << 11 ) == ia );
+    assert( fixedQuantity< tUnitAmps >( 2.5_q12 ) == ia && tCurrent( tFixedPoint< 12 >( 2.5 ) ) == ia );
+    assert( ia.toDouble() == 2.5 && ia.toFloat() == 2.5f && tCurrent::fromFloat( 2.5f ) == ia );
+
+    // a torque times a speed is a power
+    tFixedQuantity< tUnitNewtonMetres, 8 > torque( 10 );
+    tSpeed w( 100 );
+    tFixedQuantity< tUnitWatts, 0 > power = (torque * w).roundedTo< 0 >();
+    assert(( power == tFixedQuantity< tUnitWatts, 0 >( 1000 ) ));
+
+    return 0;
+}
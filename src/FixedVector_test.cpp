@@ -0,0 +1,93 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FixedVector.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <type_traits>
+
+typedef tFixedPoint< 12 > tQ12;
+typedef tFixedPoint< 15 > tQ15;
+typedef tFixedPoint< 15, short > tQ15s;
+typedef tFixedVec2< 12 > tVec12;
+typedef tFixedVec2< 15, short > tVec15s;
+typedef tFixedComplex< 15, short > tComplex15s;
+
+static_assert( sizeof(tVec15s) == 4 && sizeof(tComplex15s) == 4, "both halves of a Q15 pair fit in a word" );
+static_assert( std::is_trivially_copyable< tVec12 >::value && std::is_standard_layout< tComplex15s >::value, "pairs can be copied as raw data" );
+
+int main() {
+    // componentwise operations, and conversion to and from the FOC pairs
+    tVec12 a( tQ12( 3 ), tQ12( 4 ) ), b( tQ12( -1 ), tQ12( 0.5 ) );
+    assert( a + b == tVec12( tQ12( 2 ), tQ12( 4.5 ) ) && a - b == tVec12( tQ12( 4 ), tQ12( 3.5 ) ) && -b == tVec12( tQ12( 1 ), tQ12( -0.5 ) ) );
+    b += a;
+    b -= a;
+    assert( b == tVec12( tQ12( -1 ), tQ12( 0.5 ) ) && b != a );
+    tAlphaBeta< 12 > ab = a.alphaBeta();
+    tDq< 12 > dq = b.dq();
+    assert( ab.alpha == tQ12( 3 ) && dq.q == tQ12( 0.5 ) && tVec12( ab ) == a && tVec12( dq ) == b );
+
+    // full-precision products
+    assert(( std::is_same< decltype( a.dot( b ) ), tFixedPoint< 24, long long > >::value ));
+    assert(( a.dot( b ) == tFixedPoint< 24, long long >( -1ll ) && a.cross( b ) == tFixedPoint< 24, long long >( 5.5 ) ));
+    assert( a.scaled< 12 >( tQ15( 0.5 ) ) == tVec12( tQ12( 1.5 ), tQ12( 2 ) ) );
+    assert(( a.scaled< 12, short >( tQ15( 4 ) ).x.qValue() == 32767 ));
+
+    // magnitudes
+    assert( a.magnitude< 12 >() == tQ12( 5 ) && a.magnitude< 20 >() == tFixedPoint< 20 >( 5 ) );
+    assert( tVec12().magnitude< 12 >() == tQ12( 0 ) );
+    for (int i = 0; i < 1000; ++i) {
+        const tVec12 v( tQ12::create( rand() % 2000000 - 1000000 ), tQ12::create( rand() % 2000000 - 1000000 ) );
+        const double exact = sqrt( double( v.x.qValue() )*v.x.qValue() + double( v.y.qValue() )*v.y.qValue() );
+        assert( fabs( v.magnitude< 12 >().qValue() - exact ) <= 0.501 );
+        assert( fabs( v.magnitude< 16 >().qValue() - exact*16 ) <= 0.501 );
+        assert( fabs( v.approxMagnitude< 12 >().qValue() - exact ) <= exact*0.0398 + 1 );
+
+        // limiting keeps the direction, and doesn't go over the limit
+        const tVec12 l = v.limited( tQ12( 100 ) );
+        const double m = sqrt( double( l.x.qValue() )*l.x.qValue() + double( l.y.qValue() )*l.y.qValue() );
+        if (exact <= tQ12( 100 ).qValue()) assert( l == v );
+        else assert( m <= tQ12( 100 ).qValue() && m > tQ12( 100 ).qValue() - 2 && fabs( l.cross( v ).qValue() ) < 2*exact + 1 );
+    }
+    assert(( tFixedVec2< 0 >( tFixedPoint< 0 >::create( -2147483647 - 1 ), tFixedPoint< 0 >::create( -2147483647 - 1 ) ).magnitude< 0, unsigned >().qValue() == 3037000500u ));
+    assert( a.limited( -tQ12( 1 ) ) == tVec12() && a.limited( tQ12( 5 ) ) == a );
+
+    // rotation by a tSinCos or an angle
+    const tFixedAngle<> quarter = tFixedAngle<>::create( 1u << 30 );
+    assert( a.rotated< 12 >( sincos< 15 >( quarter ) ) == tVec12( tQ12( -4 ), tQ12( 3 ) ) );
+    assert( a.rotated< 12 >( quarter * 2 ) == -a );
+    const tVec12 r = a.rotated< 12 >( sincos< 30 >( tQ12( 0.5 ) ) );
+    assert( fabs( r.x.toDouble() - (3*cos( 0.5 ) - 4*sin( 0.5 )) ) < 1.0/4096 && fabs( r.y.toDouble() - (3*sin( 0.5 ) + 4*cos( 0.5 )) ) < 1.0/4096 );
+    tVec15s s( tQ15s( 0.5 ), tQ15s( -0.25 ) );
+    assert( s.rotated< 15 >( sincos< 15, short >( quarter ) ) == tVec15s( tQ15s( 0.25 ), tQ15s( 0.5 ) ) );
+
+    // complex products, rounded once
+    tComplex15s z( tQ15s( 0.5 ), tQ15s( 0.25 ) ), w( tQ15s( -0.5 ), tQ15s( 0.75 ) );
+    assert(( std::is_same< decltype( z * w ), tFixedComplex< 30, long long > >::value ));
+    assert(( z * w == tFixedComplex< 30, long long >( tFixedPoint< 30, long long >( -0.4375 ), tFixedPoint< 30, long long >( 0.25 ) ) ));
+    assert( z.multiplied< 15 >( w ) == tComplex15s( tQ15s( -0.4375 ), tQ15s( 0.25 ) ) );
+    assert(( z.multiplied< 15 >( z.conj() ) == tComplex15s( tQ15s( 0.3125 ) ) && z.norm() == tFixedPoint< 30, long long >( 0.3125 ) ));
+    z *= w;
+    assert( z == tComplex15s( tQ15s( -0.4375 ), tQ15s( 0.25 ) ) );
+    z = tComplex15s( tQ15s( 0.6 ), tQ15s( -0.8 ) );
+    assert( z.abs< 15 >().qValue() >= 32766 && z.approxAbs< 14 >().qValue() < 16384*1.04 );
+    assert( z.limited( tQ15s( 0.5 ) ).abs< 15 >().qValue() <= 16384 && !(z + z == tComplex15s( tQ15s( 0.2 ) )) );
+    assert( z - z == -(z - z) && z.vec() == tVec15s( z.re, z.im ) );
+
+    // a rotation is a product with the unit complex number of the angle
+    const tComplex15s unit = tComplex15s::fromAngle( quarter );
+    assert( unit == tComplex15s( tQ15s::create( 0 ), tQ15s::create( 32767 ) ) && tComplex15s::fromSinCos( sincos< 30 >( quarter ) ) == unit );
+    assert( tComplex15s( s ).multiplied< 15 >( unit ) == tComplex15s( s.rotated< 15 >( sincos< 15, short >( quarter ) ) ) );
+    for (int i = 0; i < 1000; ++i) {
+        const tComplex15s p( tQ15s::create( short( rand() ) ), tQ15s::create( short( rand() ) ) );
+        const tComplex15s q( tQ15s::create( short( rand() ) ), tQ15s::create( short( rand() ) ) );
+        const long long re = (long long)( p.re.qValue() )*q.re.qValue() - (long long)( p.im.qValue() )*q.im.qValue();
+        const long long im = (long long)( p.re.qValue() )*q.im.qValue() + (long long)( p.im.qValue() )*q.re.qValue();
+        assert( (p * q).re.qValue() == re && (p * q).im.qValue() == im );
+        assert( p.vec().dot( q.vec() ).qValue() == (long long)( p.re.qValue() )*q.re.qValue() + (long long)( p.im.qValue() )*q.im.qValue() );
+    }
+
+    // 16-bit pairs pack into a word
+    assert( s.packed() == 0xE0004000u && tVec15s::unpacked( 0xE0004000u ) == s );
+    assert( tComplex15s::unpacked( w.packed() ) == w );
+    return 0;
+}
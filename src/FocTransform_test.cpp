@@ -0,0 +1,137 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/FocTransform.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 15 >  tQ15;
+typedef tFixedPoint< 16 >  tQ16;
+typedef tFixedPoint< 12, short >  tShortQ12;
+typedef tFixedPoint< 15, short >  tShortQ15;
+
+static const double cPi = 3.14159265358979323846;
+
+static bool near( double value, double expected, double lsbs, int qBits ) { return std::fabs( value - expected ) <= lsbs / (1 << qBits); }
+
+/** Returns the double version of the SVPWM duty cycle for phase voltage 'v' **/
+static double duty( double v, double va, double vb, double vc ) {
+    double offset = -(std::max( va, std::max( vb, vc ) ) + std::min( va, std::min( vb, vc ) )) / 2;
+    return std::max( 0.0, std::min( 1.0, 0.5 + v + offset ) );
+}
+
+int main()
+{
+    for (int i = 0; i < 10000; ++i) {
+        double theta = (std::rand() % 100000) * 2*cPi / 100000;
+        tSinCos< 15 > sc;
+        sc.sin = tQ15( std::sin( theta ) );
+        sc.cos = tQ15( std::cos( theta ) );
+        double s = sc.sin.toDouble(), c = sc.cos.toDouble();
+
+        tQ12 ia = tQ12::create( std::rand() % 200000 - 100000 );
+        tQ12 ib = tQ12::create( std::rand() % 200000 - 100000 );
+        double a = ia.toDouble(), b = ib.toDouble();
+        double alpha = a, beta = (a + 2*b) / std::sqrt( 3.0 );
+
+        // the separate transforms are each rounded once
+        tAlphaBeta< 12 > ab = clarke< 12 >( ia, ib );
+        assert( ab.alpha == ia && near( ab.beta.toDouble(), beta, 0.5, 12 ) );
+        tDq< 12 > dq = park< 12 >( ab, sc );
+        assert( near( dq.d.toDouble(), ab.alpha.toDouble()*c + ab.beta.toDouble()*s, 0.5, 12 ) );
+        assert( near( dq.q.toDouble(), ab.beta.toDouble()*c - ab.alpha.toDouble()*s, 0.5, 12 ) );
+
+        // the fused version is closer, the only other error is from the folded 1/sqrt(3)
+        tDq< 12 > fused = clarkePark< 12 >( ia, ib, sc );
+        assert( near( fused.d.toDouble(), alpha*c + beta*s, 0.55, 12 ) );
+        assert( near( fused.q.toDouble(), beta*c - alpha*s, 0.55, 12 ) );
+        tDq< 16 > fused16 = clarkePark< 16 >( ia, ib, sc );
+        assert( near( fused16.d.toDouble(), alpha*c + beta*s, 1, 16 ) || std::fabs( alpha*c + beta*s ) > 32767 );
+
+        tAlphaBeta< 12 > back = inversePark< 12 >( dq, sc );
+        assert( near( back.alpha.toDouble(), dq.d.toDouble()*c - dq.q.toDouble()*s, 0.5, 12 ) );
+        assert( near( back.beta.toDouble(), dq.d.toDouble()*s + dq.q.toDouble()*c, 0.5, 12 ) );
+
+        // SVPWM, with voltages up to and beyond the linear range (1/sqrt(3))
+        tDq< 12 > vdq;
+        vdq.d = tQ12::create( std::rand() % 3000 - 1500 );
+        vdq.q = tQ12::create( std::rand() % 3000 - 1500 );
+        double vd = vdq.d.toDouble(), vq = vdq.q.toDouble();
+        double valpha = vd*c - vq*s, vbeta = vd*s + vq*c;
+        double va = valpha, vb = -valpha/2 + std::sqrt( 3.0 )/2*vbeta, vc = -valpha/2 - std::sqrt( 3.0 )/2*vbeta;
+
+        tAbc< 16 > d = inverseParkSvpwm< 16 >( vdq, sc );
+        assert( near( d.a.toDouble(), duty( va, va, vb, vc ), 0.6, 16 ) );
+        assert( near( d.b.toDouble(), duty( vb, va, vb, vc ), 0.6, 16 ) );
+        assert( near( d.c.toDouble(), duty( vc, va, vb, vc ), 0.6, 16 ) );
+
+        tAlphaBeta< 12 > vab;
+        vab.alpha = tQ12( valpha );
+        vab.beta = tQ12( vbeta );
+        tAbc< 16 > d2 = svpwm< 16 >( vab );
+        double a2 = vab.alpha.toDouble(), b2 = vab.beta.toDouble();
+        double va2 = a2, vb2 = -a2/2 + std::sqrt( 3.0 )/2*b2, vc2 = -a2/2 - std::sqrt( 3.0 )/2*b2;
+        assert( near( d2.a.toDouble(), duty( va2, va2, vb2, vc2 ), 0.6, 16 ) );
+        assert( near( d2.b.toDouble(), duty( vb2, va2, vb2, vc2 ), 0.6, 16 ) );
+        assert( near( d2.c.toDouble(), duty( vc2, va2, vb2, vc2 ), 0.6, 16 ) );
+
+        // the sector is the sixth of a turn the voltage vector is in
+        double angle = std::atan2( b2, a2 );
+        if (angle < 0) angle += 2*cPi;
+        double position = angle / (cPi/3);
+        if (std::fabs( position - std::floor( position + 0.5 ) ) > 1e-3 && (a2 != 0 || b2 != 0))
+            assert( sector( vab ) == unsigned( position ) + 1 );
+    }
+
+    // a Q30 sin and cos gives the same results fused as in two steps
+    for (int i = 0; i < 2000; ++i) {
+        tSinCos< 30 > sc = sincos< 30 >( tQ16::create( std::rand() % 65536 ) );
+        double s = sc.sin.toDouble(), c = sc.cos.toDouble();
+
+        tQ12 ia = tQ12::create( std::rand() % 2000000 - 1000000 );
+        tQ12 ib = tQ12::create( std::rand() % 2000000 - 1000000 );
+        tDq< 12 > fused = clarkePark< 12 >( ia, ib, sc );
+        tDq< 12 > twoStep = park< 12 >( clarke< 12 >( ia, ib ), sc );
+        double alpha = ia.toDouble(), beta = (ia.toDouble() + 2*ib.toDouble()) / std::sqrt( 3.0 );
+        assert( near( fused.d.toDouble(), alpha*c + beta*s, 0.51, 12 ) && std::abs( fused.d.qValue() - twoStep.d.qValue() ) <= 1 );
+        assert( near( fused.q.toDouble(), beta*c - alpha*s, 0.51, 12 ) && std::abs( fused.q.qValue() - twoStep.q.qValue() ) <= 1 );
+
+        tDq< 12 > vdq;
+        vdq.d = tQ12::create( std::rand() % 3000 - 1500 );
+        vdq.q = tQ12::create( std::rand() % 3000 - 1500 );
+        double vd = vdq.d.toDouble(), vq = vdq.q.toDouble();
+        double valpha = vd*c - vq*s, vbeta = vd*s + vq*c;
+        double va = valpha, vb = -valpha/2 + std::sqrt( 3.0 )/2*vbeta, vc = -valpha/2 - std::sqrt( 3.0 )/2*vbeta;
+        tAbc< 16 > d = inverseParkSvpwm< 16 >( vdq, sc );
+        tAbc< 16 > d2 = svpwm< 16 >( inversePark< 24 >( vdq, sc ) );
+        assert( near( d.a.toDouble(), duty( va, va, vb, vc ), 0.51, 16 ) && std::abs( d.a.qValue() - d2.a.qValue() ) <= 1 );
+        assert( near( d.b.toDouble(), duty( vb, va, vb, vc ), 0.51, 16 ) && std::abs( d.b.qValue() - d2.b.qValue() ) <= 1 );
+        assert( near( d.c.toDouble(), duty( vc, va, vb, vc ), 0.51, 16 ) && std::abs( d.c.qValue() - d2.c.qValue() ) <= 1 );
+    }
+    tSinCos< 30 > sc30 = sincos< 30 >( tQ16( 0 ) );
+    tDq< 12 > dq150 = clarkePark< 12 >( tQ12( 150 ), tQ12( -75 ), sc30 );
+    assert( dq150.d == tQ12( 150 ) && dq150.q == tQ12( 0 ) );
+    tDq< 12 > vdq30 = { tQ12( 0.5 ), tQ12( 0.25 ) };
+    tAbc< 16 > d30 = inverseParkSvpwm< 16 >( vdq30, sincos< 30 >( tQ16( 0.1 ) ) );
+    tAbc< 16 > d30b = svpwm< 16 >( inversePark< 24 >( vdq30, sincos< 30 >( tQ16( 0.1 ) ) ) );
+    assert( std::abs( d30.a.qValue() - d30b.a.qValue() ) <= 1 && std::abs( d30.c.qValue() - d30b.c.qValue() ) <= 1 );
+
+    // zero volts is a 50% duty cycle on every phase, and the duty cycles saturate at 0 and 1
+    tDq< 12 > zero = {};
+    tSinCos< 15 > sc0;
+    sc0.sin = tQ15( 0 );
+    sc0.cos = tQ15( 0.99997 );
+    tAbc< 16 > half = inverseParkSvpwm< 16 >( zero, sc0 );
+    assert( half.a == tQ16( 0.5 ) && half.b == tQ16( 0.5 ) && half.c == tQ16( 0.5 ) );
+    tDq< 12 > big = { tQ12( 2 ), tQ12( 0 ) };
+    tAbc< 16 > limited = inverseParkSvpwm< 16 >( big, sc0 );
+    assert( limited.a == tQ16( 1 ) && limited.b == tQ16( 0 ) && limited.c == tQ16( 0 ) );
+
+    // results that don't fit the data-type saturate
+    tSinCos< 15, short > scs;
+    scs.sin = tShortQ15( 0.70710678 );
+    scs.cos = tShortQ15( 0.70710678 );
+    tDq< 12, short > sat = clarkePark< 12 >( tShortQ12( short( 7 ) ), tShortQ12( short( 7 ) ), scs );
+    assert( sat.d.qValue() == 32767 );
+}
@@ -0,0 +1,54 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/PIController.h"
+#include <cassert>
+#include <cmath>
+
+typedef tFixedPoint< 12 >  tQ12;
+typedef tFixedPoint< 16 >  tQ16;
+
+int main()
+{
+    // within the limits it matches a double implementation to within the output rounding
+    constexpr tQ16 cKp( 0.8 ), cKi( 0.02 );
+    tPIController< 16, 12 > pi( cKp, cKi, -tQ12( 150 ), tQ12( 150 ) );
+    double integ = 0;
+    for (int i = 0; i < 1000; ++i) {
+        tQ12 error = tQ12( std::sin( i * 0.01 ) * 20 );
+        integ += cKi.toDouble() * error.toDouble();
+        double expected = cKp.toDouble() * error.toDouble() + integ;
+        tQ12 out = pi.update( error );
+        assert( std::fabs( out.toDouble() - expected ) <= 0.5 / 4096 + 1e-9 );
+        assert( !pi.saturated() );
+    }
+
+    // tiny ki*e terms aren't lost, a Q12 integrator would round each of these to 0
+    tPIController< 16, 12 > slow( tQ16( 0 ), tQ16::create( 1 ), -tQ12( 10 ), tQ12( 10 ) );
+    for (int i = 0; i < 65536; ++i) slow.update( tQ12( 1 ) );
+    assert( slow.output() == tQ12( 1 ) );
+
+    // the output saturates, and the clamped integrator recovers as soon as the error reverses
+    tPIController< 16, 12 > clamp( tQ16( 1 ), tQ16( 0.5 ), -tQ12( 10 ), tQ12( 10 ) );
+    for (int i = 0; i < 100; ++i) clamp.update( tQ12( 4 ) );
+    assert( clamp.output() == tQ12( 10 ) && clamp.saturated() && clamp.integrator() == tQ12( 10 ) );
+    assert( clamp.update( tQ12( -4 ) ) == tQ12( 4 ) );
+    for (int i = 0; i < 100; ++i) clamp.update( tQ12( -4 ) );
+    assert( clamp.output() == -tQ12( 10 ) && clamp.integrator() == -tQ12( 10 ) );
+
+    // back-calculation settles the integrator where the output is just at the limit
+    tPIController< 16, 12, int, tPIBackCalculation > back( tQ16( 1 ), tQ16( 0.5 ), -tQ12( 10 ), tQ12( 10 ) );
+    for (int i = 0; i < 100; ++i) back.update( tQ12( 4 ) );
+    assert( back.output() == tQ12( 10 ) && back.integrator() == tQ12( 6 ) );
+    assert( back.update( tQ12( -1 ) ) < tQ12( 10 ) );
+    tPIController< 16, 12, int, tPIBackCalculation > noBack( tQ16( 1 ), tQ16( 0.5 ), -tQ12( 10 ), tQ12( 10 ) );
+    noBack.setBackGain( tQ16( 0 ) );
+    for (int i = 0; i < 100; ++i) noBack.update( tQ12( 4 ) );
+    assert( noBack.integrator() == tQ12( 200 ) );
+
+    // bumpless reset and changing the limits and gains
+    clamp.reset( tQ12( 2.5 ) );
+    assert( clamp.output() == tQ12( 2.5 ) && clamp.update( tQ12( 0 ) ) == tQ12( 2.5 ) );
+    clamp.setLimits( tQ12( 0 ), tQ12( 1 ) );
+    assert( clamp.update( tQ12( 0 ) ) == tQ12( 1 ) && clamp.integrator() == tQ12( 1 ) );
+    clamp.setGains( tQ16( 2 ), tQ16( 0 ) );
+    assert( clamp.update( tQ12( -0.25 ) ) == tQ12( 0.5 ) );
+}
@@ -0,0 +1,62 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/PackedFixedPoint.h"
+#include <assert.h>
+#include <string.h>
+#include <type_traits>
+
+typedef tFixedPoint< 15 > tQ15;
+typedef tFixedPoint< 30 > tQ30;
+typedef tFixedPoint< 15, short > tQ15s;
+typedef tPackedFixedPoint< 15 > tPackedQ15;
+
+static_assert( sizeof(tPackedQ15) == 2 && sizeof(tPackedFixedPoint< 7, signed char >) == 1, "packed values take the size of their storage" );
+static_assert( std::is_same< tPackedQ15::tFixed, tQ15 >::value, "a short is computed as an int" );
+static_assert( std::is_same< tPackedFixedPoint< 8, unsigned char >::tValue, unsigned >::value, "an unsigned char is computed as an unsigned" );
+
+int main() {
+    // the products of narrow types are returned in the compute type, so don't overflow
+    tQ15s a( 0.75 ), b( -0.5 );
+    assert(( std::is_same< decltype( a * b ), tFixedPoint< 30, int > >::value ));
+    assert( (a * b) == tQ30( -0.375 ) );
+    assert(( a * tFixedPoint< 14, short >( 1.5 ) == tFixedPoint< 29 >( 1.125 ) ));
+
+    // values are widened when read and narrowed when stored
+    tPackedQ15 history[8];
+    for (int i = 0; i < 8; ++i) history[i] = tQ15( 0.1 * i );
+    assert( history[3] == tQ15( 0.3 ) );
+    tQ15 x = history[7];
+    assert( x == tQ15( 0.7 ) );
+
+    tQ30 p = history[7] * tQ15( 0.9 );
+    assert( p == tQ15( 0.7 ) * tQ15( 0.9 ) && p == tQ15( 0.9 ) * history[7] );
+    history[6] = (history[7] * history[5] + history[1]).roundedTo< 15 >();
+    assert( history[6] == (tQ15( 0.7 ) * tQ15( 0.5 ) + tQ15( 0.1 )).roundedTo< 15 >() );
+    assert( tQ15( 0.2 ) + history[1] == tQ15( 0.2 ) + tQ15( 0.1 ) && history[1] - history[1] == tQ15( 0 ) );
+    assert( history[4] / history[2] == 2 && history[2] < history[3] && history[3] >= tQ15( 0.3 ) );
+
+    history[0] = tQ15( 0.5 );
+    history[0] += history[0];
+    assert( history[0].qValue() == -32768 );
+    history[0] = tQ15( 0.5 );
+    history[0] *= tQ15( 0.5 );
+    history[0] -= tQ15( 0.125 );
+    assert( history[0] == tQ15( 0.125 ) );
+
+    // stores that don't fit wrap, unless saturated
+    history[0] = tQ15( 1.5 );
+    assert( history[0] == tQ15( -0.5 ) );
+    history[0].setSaturated( tQ15( 1.5 ) );
+    assert( history[0].qValue() == 32767 );
+    history[0].setSaturated( -tQ15( 3 ) );
+    assert( history[0].qValue() == -32768 );
+
+    // lower precision values, doubles and raw values
+    tPackedQ15 c( tFixedPoint< 8 >( 0.25 ) ), d( 0.375 );
+    assert( c == tQ15( 0.25 ) && d.qValue() == 12288 && tPackedQ15::create( 12288 ) == d );
+
+    // arrays can be copied as raw data
+    short raw[8];
+    memcpy( raw, history, sizeof(raw) );
+    assert( raw[3] == tQ15( 0.3 ).qValue() );
+    return 0;
+}
@@ -0,0 +1,75 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/RangedFixedPoint.h"
+#include <cassert>
+
+typedef tRangedFixedPointInt< 12, -200, 200 >  tCurrent;     // +/-200A in Q12
+typedef tRangedFixedPointInt< 15, -1, 1 >      tGain;        // +/-1.0 in Q15
+typedef tRangedFixedPointInt< 12, -400, 400 >  tCurrentSum;
+typedef tRangedFixedPointInt< 20, -50, 50 >    tVoltage;
+
+int main()
+{
+    tCurrent a = tCurrent::create( 100 << 12 );
+    tCurrent b = tCurrent::create( -50 * 4096 );
+    tGain    g = tGain::create( 1 << 14 );                        // 0.5
+
+    // ranges propagate through the operators
+    auto sum = a + b;
+    static_assert( decltype( sum )::cMinQ == -400LL * 4096 && decltype( sum )::cMaxQ == 400LL << 12, "sum range" );
+    assert( sum.qValue() == 50 << 12 );
+
+    auto diff = a - b;
+    static_assert( decltype( diff )::cMaxQ == 400LL << 12, "difference range" );
+    assert( diff.qValue() == 150 << 12 );
+
+    tCurrentSum s( sum );                                         // OK - range is contained
+//  tCurrent c( sum );                                            // Error: range is not contained
+
+//  auto p = a * g;                                               // Error: range can exceed the underlying data-type
+    auto p = a.multipliedBy( g );
+    static_assert( decltype( p )::cQBits == 27, "product qbits" );
+    static_assert( std::is_same< decltype( p )::tValue, long long >::value, "product data-type" );
+    auto r = p.roundedTo< 12, int >();
+    static_assert( decltype( r )::cMaxQ == 200LL << 12, "rounded range" );
+    assert( r.qValue() == 50 << 12 );
+
+    // the rounded range follows the rounding policy of the value
+    typedef tRangedFixedPoint< 2, -5, 5 > tQuarters;              // +/-1.25 in Q2
+    auto nearest = tQuarters::create( -5 ).roundedTo< 0, int, tRoundNearest >();
+    static_assert( decltype( nearest )::cMinQ == -1 && decltype( nearest )::cMaxQ == 1, "rounded range" );
+    assert( nearest.qValue() == -1 );
+    for (int q = -5; q <= 5; ++q) {
+        auto rounded = tQuarters::create( q ).roundedTo< 0 >();     // with FIXEDPOINT_ROUNDING
+        assert( rounded.qValue() >= decltype( rounded )::cMinQ && rounded.qValue() <= decltype( rounded )::cMaxQ );
+    }
+    auto down = tQuarters::create( -5 ).roundedTo< 0, int, tRoundTruncate >();
+    static_assert( decltype( down )::cMinQ == -2 && decltype( down )::cMaxQ == 1, "truncated range" );
+    assert( down.qValue() == -2 );
+    auto away = tRangedFixedPoint< 2, -6, 6 >::create( -6 ).roundedTo< 0, int, tRoundHalfAway >();
+    static_assert( decltype( away )::cMinQ == -2 && decltype( away )::cMaxQ == 2, "half-away range" );
+    assert( away.qValue() == -2 );
+    for (int q = -5; q <= 5; ++q) {
+        auto dithered = tQuarters::create( q ).roundedTo< 0, int, tRoundStochastic >();
+        static_assert( decltype( dithered )::cMinQ == -2 && decltype( dithered )::cMaxQ == 2, "stochastic range" );
+        assert( dithered.qValue() >= -2 && dithered.qValue() <= 2 );
+    }
+
+    auto n = -b;
+    assert( n.qValue() == 50 << 12 );
+    auto i = g.increasedBy( a );
+    static_assert( decltype( i )::cQBits == 27, "increasedBy qbits" );
+
+    // run-time clamping for values whose range can't be tracked
+    tCurrent integ = (s + a + a).clampedTo< tCurrent >();         // 50 + 100 + 100 = 250, clamped to 200
+    assert( integ.qValue() == 200 << 12 );
+    assert( integ > a );
+
+    // picking the storage and precision for a range
+    static_assert( tCurrent::cSpareBits == 11, "spare bits" );
+    static_assert( tCurrent::cMaxQBits == 23, "max qbits" );
+    static_assert( std::is_same< tRangedFixedPointAuto< 7, -200, 200 >::tValue, short >::value, "auto storage" );
+    static_assert( std::is_same< tRangedFixedPointAuto< 4, -5, 5 >::tValue, signed char >::value, "auto storage" );
+    (void)tVoltage();
+
+    return 0;
+}
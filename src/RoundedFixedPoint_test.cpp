@@ -0,0 +1,112 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/RoundedFixedPoint.h"
+#include <assert.h>
+#include <math.h>
+
+typedef tFixedPoint< 4 > tQ4;
+typedef tFixedPoint< 8 > tQ8;
+
+/** Reference roundings of 'value' to an integer, for each policy **/
+static double truncated( double value )  { return (value < 0)? ceil( value ) : floor( value ); }
+static double halfUp( double value )     { return floor( value + 0.5 ); }
+static double halfAway( double value )   { return (value < 0)? -floor( -value + 0.5 ) : floor( value + 0.5 ); }
+static double halfEven( double value ) {
+    double f = floor( value );
+    double d = value - f;
+    return (d < 0.5)? f : (d > 0.5)? f + 1 : (fmod( f, 2.0 ) == 0)? f : f + 1;
+}
+
+/** Checks the shifts, divisions and double conversions of 'Rounding' against 'reference'.
+    Shifts by tRoundTruncate go towards -ve infinity rather than 0 **/
+template< typename Rounding > static void check( double (*reference)( double ), double (*shiftReference)( double ) ) {
+    for (int a = -300; a <= 300; ++a) {
+        assert( (tFixedPointCheck_::round< 0, Rounding >( a ) == a) );
+        for (int by = 1; by <= 4; ++by) {
+            int expected = int( shiftReference( a / double( 1 << by ) ) );
+            int rounded = (by == 1)? tFixedPointCheck_::round< 1, Rounding >( a ) : (by == 2)? tFixedPointCheck_::round< 2, Rounding >( a )
+                        : (by == 3)? tFixedPointCheck_::round< 3, Rounding >( a ) : tFixedPointCheck_::round< 4, Rounding >( a );
+            assert( rounded == expected );
+        }
+        assert( (tFixedPointCheck_::round< 4, Rounding >( a * (1ll << 32) ) == a * (1ll << 28)) );
+
+        for (int b = -20; b <= 20; ++b) {
+            if (b != 0) assert( tFixedPointCheck_::divide< Rounding >( a, b ) == int( reference( double( a ) / b ) ) );
+        }
+
+        double x = a / 64.0;
+        assert( (tQ4::rounded< Rounding >( x ).qValue() == int( reference( x * 16 ) )) );
+    }
+    for (unsigned a = 0; a <= 300; ++a) {
+        assert( (tFixedPointCheck_::round< 3, Rounding >( a ) == unsigned( reference( a / 8.0 ) )) );
+        for (unsigned b = 1; b <= 20; ++b) assert( tFixedPointCheck_::divide< Rounding >( a, b ) == unsigned( reference( double( a ) / b ) ) );
+    }
+}
+
+static double floored( double value ) { return floor( value ); }
+
+int main() {
+    check< tRoundTruncate >( truncated, floored );
+    check< tRoundHalfUp >( halfUp, halfUp );
+    check< tRoundHalfEven >( halfEven, halfEven );
+    check< tRoundHalfAway >( halfAway, halfAway );
+
+    // the default is the original behaviour, halves up except for division
+    assert( tFixedPointCheck_::round< 4 >( -8 ) == 0 && tFixedPointCheck_::divide( -5, 2 ) == -3 );
+
+    // rounding to the same qbits leaves the value unchanged
+    assert( tQ8( 1.5 ).roundedTo< 8 >() == tQ8( 1.5 ) );
+    assert( (tQ8( -1.5 ).roundedTo< 8, int, tRoundHalfEven >() == tQ8( -1.5 )) );
+
+    // "roundedTo" takes a policy
+    assert( (tQ8( 2.5 ).roundedTo< 0, int, tRoundHalfEven >().qValue() == 2) );
+    assert( (tQ8( 2.5 ).roundedTo< tFixedPoint< 0 >, tRoundHalfAway >().qValue() == 3) );
+    assert( (tQ8( -2.5 ).roundedTo< tFixedPoint< 0 >, tRoundHalfAway >().qValue() == -3) );
+    assert( (tQ8( -2.5 ).roundedTo< 0 >().qValue() == -2) );
+    assert( (tQ8( 2.75 ).roundedTo< 0, int, tRoundTruncate >().qValue() == 2) );
+
+    // a type with its own policy
+    typedef tRoundedFixedPoint< 4, tRoundTruncate >  tFastQ4;
+    typedef tRoundedFixedPoint< 4, tRoundHalfEven >  tEvenQ4;
+    for (int a = -256; a < 256; ++a) {
+        for (int b = -64; b < 64; ++b) {
+            tFastQ4 f = tFastQ4::create( a );
+            f *= tQ4::create( b );
+            assert( f.qValue() == (a * b) >> 4 );
+
+            tEvenQ4 e = tEvenQ4::create( a );
+            e *= tEvenQ4::create( b );
+            assert( e.qValue() == int( halfEven( a * b / 16.0 ) ) );
+
+            if (b != 0) {
+                tFastQ4 q = tFastQ4::create( a );
+                q /= tQ4::create( b );
+                assert( q.qValue() == (a * 16) / b );
+                assert( tFastQ4::create( a ) / tQ4::create( b ) == a / b );
+                assert( (tEvenQ4::create( a ) / b).qValue() == int( halfEven( double( a ) / b ) ) );
+            }
+        }
+    }
+    tEvenQ4 e( 2.5/16 );
+    assert( e.qValue() == 2 );
+    e = 3.5/16;
+    assert( e.qValue() == 4 );
+    assert( (e * 0.625).qValue() == 2 && (tFastQ4( 1.0 ) * 0.99).qValue() == 15 );
+    assert( (e + tQ4( 1 )).roundedTo< 0 >().qValue() == 1 );
+    tEvenQ4 sum = e + e - tEvenQ4( 1 );
+    assert( (-sum).qValue() == 8 );
+
+    // stochastic rounding averages out to the exact value
+    tRoundStochastic::seed( 12345 );
+    long long total = 0, totalDivided = 0;
+    double totalConverted = 0;
+    for (int i = 0; i < 100000; ++i) {
+        total += tFixedPointCheck_::round< 4, tRoundStochastic >( 5 );
+        totalDivided += tFixedPointCheck_::divide< tRoundStochastic >( -7, 4 );
+        totalConverted += tQ4::rounded< tRoundStochastic >( 0.3/16 ).qValue();
+        assert( (tFixedPointCheck_::round< 4, tRoundStochastic >( 32 ) == 2) );
+    }
+    assert( fabs( total / 100000.0 - 5.0/16 ) < 0.01 );
+    assert( fabs( totalDivided / 100000.0 + 1.75 ) < 0.01 );
+    assert( fabs( totalConverted / 100000.0 - 0.3 ) < 0.01 );
+    return 0;
+}
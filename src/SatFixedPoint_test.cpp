@@ -0,0 +1,106 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/SatFixedPoint.h"
+#include <cassert>
+
+typedef tSatFixedPoint< 8 >          tSatQ8;
+typedef tSatFixedPoint< 16 >         tSatQ16;
+typedef tSatFixedPoint< 12, short >  tSatShortQ12;
+
+typedef tFixedPoint< 8 >   tQ8;
+typedef tFixedPoint< 12 >  tQ12;
+
+int main()
+{
+    const int cMax = std::numeric_limits<int>::max();
+    const int cMin = std::numeric_limits<int>::min();
+
+    tSatQ16 a16( 30000 );
+    tSatQ16 b16( 20000 );
+    tSatQ8  a8( 1.5 );
+    tQ8     b8( 2 );
+    tQ12    c12( 0.25 );
+
+    a16 += b16;                         // 50000 doesn't fit in a Q16 int
+    assert( a16.qValue() == cMax );
+    a16 -= b16;
+    assert( a16.qValue() == cMax - b16.qValue() );
+
+    a16 = -30000;
+    a16 -= b16;
+    assert( a16.qValue() == cMin );
+    a16 = -a16;
+    assert( a16.qValue() == cMax );
+
+    a16 = 300;
+    a16 *= b16;
+    assert( a16.qValue() == cMax );
+    a16 = 300;
+    a16 *= -b16;
+    assert( a16.qValue() == cMin );
+    a16 = 3;
+    a16 *= 4;
+    assert( a16 == 12 );
+    a16 *= 1000000;
+    assert( a16.qValue() == cMax );
+    a16 = 3;
+    a16 *= -10000000000ll;              // doesn't fit in a tValue either
+    assert( a16.qValue() == cMin );
+
+    // multiplying keeps the qbits of the left-hand side and saturates
+    tSatQ16 error( 300 );
+    tSatQ16 gain( 200 );
+    tSatQ16 integ( 0 );
+    integ += error * gain;
+    assert( integ.qValue() == cMax );
+    assert( tSatQ16( 3 ) * tSatQ16( 0.5 ) == tQ8( 1.5 ) );
+    assert( tSatQ16( 3 ) * tSatQ8( -2 ) == -6 );
+    assert( tSatQ16( 3 ) * tSatShortQ12( 0.25 ) == tQ8( 0.75 ) );
+    assert( tSatQ16( 3 ) * c12 == tQ8( 0.75 ) );
+    assert( tSatQ16( 300 ) * -b16 == tSatQ16::create( cMin ) );
+    assert( tSatQ16( 3 ) * 4 == 12 );
+    assert( (tSatQ16( 3 ) * 1000000).qValue() == cMax );
+    assert( (tQ8( 3 ) * tSatQ8( 2 )).roundedTo< tQ8 >() == 6 );   // the tFixedPoint summed-Q product
+
+    a16 = tSatQ16( 30000 ) + b16;
+    assert( a16.qValue() == cMax );
+    a16 = tSatQ16( -30000 ) - b16;
+    assert( a16.qValue() == cMin );
+
+    a8 += b8;
+    assert( a8 == tQ8( 3.5 ) );
+    a8 += c12.roundedTo< tQ8 >();
+    assert( a8 == tQ8( 3.75 ) );
+    a8 -= c12.roundedTo( a8 );
+    assert( a8 == tQ8( 3.5 ) );
+    a8 *= c12;
+    assert( a8 == tQ8( 0.875 ) );
+
+    // narrowing conversions
+    tSatQ16 big( 10.0 );
+    assert( (big.roundedTo< 12, short >().qValue() == std::numeric_limits<short>::max()) );
+    assert( (big.truncatedTo< 12, short >().qValue() == std::numeric_limits<short>::max()) );
+    assert( ((-big).roundedTo< 12, short >().qValue() == std::numeric_limits<short>::min()) );
+    assert( (-big).truncatedTo< tSatShortQ12 >().qValue() == std::numeric_limits<short>::min() );
+    assert( tSatQ16( 1.5 ).roundedTo< tSatShortQ12 >() == tSatShortQ12( 1.5 ) );
+    assert( tSatQ16( 0.5 ).roundedTo< 8 >() == tQ8( 0.5 ) );
+
+    tSatQ16 max16 = tSatQ16::create( cMax );
+    assert( max16.roundedTo< 8 >().qValue() == (cMax >> 8) + 1 );     // rounding up mustn't wrap
+
+    // increasing the precision of a value saturates as well
+    tSatQ16 c16( tFixedPoint< 4 >( 100000 ) );
+    assert( c16.qValue() == cMax );
+    assert( tSatQ16( 1000000, 4 ).qValue() == cMax );
+    assert( tSatQ16( -1000000, 4 ).qValue() == cMin );
+    assert( tSatQ16( -5, 4 ) == tQ8( -0.3125 ) );
+    assert( tSatQ16( 1e6 ).qValue() == cMax );
+    assert( tSatQ16( -1e6 ).qValue() == cMin );
+    assert( tSatQ16( -1.25 ) == tQ8( -1.25 ) );
+
+    // non-saturating operations are inherited
+    tFixedPoint< 32, long long > p32 = tQ8( 2 ).multipliedBy( tSatQ16( 3 ) );
+    assert( p32.roundedTo< tSatQ8 >() == 6 );
+    assert( (tSatQ8( 6 ) / tSatQ8( 2 )) == 3 );
+
+    return 0;
+}
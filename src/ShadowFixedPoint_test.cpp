@@ -0,0 +1,72 @@
+#define FIXEDPOINT_ENABLE_FLOATINGPOINT_SUPPORT
+#include "../include/ShadowFixedPoint.h"
+#include <cassert>
+
+typedef tShadowFixedPoint< 8 >          tQ8;
+typedef tShadowFixedPoint< 12 >         tQ12;
+typedef tShadowFixedPoint< 4 >          tQ4;
+typedef tShadowFixedPoint< 12, short >  tShortQ12;
+
+int main()
+{
+    // exact values have no error
+    tQ12 a( 3 );
+    tQ12 b = tQ12::create( 2048 );
+    assert( a.reference() == 3.0 && b.reference() == 0.5 );
+    a += b;
+    assert( a == tQ12( 3.5 ) && a.maxAbsError() == 0 );
+
+    // constructing from a double records the representation error
+    tQ8 c( 0.1 );
+    assert( c.qValue() == 26 );
+    assert( std::fabs( c.maxAbsError() - (26/256.0 - 0.1) ) < 1e-12 );
+    assert( std::fabs( c.maxRelError() - (26/256.0 - 0.1)/0.1 ) < 1e-9 );
+
+    // the fixed-point results are exactly those of tFixedPoint
+    tFixedPoint< 12 > fa( 3.5 ), fb( 0.3 );
+    tQ12 sb( 0.3 );
+    tQ12 p = a;
+    p *= sb;
+    tFixedPoint< 12 > fp( fa );
+    fp *= fb;
+    assert( p.qValue() == fp.qValue() );
+    assert( std::fabs( p.reference() - 3.5*0.3 ) < 1e-12 );
+    assert( p.maxAbsError() > 0 && p.maxAbsError() < 2.0/4096 );       // includes the error in sb
+
+    // reducing precision loses accuracy, which the reference shows
+    tQ4 r = p.roundedTo< 4 >();
+    assert( r.qValue() == fp.roundedTo< 4 >().qValue() );
+    assert( std::fabs( r.error() - std::fabs( r.toDouble() - 3.5*0.3 ) ) < 1e-12 );
+    tQ4 t = p.truncatedTo< tQ4 >();
+    assert( t.error() >= r.error() );
+
+    // assignment keeps the variable's own largest error
+    tQ8 v( 1 );
+    v = c;
+    v = tQ8( 2 );
+    assert( v.error() == 0 && v.maxAbsError() == c.maxAbsError() );
+    v.resetErrors();
+    assert( v.maxAbsError() == 0 );
+
+    // overflow shows up as a large error
+    tShortQ12 s( short( 6 ) );
+    s += tShortQ12( short( 4 ) );
+    assert( s.reference() == 10.0 && s.maxAbsError() == 16.0 );
+    s.resetErrors( true );
+    assert( s.maxAbsError() == 0 && s.reference() == s.toDouble() );
+
+    // mixed precision operations
+    auto m = tQ8( 1.5 ) * tQ12( 0.25 );
+    assert( m.cQBits == 20 && m == (tShadowFixedPoint< 20 >( 0.375 )) );
+    auto w = tQ12( 100 ).multipliedBy( tQ12( 100 ) );
+    assert( w.toDouble() == 10000.0 && w.maxAbsError() == 0 );
+    auto q = tQ12( 3 ) / tQ4( 2 );
+    assert( q.cQBits == 8 && q.reference() == 1.5 );
+    assert( (tQ12( 6 ) * 2 == tQ12( 12 )) && (3 * tQ12( 2 ) == tQ12( 6 )) );
+    assert( tQ12( 7 ) / tQ12( 2 ) == 4 );
+    tQ12 d( 1 );
+    d /= tQ12( 3 );
+    assert( d.maxAbsError() > 0 && d.maxAbsError() <= 0.5/4096 );
+
+    return 0;
+}